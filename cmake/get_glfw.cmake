@@ -2,5 +2,5 @@ if( TARGET glfw )
     return()
 endif()
 
-find_package( glfw3 3.3 REQUIRED )
+find_package( glfw3 3.4 REQUIRED )
 target_compile_definitions( glfw INTERFACE -DGLFW_INCLUDE_NONE )
@@ -10,3 +10,12 @@ layout(std140, binding=1) uniform Camera {
 
 
 float InvFarPlane = 1.0 / camera.farPlane;
+
+// the world is rendered into the lower left viewport.xy pixels of render targets with a size of viewport.zw
+vec2 RenderScale = camera.viewport.xy / camera.viewport.zw;
+
+// samples a render target of the world at a screen space position
+vec4 sample_render_target(in sampler2D tex, in vec2 uv)
+{
+    return texture(tex, uv * RenderScale);
+}
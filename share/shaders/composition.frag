@@ -28,11 +28,11 @@ void main()
     #endif
 
     vec2 uv = fpi.texCoord;
-    float pDepth = -texture(u_portalPosition, uv).x;
-    float geomDepth = -texture(u_geometryPosition, uv).z;
-    vec3 dUvSpecular = texture(u_portalPerturb, uv).xyz;
+    float pDepth = -sample_render_target(u_portalPosition, uv).x;
+    float geomDepth = -sample_render_target(u_geometryPosition, uv).z;
+    vec3 dUvSpecular = sample_render_target(u_portalPerturb, uv).xyz;
     vec2 pUv = uv + dUvSpecular.xy;
-    float pUvD = -texture(u_geometryPosition, pUv).z;
+    float pUvD = -sample_render_target(u_geometryPosition, pUv).z;
     float whiteness = 0;
     float shadeDepth = geomDepth;
     if (min(geomDepth, pUvD) > pDepth)
@@ -50,7 +50,7 @@ void main()
     }
 
         #ifndef DOF
-    finalColor *= texture(u_texture, uv).rgb * texel_shade(shadeDepth);
+    finalColor *= sample_render_target(u_texture, uv).rgb * texel_shade(shadeDepth);
     #else
     finalColor *= do_dof(uv);
     #endif
@@ -68,4 +68,8 @@ void main()
     finalColor = mix(finalColor, shade_texel(WaterColor*0.5, shadeDepth), d*d);
 
     out_color = vec4(finalColor, 1.0);
+
+    // the geometry depth at the output resolution, for the particles drawn on top
+    vec4 clipPos = camera.projection * vec4(0, 0, -geomDepth, 1);
+    gl_FragDepth = clipPos.z / clipPos.w * 0.5 + 0.5;
 }
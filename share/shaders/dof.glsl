@@ -8,15 +8,15 @@ float dof_focal_depth = 1536.0 * InvFarPlane;
 float dof_start = 128.0 * InvFarPlane;
 float dof_dist = 20*1024.0 * InvFarPlane;
 // autofocus
-float dof_focal_depth = -texture(u_geometryPosition, vec2(0.5)).z * InvFarPlane;
+float dof_focal_depth = -sample_render_target(u_geometryPosition, vec2(0.5)).z * InvFarPlane;
 #endif
 const float DofBlurRange = 3;
 
-vec2 dof_texel = 1.0 / vec2(textureSize(u_texture, 0));
+vec2 dof_texel = 1.0 / camera.viewport.xy;
 
 vec3 do_dof(in vec2 uv)
 {
-    float depth = -texture(u_geometryPosition, uv).z * InvFarPlane;
+    float depth = -sample_render_target(u_geometryPosition, uv).z * InvFarPlane;
     float blur_amount = clamp((abs(depth-dof_focal_depth) - dof_start) / dof_dist, -DofBlurRange, DofBlurRange);
 
     const float NAmount = 0.001;//dither amount
@@ -26,7 +26,7 @@ vec3 do_dof(in vec2 uv)
     const float BokehBias = 0.5;//bokeh edge bias
     vec2 blur_radius = dof_texel * blur_amount + noise;
 
-    vec3 col = shaded_texel(u_texture, uv, -texture(u_geometryPosition, uv).z);
+    vec3 col = shade_texel(sample_render_target(u_texture, uv).rgb, -sample_render_target(u_geometryPosition, uv).z);
     float weight_sum = 1.0;
 
     const int Rings = 3;
@@ -43,7 +43,8 @@ vec3 do_dof(in vec2 uv)
             vec2 dxy = vec2(cos(angle), sin(angle)) * float(i);
             float weight = mix(1.0, bokehFactor, BokehBias);
             vec2 sampleUv = dxy*blur_radius + uv;
-            col = shaded_texel(u_texture, sampleUv, -texture(u_geometryPosition, sampleUv).z) * weight + col;
+            vec3 sampleColor = sample_render_target(u_texture, sampleUv).rgb;
+            col = shade_texel(sampleColor, -sample_render_target(u_geometryPosition, sampleUv).z) * weight + col;
             weight_sum += weight;
             angle += angleDelta;
         }
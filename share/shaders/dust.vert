@@ -1,8 +1,13 @@
-#include "vtx_input.glsl"
 #include "transform_interface.glsl"
 #include "time_uniform.glsl"
 #include "noise.glsl"
 
+// the particles are the jittered points of a regular grid, generated from gl_VertexID
+layout(location=1) uniform vec3 u_dustOrigin;
+layout(location=2) uniform vec3 u_dustCells;
+layout(location=3) uniform float u_dustResolution;
+layout(location=4) uniform uint u_dustSeed;
+
 out DustVSInterface {
     float alpha;
     float size;
@@ -11,10 +16,35 @@ out DustVSInterface {
 const float MaxLifetime = 8;
 const float MaxDistance = 256;
 
+// https://nullprogram.com/blog/2018/07/31/
+uint hash(in uint x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// uniformly distributed in [-0.5, 0.5)
+float next_jitter(inout uint state)
+{
+    state = hash(state);
+    return float(state >> 8) / float(1u << 24) - 0.5;
+}
+
 void main()
 {
-    vec3 n = snoise3(a_position.xyz);
-    vec3 n2 = snoise3(a_position.zxy);
+    uint id = uint(gl_VertexID);
+    uvec3 cells = uvec3(u_dustCells);
+    uvec3 cell = uvec3(id % cells.x, (id / cells.x) % cells.y, id / (cells.x * cells.y));
+    uint state = hash(id ^ hash(u_dustSeed));
+    vec3 jitter = vec3(next_jitter(state), next_jitter(state), next_jitter(state));
+    vec3 position = u_dustOrigin + (vec3(cell) + jitter) * u_dustResolution;
+
+    vec3 n = snoise3(position);
+    vec3 n2 = snoise3(position.zxy);
 
     float randS = pow(0.5, 0.5 * n.y + 1) * pow(0.5, 1 - (0.5 * n.y + 1));
     vs.size = 0.5 + randS*4;
@@ -23,12 +53,12 @@ void main()
 
     float t = mod(TimeSeconds, particleMaxLifetime);
     float t0 = TimeSeconds - t;
-    vec3 pnoise = snoise3(a_position.xyz + vec3(t0*3, t0*2, t0));
-    vec3 normal = snoise3(a_position.zyx + pnoise);
-    float distance = snoise3(a_position.zyx - pnoise).x * MaxDistance;
+    vec3 pnoise = snoise3(position + vec3(t0*3, t0*2, t0));
+    vec3 normal = snoise3(position.zyx + pnoise);
+    float distance = snoise3(position.zyx - pnoise).x * MaxDistance;
 
     float lifetime = t / particleMaxLifetime;
     vs.alpha = clamp(min(lifetime, 1.0-lifetime) * 3.0, 0.0, 1.0) * 0.3;
-    vec3 pos = a_position + normal * distance * (t+pnoise.y) / particleMaxLifetime;
+    vec3 pos = position + normal * distance * (t+pnoise.y) / particleMaxLifetime;
     gl_Position = modelTransform.m * vec4(pos, 1);
 }
@@ -0,0 +1,209 @@
+// Chain of screen space effects, fused into a single pass. Every enabled FX_* stage is a function of the texture
+// coordinate that samples the previous stage through FX_PREV instead of reading an intermediate framebuffer; the
+// stages are applied in the order they appear in this file. FX_FXAA needs the raw input texture, so it must be the
+// first stage of a pass.
+
+#include "flat_pipeline_interface.glsl"
+#include "fx_input.glsl"
+#include "camera_interface.glsl"
+#include "time_uniform.glsl"
+#include "noise.glsl"
+
+vec2 inputSize = textureSize(u_input, 0);
+#include "util.glsl"
+#include "fxaa.glsl"
+
+vec3 fx_input(in vec2 uv)
+{
+    return texture(u_input, uv).rgb;
+}
+#define FX_PREV fx_input
+
+#ifdef FX_HBAO
+layout(bindless_sampler) uniform sampler2D u_ao;
+
+vec3 fx_hbao(in vec2 uv)
+{
+    return sample_render_target(u_ao, uv).r * FX_PREV(uv);
+}
+#undef FX_PREV
+#define FX_PREV fx_hbao
+#endif
+
+#ifdef FX_UNDERWATER_MOVEMENT
+const float Frq1 = 12.6;
+const float TimeMult1 = 0.002;
+const float Amplitude1 = 0.001;
+
+const float Frq2 = 19.7;
+const float TimeMult2 = 0.001;
+const float Amplitude2 = 0.0055;
+
+void do_water_distortion_frq(inout vec2 uv, in float timeMult, in float scale, in float amplitude)
+{
+    vec2 phase = uv * scale + vec2(u_time * timeMult);
+
+    uv += vec2(sin(phase.x), sin(phase.y)) * amplitude;
+}
+
+void do_water_distortion(inout vec2 uv)
+{
+    do_water_distortion_frq(uv, TimeMult1, Frq1, Amplitude1);
+    do_water_distortion_frq(uv, TimeMult2, Frq2, Amplitude2);
+}
+
+vec3 fx_underwater_movement(in vec2 uv)
+{
+    if (u_inWater != 0) {
+        // scale a bit to avoid edge clamping when underwater
+        uv = (uv - vec2(0.5)) * 0.9 + vec2(0.5);
+        do_water_distortion(uv);
+    }
+
+    return FX_PREV(uv);
+}
+#undef FX_PREV
+#define FX_PREV fx_underwater_movement
+#endif
+
+#ifdef FX_REFLECTIVE
+layout(bindless_sampler) uniform sampler2D u_normal;
+layout(bindless_sampler) uniform sampler2D u_reflective;
+
+vec3 fx_reflective(in vec2 uv)
+{
+    vec4 reflective = sample_render_target(u_reflective, uv).rgba;
+    vec3 base = FX_PREV(uv);
+    if (reflective.a <= 0) {
+        return base;
+    }
+
+    vec2 normal = sample_render_target(u_normal, uv).xy;
+    vec3 reflected = FX_PREV(normal*0.5 + vec2(0.5)) * reflective.rgb;
+    return mix(base, reflected, reflective.a);
+}
+#undef FX_PREV
+#define FX_PREV fx_reflective
+#endif
+
+#ifdef FX_FXAA
+vec3 fx_fxaa(in vec2 uv)
+{
+    return fxaa(u_input, uv, 0.75, 0.166, 0.0833);
+}
+#undef FX_PREV
+#define FX_PREV fx_fxaa
+#endif
+
+#ifdef FX_LENS_DISTORTION
+float distortionPower = u_inWater != 0.0 ? -2.0 : -1.0;
+float absDistortionPower = abs(distortionPower);
+
+vec2 fisheye(in vec2 polar, in float stationary_radius)
+{
+    return normalize(polar) * tan(length(polar) * absDistortionPower) * stationary_radius / tan(stationary_radius * absDistortionPower);
+}
+
+// same as fisheye, except that atan is used instead of tan
+vec2 anti_fisheye(in vec2 polar, in float stationary_radius)
+{
+    return normalize(polar) * atan(length(polar) * absDistortionPower) * stationary_radius / atan(stationary_radius * absDistortionPower);
+}
+
+vec2 do_lens_distortion(in vec2 uv)
+{
+    float stationary_radius = max(0.5, 0.5 / camera.aspectRatio);
+
+    if (distortionPower > 0.0) {
+        return vec2(0.5, 0.5) + fisheye(uv - vec2(0.5, 0.5), stationary_radius);
+    }
+    else if (distortionPower < 0.0) {
+        return vec2(0.5, 0.5) + anti_fisheye(uv - vec2(0.5, 0.5), stationary_radius);
+    }
+    else {
+        return uv;
+    }
+}
+
+vec3 fx_lens_distortion(in vec2 uv)
+{
+    return FX_PREV(do_lens_distortion(uv));
+}
+#undef FX_PREV
+#define FX_PREV fx_lens_distortion
+#endif
+
+#ifdef FX_VELVIA
+vec3 fx_velvia(in vec2 uv)
+{
+    const float VelviaAmount = 0.03;
+    const vec2 VelviaFac = vec2(2*VelviaAmount + 1.0, -VelviaAmount);
+    vec3 texel = FX_PREV(uv);
+    vec3 velviaColor = vec3(dot(texel, VelviaFac.xyy), dot(texel, VelviaFac.yxy), dot(texel, VelviaFac.yyx));
+    return vec3(1.0) - clamp((-velviaColor*1.01 + vec3(1.0))*1.01, vec3(0.0), vec3(1.0));
+}
+#undef FX_PREV
+#define FX_PREV fx_velvia
+#endif
+
+#ifdef FX_DEATH
+layout(location=1) uniform float u_strength;
+
+vec3 fx_death(in vec2 uv)
+{
+    vec3 col = FX_PREV(uv);
+    if (u_strength <= 0) {
+        return col;
+    }
+
+    float lum = luminance(col);
+
+    float vig = uv.x * uv.y * (1.0-uv.x) * (1.0-uv.y);
+    lum *= sqrt(vig*2);
+
+    vec3 monochrome = vec3(lum, lum, lum);
+
+    return mix(col, monochrome, clamp(u_strength, 0, 1));
+}
+#undef FX_PREV
+#define FX_PREV fx_death
+#endif
+
+#ifdef FX_FILM_GRAIN
+vec3 fx_film_grain(in vec2 uv)
+{
+    float grain = noise(uv * TimeSeconds)*0.5 + 1.0;
+    return FX_PREV(uv) * grain;
+}
+#undef FX_PREV
+#define FX_PREV fx_film_grain
+#endif
+
+#ifdef FX_CRT
+vec3 fx_crt(in vec2 uv)
+{
+    const float NoiseIntensity = 0.01;
+
+    vec3 col;
+    col.r = FX_PREV(vec2(uv.x+0.001, uv.y+0.001)).r;
+    col.g = FX_PREV(vec2(uv.x+0.000, uv.y-0.002)).g;
+    col.b = FX_PREV(vec2(uv.x-0.002, uv.y+0.000)).b;
+
+    float vig = 16.0 * uv.x * uv.y * (1.0-uv.x) * (1.0-uv.y);
+    col *= vec3(pow(vig, 0.3));
+    col *= vec3(0.95, 1.05, 0.95)*1.5;
+    col *= 1.0 - 0.65 * vec3(clamp((mod(uv.x * inputSize.x, 2.0)-1.0)*2.0, 0.0, 1.0));
+
+    float noiseTime = TimeSeconds * 0.5;
+    float noiseValue = texture(u_noise, vec2(1, 2*cos(noiseTime)) * noiseTime * 8.0 + uv * 2.0).x;
+
+    return col +  noiseValue*noiseValue * NoiseIntensity;
+}
+#undef FX_PREV
+#define FX_PREV fx_crt
+#endif
+
+void main()
+{
+    out_color = FX_PREV(fpi.texCoord);
+}
@@ -1,5 +1,8 @@
 #include "vtx_input.glsl"
+#include "tile_table.glsl"
+#include "room_vertex.glsl"
 #include "transform_interface.glsl"
+#include "multi_draw.glsl"
 #include "geometry_pipeline_interface.glsl"
 #include "camera_interface.glsl"
 
@@ -9,6 +12,8 @@ void main()
 {
     #ifdef SKELETAL
     mat4 mm = modelTransform.m * boneTransform.m[int(a_boneIndex)];
+    #elif defined(INSTANCED)
+    mat4 mm = modelTransform.m * instanceData.instances[INSTANCE_INDEX].m;
     #else
     mat4 mm = modelTransform.m;
     #endif
@@ -27,8 +32,10 @@ void main()
     gpi.vertexPos = mvPos.xyz;
     gpi.vertexPosWorld = vec3(mm * vec4(a_position, 1.0));
     gl_Position = camera.projection * mvPos;
-    gpi.texCoord = a_texCoord;
-    gpi.color = gpi.texCoord.z >= 0 ? a_color : toLinear(a_color);
+    applyDrawScissor(gl_Position);
+    gpi.texCoord = getTexCoord();
+    vec4 color = getVertexColor();
+    gpi.color = gpi.texCoord.z >= 0 ? color : toLinear(color);
 
     gpi.vertexNormalWorld = normalize(mat3(mm) * a_normal);
     gpi.hbaoNormal = normalize(mat3(mv) * a_normal);
@@ -37,6 +44,8 @@ void main()
     {
         #ifdef SKELETAL
         mat4 lmvp = csm.lightMVP[i] * boneTransform.m[int(a_boneIndex)];
+        #elif defined(INSTANCED)
+        mat4 lmvp = csm.lightMVP[i] * instanceData.instances[INSTANCE_INDEX].m;
         #else
         mat4 lmvp = csm.lightMVP[i];
         #endif
@@ -45,24 +54,29 @@ void main()
     }
 
     {
-        gpi.isQuad = a_isQuad;
+        vec3 quadVerts[4];
+        gpi.isQuad = getQuadVerts(quadVerts);
 
         mat4 mvp = camera.projection * mv;
 
-        vec4 tmp = mvp * vec4(a_quadVert1, 1);
-        gpi.quadVerts[0] = vec3(tmp.xy / tmp.w, tmp.w);
-        tmp = mvp * vec4(a_quadVert2, 1);
-        gpi.quadVerts[1] = vec3(tmp.xy / tmp.w, tmp.w);
-        tmp = mvp * vec4(a_quadVert3, 1);
-        gpi.quadVerts[2] = vec3(tmp.xy / tmp.w, tmp.w);
-        tmp = mvp * vec4(a_quadVert4, 1);
-        gpi.quadVerts[3] = vec3(tmp.xy / tmp.w, tmp.w);
+        for (int i=0; i<4; ++i)
+        {
+            vec4 tmp = mvp * vec4(quadVerts[i], 1);
+            gpi.quadVerts[i] = vec3(tmp.xy / tmp.w, tmp.w);
+        }
 
-        gpi.quadUvs[0] = a_quadUv12.xy;
-        gpi.quadUvs[1] = a_quadUv12.zw;
-        gpi.quadUvs[2] = a_quadUv34.xy;
-        gpi.quadUvs[3] = a_quadUv34.zw;
+        vec4 quadUv12;
+        vec4 quadUv34;
+        getQuadUvs(quadUv12, quadUv34);
+        gpi.quadUvs[0] = quadUv12.xy;
+        gpi.quadUvs[1] = quadUv12.zw;
+        gpi.quadUvs[2] = quadUv34.xy;
+        gpi.quadUvs[3] = quadUv34.zw;
     }
 
-    gpi.reflective = a_reflective;
+    gpi.reflective = getVertexReflective();
+
+    #ifdef INSTANCED
+    gpi.lightAmbient = instanceData.instances[INSTANCE_INDEX].lightAmbient;
+    #endif
 }
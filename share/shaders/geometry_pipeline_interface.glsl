@@ -14,4 +14,8 @@ IN_OUT GeometryPipelineInterface {
     flat vec2 quadUvs[4];
 
     vec4 reflective;
+
+    #ifdef INSTANCED
+    flat float lightAmbient;
+    #endif
 } gpi;
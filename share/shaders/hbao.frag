@@ -23,14 +23,14 @@ void main()
     const float DirRotation = 2*PI/Dirs;
     const int Steps = 8;
 
-    vec3 fragPos = texture(u_position, fpi.texCoord).xyz;
+    vec3 fragPos = sample_render_target(u_position, fpi.texCoord).xyz;
     float stepSize = Radius / (fragPos.z*0.0001) / float(Steps+1);
     float stepSizes[Dirs];
     for (int i = 0; i < Dirs; ++i) {
         stepSizes[i] = stepSize * snoise(fpi.texCoord + vec2(i, 0)) + stepSize;
     }
 
-    vec3 normal = texture(u_normals, fpi.texCoord).xyz;
+    vec3 normal = sample_render_target(u_normals, fpi.texCoord).xyz;
     vec3 baseTangent;
     if (abs(normal.z) > 1e-4 || abs(normal.x) > 1e-4) {
         baseTangent = angleAxis(normalize(vec3(normal.z, 0, -normal.x)), normal, snoise(fpi.texCoord));
@@ -53,7 +53,7 @@ void main()
         {
             d += tangent;
             vec4 offset = camera.projection * vec4(d, 1.0);
-            vec3 k = texture(u_position, (offset.xy / offset.w) * vec2(0.5) + vec2(0.5)).xyz;
+            vec3 k = sample_render_target(u_position, (offset.xy / offset.w) * vec2(0.5) + vec2(0.5)).xyz;
             vec3 vk = k - fragPos;
             float lvk = 1.0 / length(vk);
             float w = min(Radius * lvk, 1);
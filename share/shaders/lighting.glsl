@@ -1,8 +1,14 @@
+#include "camera_interface.glsl"
 #include "csm_interface.glsl"
 #include "geometry_pipeline_interface.glsl"
 
 layout(bindless_sampler) uniform sampler2D u_csmVsm[CSMSplits];
+#ifdef INSTANCED
+#define LIGHT_AMBIENT gpi.lightAmbient
+#else
 layout(location=10) uniform float u_lightAmbient;
+#define LIGHT_AMBIENT u_lightAmbient
+#endif
 
 struct Light {
     vec4 position;
@@ -15,6 +21,19 @@ layout(std430, binding=3) readonly restrict buffer b_lights {
     Light lights[];
 };
 
+// must match engine::LightGrid
+#define LIGHT_GRID_TILES_X 16
+#define LIGHT_GRID_TILES_Y 9
+#define LIGHT_GRID_SLICES 24
+
+// if enabled, each cluster of the view frustum holds a range of lightIndices, pointing into lights
+layout(std430, binding=7) readonly restrict buffer b_lightGrid {
+    uint lightGridEnabled;
+    uint _lightGridPad;
+    uvec2 lightClusters[LIGHT_GRID_TILES_X * LIGHT_GRID_TILES_Y * LIGHT_GRID_SLICES];
+    uint lightIndices[];
+};
+
 const float CSMShadow = 0.2;
 float lightNormDot = dot(normalize(gpi.vertexNormalWorld), normalize(csm.lightDir));
 
@@ -77,26 +96,52 @@ float shadow_map_multiplier()
     return 1.0;
 }
 
+vec3 calc_light(in Light light)
+{
+    vec3 d = gpi.vertexPosWorld - light.position.xyz;
+    float ld = length(d);
+    float r = ld / light.fadeDistance;
+    float intensity = 1.0 / (r*r + 1.0);
+    vec3 color = vec3(light.brightness);
+    #if SPRITEMODE == 0
+    return intensity * clamp(-dot(d/ld, gpi.vertexNormalWorld), 0, 1) * color;
+    #else
+    return intensity * color;
+    #endif
+}
+
+uvec2 get_light_cluster()
+{
+    const vec2 tiles = vec2(LIGHT_GRID_TILES_X, LIGHT_GRID_TILES_Y);
+    uvec2 tile = uvec2(clamp(gl_FragCoord.xy / camera.viewport.xy * tiles, vec2(0), tiles - vec2(1)));
+    float depth = max(-gpi.vertexPos.z, camera.nearPlane);
+    float slice = log(depth / camera.nearPlane) / log(camera.farPlane / camera.nearPlane) * LIGHT_GRID_SLICES;
+    uint z = uint(clamp(slice, 0, LIGHT_GRID_SLICES - 1));
+    return lightClusters[(z * LIGHT_GRID_TILES_Y + tile.y) * LIGHT_GRID_TILES_X + tile.x];
+}
+
 vec3 calc_positional_lighting()
 {
     if (lights.length() <= 0 || gpi.vertexNormalWorld == vec3(0))
     {
-        return vec3(u_lightAmbient);
+        return vec3(LIGHT_AMBIENT);
     }
 
-    vec3 sum = vec3(u_lightAmbient);
-    for (int i=0; i<lights.length(); ++i)
+    vec3 sum = vec3(LIGHT_AMBIENT);
+    if (lightGridEnabled != 0)
     {
-        vec3 d = gpi.vertexPosWorld - lights[i].position.xyz;
-        float ld = length(d);
-        float r = ld / lights[i].fadeDistance;
-        float intensity = 1.0 / (r*r + 1.0);
-        vec3 color = vec3(lights[i].brightness);
-        #if SPRITEMODE == 0
-        sum += intensity * clamp(-dot(d/ld, gpi.vertexNormalWorld), 0, 1) * color;
-        #else
-        sum += intensity * color;
-        #endif
+        uvec2 cluster = get_light_cluster();
+        for (uint i=cluster.x; i<cluster.x + cluster.y; ++i)
+        {
+            sum += calc_light(lights[lightIndices[i]]);
+        }
+    }
+    else
+    {
+        for (int i=0; i<lights.length(); ++i)
+        {
+            sum += calc_light(lights[i]);
+        }
     }
 
     return sum;
@@ -0,0 +1,27 @@
+// multi-draw batches pass the draw index through a per-instance attribute (the draw's base instance), as
+// gl_DrawID is not available in core 4.5; each draw is clipped against its own portal scissor region
+#ifdef MULTI_DRAW
+#define INSTANCE_INDEX int(a_drawIndex)
+
+// min.xy, max.xy in NDC
+layout(std430, binding=6) readonly restrict buffer b_drawScissors {
+    vec4 drawScissors[];
+};
+
+out float gl_ClipDistance[4];
+
+void applyDrawScissor(in vec4 clipPos)
+{
+    vec4 scissor = drawScissors[INSTANCE_INDEX];
+    gl_ClipDistance[0] = clipPos.x - scissor.x * clipPos.w;
+    gl_ClipDistance[1] = clipPos.y - scissor.y * clipPos.w;
+    gl_ClipDistance[2] = scissor.z * clipPos.w - clipPos.x;
+    gl_ClipDistance[3] = scissor.w * clipPos.w - clipPos.y;
+}
+#else
+#define INSTANCE_INDEX gl_InstanceID
+
+void applyDrawScissor(in vec4 clipPos)
+{
+}
+#endif
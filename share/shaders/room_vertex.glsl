@@ -0,0 +1,44 @@
+// packed room vertices reference the tile table (a_tile.x > 0) and store their colours scaled by 1/RoomColorScale;
+// distorted quads are referenced by a_tile.z (quad index plus one)
+const float RoomColorScale = 2.0;
+
+struct RoomQuad {
+    vec4 vertices[4];
+};
+
+layout(std430, binding=5) readonly restrict buffer b_roomQuads {
+    RoomQuad roomQuads[];
+};
+
+bool isRoomVertex()
+{
+    return a_tile.x > 0;
+}
+
+vec4 getVertexColor()
+{
+    return isRoomVertex() ? a_color * RoomColorScale : a_color;
+}
+
+vec4 getVertexReflective()
+{
+    return isRoomVertex() ? vec4(0) : a_reflective;
+}
+
+float getQuadVerts(out vec3 quadVerts[4])
+{
+    if (a_tile.z > 0) {
+        RoomQuad quad = roomQuads[int(a_tile.z) - 1];
+        for (int i=0; i<4; ++i)
+        {
+            quadVerts[i] = quad.vertices[i].xyz;
+        }
+        return 1;
+    }
+
+    quadVerts[0] = a_quadVert1;
+    quadVerts[1] = a_quadVert2;
+    quadVerts[2] = a_quadVert3;
+    quadVerts[3] = a_quadVert4;
+    return a_isQuad;
+}
@@ -0,0 +1,43 @@
+struct Tile {
+    vec4 uv12;
+    vec4 uv34;
+    int textureIndex;
+    int _pad[3];
+};
+
+layout(std430, binding=4) readonly restrict buffer b_tiles {
+    Tile tiles[];
+};
+
+// a_tile.x is the tile id plus one, a_tile.y the quad corner; vertices without a tile (a_tile.x == 0) provide their
+// texture coordinates directly
+bool hasTile()
+{
+    return a_tile.x > 0;
+}
+
+vec3 getTileTexCoord()
+{
+    Tile tile = tiles[int(a_tile.x) - 1];
+    int corner = int(a_tile.y);
+    vec4 uvs = corner < 2 ? tile.uv12 : tile.uv34;
+    return vec3(corner % 2 == 0 ? uvs.xy : uvs.zw, tile.textureIndex);
+}
+
+vec3 getTexCoord()
+{
+    return hasTile() ? getTileTexCoord() : a_texCoord;
+}
+
+void getQuadUvs(out vec4 quadUv12, out vec4 quadUv34)
+{
+    if (hasTile()) {
+        Tile tile = tiles[int(a_tile.x) - 1];
+        quadUv12 = tile.uv12;
+        quadUv34 = tile.uv34;
+    }
+    else {
+        quadUv12 = a_quadUv12;
+        quadUv34 = a_quadUv34;
+    }
+}
@@ -7,3 +7,15 @@ layout(std140) readonly restrict buffer BoneTransform {
     mat4 m[];
 } boneTransform;
 #endif
+
+#ifdef INSTANCED
+struct Instance {
+    mat4 m;
+    float lightAmbient;
+    float _pad[3];
+};
+
+layout(std430) readonly restrict buffer InstanceData {
+    Instance instances[];
+} instanceData;
+#endif
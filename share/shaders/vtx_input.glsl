@@ -23,3 +23,9 @@ layout(location=15) in vec4 a_colorBottomRight;
 
 // warning: re-uses location
 layout(location=12) in vec4 a_reflective;
+
+// warning: re-uses location
+layout(location=13) in vec4 a_tile;
+
+// warning: re-uses location
+layout(location=14) in float a_drawIndex;
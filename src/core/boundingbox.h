@@ -3,6 +3,10 @@
 #include "interval.h"
 #include "vec.h"
 
+#include <glm/common.hpp>
+#include <glm/vec3.hpp>
+#include <tuple>
+
 namespace core
 {
 struct BoundingBox
@@ -55,5 +59,13 @@ struct BoundingBox
   {
     return x.intersectsExclusive(b.x) && y.intersectsExclusive(b.y) && z.intersectsExclusive(b.z);
   }
+
+  //! Returns the minimum and maximum corners in render system coordinates.
+  [[nodiscard]] std::tuple<glm::vec3, glm::vec3> toRenderSystem() const noexcept
+  {
+    const auto a = TRVec{x.min, y.min, z.min}.toRenderSystem();
+    const auto b = TRVec{x.max, y.max, z.max}.toRenderSystem();
+    return {glm::min(a, b), glm::max(a, b)};
+  }
 };
 } // namespace core
@@ -13,7 +13,9 @@
 #include <boost/log/utility/setup/common_attributes.hpp>
 #include <boost/log/utility/setup/console.hpp>
 #include <boost/log/utility/setup/file.hpp>
+#include <cctype>
 #include <csignal>
+#include <cstddef>
 #include <cstdlib>
 #include <exception>
 #include <filesystem>
@@ -23,6 +25,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace
@@ -67,6 +70,40 @@ int main(int argc, char** argv)
 #endif
   std::string localeOverride;
   std::string gameflowId;
+  // --headless renders without a visible window, e.g. for automated benchmarks; as the launcher can't be shown then,
+  // the gameflow must be passed with --gameflow
+  bool headless = false;
+  // --benchmark-flythrough [frames] renders the given number of frames of each level in the level sequence as fast as
+  // possible, writes the timings to the benchmarks directory, and exits
+  std::optional<size_t> benchmarkFrames;
+  for(int i = 1; i < argc; ++i)
+  {
+    const std::string_view arg{argv[i]};
+    if(arg == "--headless")
+      headless = true;
+    else if(arg == "--gameflow" && i + 1 < argc)
+      gameflowId = argv[++i];
+    else if(arg == "--benchmark-flythrough")
+    {
+      benchmarkFrames = 600;
+      if(i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0])))
+        benchmarkFrames = std::stoul(argv[++i]);
+    }
+  }
+
+  if(headless && gameflowId.empty())
+  {
+    std::cerr << "--headless requires --gameflow <id>" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if(benchmarkFrames.has_value() && *benchmarkFrames == 0)
+  {
+    std::cerr << "--benchmark-flythrough requires a positive number of frames" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if(gameflowId.empty())
   {
     const auto launcherResult = launcher::showLauncher(argc, argv);
     if(!launcherResult.has_value())
@@ -86,7 +123,14 @@ int main(int argc, char** argv)
 
   try
   {
-    engine::Engine engine{findUserDataDir().value(), findEngineDataDir().value(), localeOverride, gameflowId};
+    engine::Engine engine{
+      findUserDataDir().value(), findEngineDataDir().value(), localeOverride, gameflowId, {1280, 800}, headless};
+    if(benchmarkFrames.has_value())
+    {
+      engine.runFlythroughBenchmark(*benchmarkFrames);
+      return EXIT_SUCCESS;
+    }
+
     size_t levelSequenceIndex = 0;
     enum class Mode
     {
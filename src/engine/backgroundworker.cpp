@@ -0,0 +1,66 @@
+#include "backgroundworker.h"
+
+#include <boost/log/trivial.hpp>
+#include <exception>
+#include <utility>
+
+namespace engine
+{
+BackgroundWorker::BackgroundWorker(std::string name)
+    : m_name{std::move(name)}
+    , m_thread{[this]()
+               {
+                 run();
+               }}
+{
+}
+
+BackgroundWorker::~BackgroundWorker()
+{
+  {
+    std::lock_guard lock{m_tasksLock};
+    m_shutdown = true;
+  }
+  m_tasksChanged.notify_all();
+  m_thread.join();
+}
+
+void BackgroundWorker::post(std::function<void()> task)
+{
+  {
+    std::lock_guard lock{m_tasksLock};
+    m_tasks.emplace(std::move(task));
+  }
+  m_tasksChanged.notify_one();
+}
+
+void BackgroundWorker::run()
+{
+  while(true)
+  {
+    std::function<void()> task;
+    {
+      std::unique_lock lock{m_tasksLock};
+      m_tasksChanged.wait(lock,
+                          [this]()
+                          {
+                            return m_shutdown || !m_tasks.empty();
+                          });
+      if(m_tasks.empty())
+        return;
+
+      task = std::move(m_tasks.front());
+      m_tasks.pop();
+    }
+
+    try
+    {
+      task();
+    }
+    catch(const std::exception& ex)
+    {
+      BOOST_LOG_TRIVIAL(error) << "Background task of " << m_name << " failed: " << ex.what();
+    }
+  }
+}
+} // namespace engine
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+
+namespace engine
+{
+//! Runs tasks, e.g. file I/O that would otherwise stall the game loop, in order on a dedicated thread.
+class BackgroundWorker final
+{
+public:
+  explicit BackgroundWorker(std::string name);
+  //! Waits until all posted tasks have been completed.
+  ~BackgroundWorker();
+
+  BackgroundWorker(const BackgroundWorker&) = delete;
+  BackgroundWorker(BackgroundWorker&&) = delete;
+  BackgroundWorker& operator=(BackgroundWorker&&) = delete;
+  BackgroundWorker& operator=(const BackgroundWorker&) = delete;
+
+  void post(std::function<void()> task);
+
+private:
+  const std::string m_name;
+  std::mutex m_tasksLock;
+  std::condition_variable m_tasksChanged;
+  std::queue<std::function<void()>> m_tasks;
+  bool m_shutdown = false;
+  std::thread m_thread;
+
+  void run();
+};
+} // namespace engine
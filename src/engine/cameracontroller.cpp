@@ -33,9 +33,11 @@
 #include <cstddef>
 #include <exception>
 #include <functional>
+#include <glm/gtc/epsilon.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
+#include <glm/vector_relational.hpp>
 #include <map>
 #include <type_traits>
 #include <utility>
@@ -403,15 +405,80 @@ void CameraController::handleCommandSequence(const floordata::FloorDataValue* cm
     m_lookAtObject = nullptr;
 }
 
+bool CameraController::PortalTraceKey::isCloseTo(const PortalTraceKey& rhs) const
+{
+  // the translation is in world units, everything else is in the order of 1
+  static constexpr float TranslationEps = 1.0f / 16;
+  static constexpr float Eps = 1.0f / (1 << 16); // NOLINT(hicpp-signed-bitwise)
+
+  if(startRoom != rhs.startRoom || roomsAreSwapped != rhs.roomsAreSwapped || laraRoom != rhs.laraRoom)
+    return false;
+
+  for(glm::length_t i = 0; i < 4; ++i)
+  {
+    if(!glm::all(glm::epsilonEqual(viewMatrix[i], rhs.viewMatrix[i], i == 3 ? TranslationEps : Eps))
+       || !glm::all(glm::epsilonEqual(projectionMatrix[i], rhs.projectionMatrix[i], Eps)))
+      return false;
+  }
+  return true;
+}
+
 std::unordered_set<const world::Portal*> CameraController::tracePortals()
 {
-  for(const auto& room : m_world->getRooms())
+  const auto lara = m_world->getObjectManager().getLaraPtr();
+  const PortalTraceKey key{m_location.room.get(),
+                           m_world->roomsAreSwapped(),
+                           lara == nullptr ? nullptr : lara->m_state.location.room.get(),
+                           m_camera->getViewMatrix(),
+                           m_camera->getProjectionMatrix()};
+  const auto& rooms = m_world->getRooms();
+  if(!m_portalTraceKey.has_value())
+  {
+    for(const auto& room : rooms)
+    {
+      room.node->setVisible(false);
+      room.node->clearScissor();
+    }
+  }
+  else if(m_portalTraceKey->isCloseTo(key))
   {
-    room.node->setVisible(false);
-    room.node->clearScissors();
+    return m_portalTracer.getWaterSurfacePortals();
+  }
+  else
+  {
+    // only the rooms of the previous trace need to be reset; room swaps keep the visibility with the room index
+    for(const auto roomIndex : m_visibleRooms)
+    {
+      rooms[roomIndex].node->setVisible(false);
+      rooms[roomIndex].node->clearScissor();
+    }
+  }
+  m_portalTraceKey = key;
+  m_visibleRooms.clear();
+
+  m_portalTracer.trace(*m_location.room, *m_world);
+  for(const auto roomIndex : m_portalTracer.getVisibleRooms())
+  {
+    const auto& node = rooms[roomIndex].node;
+    const auto& visibility = m_portalTracer.getRoomVisibility(roomIndex);
+    node->setVisible(true);
+    node->setRenderOrder(visibility.renderOrder);
+    if(const auto& scissor = visibility.scissor; scissor.has_value())
+      node->setScissor(scissor->min, scissor->max - scissor->min);
+    else
+      node->clearScissor();
+    m_visibleRooms.emplace_back(roomIndex);
   }
 
-  return render::PortalTracer::trace(*m_location.room, *m_world);
+  // lara's room is always rendered, even if it can't be seen through any portal
+  if(key.laraRoom != nullptr && !key.laraRoom->node->isVisible())
+  {
+    key.laraRoom->node->setVisible(true);
+    key.laraRoom->node->clearScissor();
+    m_visibleRooms.emplace_back(gsl::narrow_cast<size_t>(key.laraRoom - rooms.data()));
+  }
+
+  return m_portalTracer.getWaterSurfacePortals();
 }
 
 std::unordered_set<const world::Portal*> CameraController::update()
@@ -846,6 +913,13 @@ void CameraController::serialize(const serialization::Serializer<world::World>&
       S_NV("cinematicFrame", m_cinematicFrame),
       S_NV("cinematicPos", m_cinematicPos),
       S_NV("cinematicRot", m_cinematicRot));
+
+  if(ser.loading)
+  {
+    // the rooms may have been reordered, so the next trace must start from scratch
+    m_visibleRooms.clear();
+    m_portalTraceKey.reset();
+  }
 }
 
 glm::vec3 CameraController::getPosition() const
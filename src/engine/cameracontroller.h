@@ -8,14 +8,18 @@
 #include "floordata/types.h"
 #include "location.h"
 #include "qs/quantity.h"
+#include "render/portaltracer.h"
 #include "serialization/serialization_fwd.h"
 
 #include <cstdint>
 #include <glm/fwd.hpp>
+#include <glm/mat4x4.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
 #include <memory>
+#include <optional>
 #include <unordered_set>
+#include <vector>
 
 namespace render::scene
 {
@@ -101,6 +105,23 @@ private:
   int m_currentFixedCameraId = -1;
   core::Frame m_camOverrideTimeout{-1_frame};
 
+  //! @brief The state the last portal trace was done for; the trace is reused as long as it doesn't change.
+  struct PortalTraceKey
+  {
+    const world::Room* startRoom;
+    bool roomsAreSwapped;
+    const world::Room* laraRoom;
+    glm::mat4 viewMatrix;
+    glm::mat4 projectionMatrix;
+
+    [[nodiscard]] bool isCloseTo(const PortalTraceKey& rhs) const;
+  };
+
+  render::PortalTracer m_portalTracer;
+  std::optional<PortalTraceKey> m_portalTraceKey;
+  //! @brief Indices of all rooms made visible by the last portal trace.
+  std::vector<size_t> m_visibleRooms;
+
 public:
   explicit CameraController(const gsl::not_null<world::World*>& world, gslu::nn_shared<render::scene::Camera> camera);
 
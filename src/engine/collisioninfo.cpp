@@ -12,7 +12,6 @@
 #include "engine/objects/objectstate.h"
 #include "engine/world/room.h"
 #include "engine/world/sector.h"
-#include "engine/world/staticmesh.h"
 #include "objects/laraobject.h"
 #include "qs/qs.h"
 #include "type_safe/integer.hpp"
@@ -41,37 +40,6 @@ namespace
   return 1_sectors - (targetInSector - 1_len);
 }
 
-[[nodiscard]] core::BoundingBox
-  rotateTranslate(const core::BoundingBox& bbox, const core::TRVec& pos, const core::Angle& angle)
-{
-  auto result = bbox;
-
-  const auto axis = axisFromAngle(angle);
-  switch(axis)
-  {
-  case core::Axis::Deg0:
-    // nothing to do
-    break;
-  case core::Axis::Right90:
-    result.x = {bbox.z.min, bbox.z.max};
-    result.z = {-bbox.x.max, -bbox.x.min};
-    break;
-  case core::Axis::Deg180:
-    result.x = {-bbox.x.max, -bbox.x.min};
-    result.z = {-bbox.z.max, -bbox.z.min};
-    break;
-  case core::Axis::Left90:
-    result.x = {-bbox.z.max, -bbox.z.min};
-    result.z = {bbox.x.min, bbox.x.max};
-    break;
-  }
-
-  result.x += pos.X;
-  result.y += pos.Y;
-  result.z += pos.Z;
-  return result;
-}
-
 [[nodiscard]] core::Length minShift(const core::Length& min, const core::Length& max)
 {
   return min < max ? -min : max;
@@ -271,12 +239,12 @@ void CollisionInfo::initHeightInfo(const core::TRVec& laraPos, const world::Worl
   }
 }
 
-std::set<gsl::not_null<const world::Room*>> CollisionInfo::collectTouchingRooms(const core::TRVec& position,
-                                                                                const core::Length& radius,
-                                                                                const core::Length& height,
-                                                                                const world::World& world)
+CollisionInfo::TouchingRooms CollisionInfo::collectTouchingRooms(const core::TRVec& position,
+                                                                const core::Length& radius,
+                                                                const core::Length& height,
+                                                                const world::World& world)
 {
-  std::set<gsl::not_null<const world::Room*>> result;
+  TouchingRooms result;
   auto room = world.getObjectManager().getLara().m_state.location.room;
   result.emplace(room);
 
@@ -313,74 +281,68 @@ bool CollisionInfo::checkStaticMeshCollisions(const core::TRVec& objectPos,
 
   for(const auto& room : rooms)
   {
-    for(const world::RoomStaticMesh& rsm : room->staticMeshes)
-    {
-      if(rsm.staticMesh->doNotCollide)
-        continue;
+    const auto meshBox = room->staticMeshCollisions.findFirstIntersection(objectBox);
+    if(!meshBox.has_value())
+      continue;
 
-      const auto meshBox = rotateTranslate(rsm.staticMesh->collisionBox, rsm.position, rsm.rotation);
-      if(!meshBox.intersectsExclusive(objectBox))
-        continue;
+    // both collision boxes are in world space
+    shift.X = minShift(objectBox.x.max - meshBox->x.min, meshBox->x.max - objectBox.x.min);
+    shift.Z = minShift(objectBox.z.max - meshBox->z.min, meshBox->z.max - objectBox.z.min);
 
-      // both collision boxes are in world space
-      shift.X = minShift(objectBox.x.max - meshBox.x.min, meshBox.x.max - objectBox.x.min);
-      shift.Z = minShift(objectBox.z.max - meshBox.z.min, meshBox.z.max - objectBox.z.min);
-
-      switch(facingAxis)
+    switch(facingAxis)
+    {
+    case core::Axis::Deg0:
+      if(abs(shift.X) > collisionRadius)
       {
-      case core::Axis::Deg0:
-        if(abs(shift.X) > collisionRadius)
-        {
-          shift.X = initialPosition.X - objectPos.X;
-          collisionType = AxisColl::Front;
-        }
-        else
-        {
-          shift.Z = 0_len;
-          collisionType = shift.X > 0_len ? AxisColl::FrontLeft : AxisColl::FrontRight;
-        }
-        break;
-      case core::Axis::Deg180:
-        if(abs(shift.X) > collisionRadius)
-        {
-          shift.X = initialPosition.X - objectPos.X;
-          collisionType = AxisColl::Front;
-        }
-        else
-        {
-          shift.Z = 0_len;
-          collisionType = shift.X > 0_len ? AxisColl::FrontRight : AxisColl::FrontLeft;
-        }
-        break;
-      case core::Axis::Right90:
-        if(abs(shift.Z) > collisionRadius)
-        {
-          shift.Z = initialPosition.Z - objectPos.Z;
-          collisionType = AxisColl::Front;
-        }
-        else
-        {
-          shift.X = 0_len;
-          collisionType = shift.Z > 0_len ? AxisColl::FrontRight : AxisColl::FrontLeft;
-        }
-        break;
-      case core::Axis::Left90:
-        if(abs(shift.Z) > collisionRadius)
-        {
-          shift.Z = initialPosition.Z - objectPos.Z;
-          collisionType = AxisColl::Front;
-        }
-        else
-        {
-          shift.X = 0_len;
-          collisionType = shift.Z > 0_len ? AxisColl::FrontLeft : AxisColl::FrontRight;
-        }
-        break;
+        shift.X = initialPosition.X - objectPos.X;
+        collisionType = AxisColl::Front;
       }
-
-      hasStaticMeshCollision = true;
-      return hasStaticMeshCollision;
+      else
+      {
+        shift.Z = 0_len;
+        collisionType = shift.X > 0_len ? AxisColl::FrontLeft : AxisColl::FrontRight;
+      }
+      break;
+    case core::Axis::Deg180:
+      if(abs(shift.X) > collisionRadius)
+      {
+        shift.X = initialPosition.X - objectPos.X;
+        collisionType = AxisColl::Front;
+      }
+      else
+      {
+        shift.Z = 0_len;
+        collisionType = shift.X > 0_len ? AxisColl::FrontRight : AxisColl::FrontLeft;
+      }
+      break;
+    case core::Axis::Right90:
+      if(abs(shift.Z) > collisionRadius)
+      {
+        shift.Z = initialPosition.Z - objectPos.Z;
+        collisionType = AxisColl::Front;
+      }
+      else
+      {
+        shift.X = 0_len;
+        collisionType = shift.Z > 0_len ? AxisColl::FrontRight : AxisColl::FrontLeft;
+      }
+      break;
+    case core::Axis::Left90:
+      if(abs(shift.Z) > collisionRadius)
+      {
+        shift.Z = initialPosition.Z - objectPos.Z;
+        collisionType = AxisColl::Front;
+      }
+      else
+      {
+        shift.X = 0_len;
+        collisionType = shift.Z > 0_len ? AxisColl::FrontLeft : AxisColl::FrontRight;
+      }
+      break;
     }
+
+    hasStaticMeshCollision = true;
+    return hasStaticMeshCollision;
   }
 
   return hasStaticMeshCollision;
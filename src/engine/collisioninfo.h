@@ -7,9 +7,11 @@
 #include "heightinfo.h"
 #include "type_safe/flag_set.hpp"
 
+#include <boost/container/flat_set.hpp>
+#include <boost/container/static_vector.hpp>
 #include <cstdint>
+#include <functional>
 #include <gsl/gsl-lite.hpp> // IWYU pragma: keep
-#include <set>
 
 namespace engine::world
 {
@@ -68,12 +70,20 @@ struct CollisionInfo
 
   bool hasStaticMeshCollision = false;
 
+  //! The current room plus the rooms of the 8 corners of the collision cylinder's bounding box.
+  static constexpr size_t MaxTouchingRooms = 9;
+  //! Ordered by room address like the std::set it replaces, but without touching the heap.
+  using TouchingRooms = boost::container::flat_set<
+    gsl::not_null<const world::Room*>,
+    std::less<>,
+    boost::container::static_vector<gsl::not_null<const world::Room*>, MaxTouchingRooms>>;
+
   void initHeightInfo(const core::TRVec& laraPos, const world::World& world, const core::Length& height);
 
-  static std::set<gsl::not_null<const world::Room*>> collectTouchingRooms(const core::TRVec& position,
-                                                                          const core::Length& radius,
-                                                                          const core::Length& height,
-                                                                          const world::World& world);
+  static TouchingRooms collectTouchingRooms(const core::TRVec& position,
+                                            const core::Length& radius,
+                                            const core::Length& height,
+                                            const world::World& world);
 
   bool checkStaticMeshCollisions(const core::TRVec& objectPos,
                                  const core::Length& objectHeight,
@@ -7,9 +7,11 @@
 #include "core/units.h"
 #include "engine/audioengine.h"
 #include "engine/audiosettings.h"
+#include "engine/backgroundworker.h"
 #include "engine/cameracontroller.h"
 #include "engine/displaysettings.h"
 #include "engine/engineconfig.h"
+#include "engine/flythroughbenchmark.h"
 #include "engine/ghosting/ghostmodel.h"
 #include "engine/inventory.h"
 #include "engine/objectmanager.h"
@@ -26,6 +28,7 @@
 #include "player.h"
 #include "presenter.h"
 #include "qs/qs.h"
+#include "render/gpuprofiler.h"
 #include "render/rendersettings.h"
 #include "render/scene/materialmanager.h"
 #include "render/scene/mesh.h"
@@ -135,6 +138,27 @@ void drawBugReportMessage(ui::Ui& ui, const ui::TRFont& trFont)
   text.draw(ui, trFont, pos);
 }
 
+void drawGpuTimings(ui::Ui& ui, const ui::TRFont& trFont, const render::GpuProfiler& gpuProfiler)
+{
+  static constexpr float Scale = 0.5f;
+  static constexpr int LineHeight = ui::FontHeight * 3 / 4;
+  static constexpr int Indent = 8;
+
+  glm::ivec2 pos{Indent, ui::FontHeight};
+  std::chrono::duration<float, std::milli> total{0};
+  for(const auto& timing : gpuProfiler.getTimings())
+  {
+    const std::chrono::duration<float, std::milli> duration{timing.duration};
+    if(timing.depth == 0)
+      total += duration;
+
+    ui::Text{(boost::format("%1% %2$.2f ms") % timing.name % duration.count()).str()}.draw(
+      ui, trFont, pos + glm::ivec2{gsl::narrow<int>(timing.depth) * Indent, 0}, Scale);
+    pos.y += LineHeight;
+  }
+  ui::Text{(boost::format("total %1$.2f ms") % total.count()).str()}.draw(ui, trFont, pos, Scale);
+}
+
 bool showLevelStats(const std::shared_ptr<Presenter>& presenter, world::World& world)
 {
   static constexpr const auto BlendDuration = 30_frame;
@@ -160,9 +184,7 @@ bool showLevelStats(const std::shared_ptr<Presenter>& presenter, world::World& w
 
     {
       const auto portals = world.getCameraController().update();
-      if(const auto lara = world.getObjectManager().getLaraPtr())
-        lara->m_state.location.room->node->setVisible(true);
-      presenter->renderWorld(world.getRooms(), world.getCameraController(), portals);
+      presenter->renderWorld(world.getRooms(), world.getRoomGeometry(), world.getCameraController(), portals);
     }
     presenter->renderScreenOverlay();
 
@@ -203,7 +225,8 @@ Engine::Engine(std::filesystem::path userDataPath,
                const std::filesystem::path& engineDataPath,
                const std::optional<std::string>& localOverride,
                const std::string& gameflowId,
-               const glm::ivec2& resolution)
+               const glm::ivec2& resolution,
+               const bool headless)
     : m_userDataPath{std::move(userDataPath)}
     , m_engineDataPath{engineDataPath}
     , m_gameflowId{gameflowId}
@@ -234,7 +257,7 @@ Engine::Engine(std::filesystem::path userDataPath,
     doc.load("config", *m_engineConfig, *m_engineConfig);
   }
 
-  m_presenter = std::make_shared<Presenter>(m_engineDataPath, resolution);
+  m_presenter = std::make_shared<Presenter>(m_engineDataPath, m_userDataPath, resolution, headless);
   if(gl::hasAnisotropicFilteringExtension()
      && m_engineConfig->renderSettings.anisotropyLevel > gl::getMaxAnisotropyLevel())
   {
@@ -312,9 +335,7 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
     {
       {
         const auto portals = world.getCameraController().update();
-        if(const auto lara = world.getObjectManager().getLaraPtr())
-          lara->m_state.location.room->node->setVisible(true);
-        m_presenter->renderWorld(world.getRooms(), world.getCameraController(), portals);
+        m_presenter->renderWorld(world.getRooms(), world.getRoomGeometry(), world.getCameraController(), portals);
       }
       m_presenter->updateSoundEngine();
       m_presenter->renderScreenOverlay();
@@ -442,6 +463,8 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
         drawBugReportMessage(ui, getPresenter().getTrFont());
         bugReportSavedDuration -= 1_frame;
       }
+      if(m_presenter->getGpuProfiler().isEnabled())
+        drawGpuTimings(ui, getPresenter().getTrFont(), m_presenter->getGpuProfiler());
 
       if(ghostManager.reader != nullptr)
       {
@@ -479,17 +502,40 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
       bugReportSavedDuration = core::FrameRate * 5_sec;
       throttler.reset();
     }
+
+    if(m_presenter->getInputHandler().hasDebouncedAction(hid::Action::GpuTimings))
+    {
+      auto& gpuProfiler = m_presenter->getGpuProfiler();
+      gpuProfiler.setEnabled(!gpuProfiler.isEnabled());
+    }
+
+    if(m_presenter->getInputHandler().hasDebouncedAction(hid::Action::DumpGpuTimings))
+    {
+      saveGpuTimings();
+      throttler.reset();
+    }
   }
 }
 
 void Engine::makeScreenshot()
 {
-  auto img = m_presenter->takeScreenshot();
-  if(!std::filesystem::is_directory(m_userDataPath / "screenshots"))
-    std::filesystem::create_directories(m_userDataPath / "screenshots");
+  m_presenter->takeScreenshot(
+    [path = m_userDataPath / "screenshots" / (getCurrentHumanReadableTimestamp() + ".png")](gl::CImgWrapper& image)
+    {
+      if(!std::filesystem::is_directory(path.parent_path()))
+        std::filesystem::create_directories(path.parent_path());
 
-  auto filename = getCurrentHumanReadableTimestamp() + ".png";
-  img.savePng(m_userDataPath / "screenshots" / filename);
+      image.savePng(path);
+    });
+}
+
+void Engine::saveGpuTimings()
+{
+  if(!std::filesystem::is_directory(m_userDataPath / "gputimings"))
+    std::filesystem::create_directories(m_userDataPath / "gputimings");
+
+  m_presenter->getGpuProfiler().writeCsv(m_userDataPath / "gputimings"
+                                         / (getCurrentHumanReadableTimestamp() + ".csv"));
 }
 
 void Engine::takeBugReport(world::World& world)
@@ -505,13 +551,21 @@ void Engine::takeBugReport(world::World& world)
     std::filesystem::create_directory(m_userDataPath / "bugreports" / dirName);
   }
 
-  std::filesystem::copy_file(m_userDataPath / "croftengine.log",
-                             m_userDataPath / "bugreports" / dirName / "croftengine.log");
-
-  auto img = m_presenter->takeScreenshot();
-  img.savePng(m_userDataPath / "bugreports" / dirName / "screenshot.png");
-
-  world.save(m_userDataPath / "bugreports" / dirName / "save.yaml", false);
+  const auto path = m_userDataPath / "bugreports" / dirName;
+  // the world must be serialized before the game loop continues, but everything else can be done in the background
+  m_presenter->getBackgroundWorker()->post(
+    [logPath = m_userDataPath / "croftengine.log",
+     path,
+     doc = std::shared_ptr{world.serialize(path / "save.yaml", false)}]()
+    {
+      std::filesystem::copy_file(logPath, path / "croftengine.log");
+      doc->write();
+    });
+  m_presenter->takeScreenshot(
+    [path](gl::CImgWrapper& image)
+    {
+      image.savePng(path / "screenshot.png");
+    });
 }
 
 std::pair<RunResult, std::optional<size_t>> Engine::runTitleMenu(world::World& world)
@@ -638,6 +692,30 @@ std::pair<RunResult, std::optional<size_t>>
   return item.runFromSave(*this, slot, player, levelStartPlayer);
 }
 
+void Engine::runFlythroughBenchmark(const size_t framesPerLevel)
+{
+  FlythroughBenchmark benchmark{framesPerLevel};
+  m_presenter->setVsync(false);
+  for(const auto& item : m_scriptEngine.getGameflow().getLevelSequence())
+  {
+    m_presenter->getSoundEngine()->reset();
+    m_presenter->clear();
+    applySettings();
+    gl::Framebuffer::unbindAll();
+
+    const auto player = std::make_shared<Player>();
+    const auto levelStartPlayer = std::make_shared<Player>(*player);
+    if(!item->runBenchmark(*this, benchmark, player, levelStartPlayer))
+      break;
+  }
+  m_presenter->setVsync(true);
+
+  if(!std::filesystem::is_directory(m_userDataPath / "benchmarks"))
+    std::filesystem::create_directories(m_userDataPath / "benchmarks");
+
+  benchmark.writeJson(m_userDataPath / "benchmarks" / (getCurrentHumanReadableTimestamp() + ".json"));
+}
+
 std::unique_ptr<loader::trx::Glidos> Engine::loadGlidosPack() const
 {
   if(m_engineConfig->renderSettings.glidosPack.has_value())
@@ -691,9 +769,7 @@ void Engine::applySettings()
     world->getAudioEngine().setSfxGain(m_engineConfig->audioSettings.sfxVolume);
     for(auto& room : world->getRooms())
     {
-      room.collectShaderLights(m_engineConfig->renderSettings.getLightCollectionDepth());
-      room.regenerateDust(m_presenter,
-                          m_presenter->getMaterialManager()->getDustParticle(),
+      room.regenerateDust(m_presenter->getMaterialManager()->getDustParticle(),
                           m_engineConfig->renderSettings.dustActive,
                           m_engineConfig->renderSettings.dustDensity);
     }
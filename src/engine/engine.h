@@ -82,13 +82,15 @@ private:
 
   void makeScreenshot();
   void takeBugReport(world::World& world);
+  void saveGpuTimings();
 
 public:
   explicit Engine(std::filesystem::path userDataPath,
                   const std::filesystem::path& engineDataPath,
                   const std::optional<std::string>& localOverride,
                   const std::string& gameflowId,
-                  const glm::ivec2& resolution = {1280, 800});
+                  const glm::ivec2& resolution = {1280, 800},
+                  bool headless = false);
 
   ~Engine();
 
@@ -137,6 +139,9 @@ public:
                                  const std::optional<size_t>& slot,
                                  const std::shared_ptr<Player>& player,
                                  const std::shared_ptr<Player>& levelStartPlayer);
+  //! Renders @a framesPerLevel frames of each level in the level sequence as fast as possible, and writes the
+  //! measured timings to the benchmarks directory.
+  void runFlythroughBenchmark(size_t framesPerLevel);
 
   [[nodiscard]] const auto& getGlidos() const noexcept
   {
@@ -54,6 +54,8 @@ std::vector<NamedInputMappingConfig> getDefaultMappings()
         {GlfwKey::E, Action::StepRight},
         {GlfwKey::F12, Action::Screenshot},
         {GlfwKey::F1, Action::BugReport},
+        {GlfwKey::F3, Action::GpuTimings},
+        {GlfwKey::F4, Action::DumpGpuTimings},
         {GlfwKey::F10, Action::CheatDive} // only available in debug builds
       },
     },
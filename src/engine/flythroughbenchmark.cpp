@@ -0,0 +1,345 @@
+#include "flythroughbenchmark.h"
+
+#include "cameracontroller.h"
+#include "core/angle.h"
+#include "core/magic.h"
+#include "core/units.h"
+#include "core/vec.h"
+#include "location.h"
+#include "objectmanager.h"
+#include "objects/laraobject.h"
+#include "presenter.h"
+#include "render/gpuprofiler.h"
+#include "render/scene/materialmanager.h"
+#include "ui/ui.h"
+#include "world/cinematicframe.h"
+#include "world/room.h"
+#include "world/world.h"
+
+#include <algorithm>
+#include <boost/log/trivial.hpp>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <glm/geometric.hpp>
+#include <glm/vector_relational.hpp>
+#include <gsl/gsl-lite.hpp>
+#include <iomanip>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <unordered_set>
+#include <utility>
+
+namespace engine
+{
+namespace
+{
+template<typename Rep, typename Period>
+double toMillis(const std::chrono::duration<Rep, Period>& duration)
+{
+  return std::chrono::duration<double, std::milli>{duration}.count();
+}
+
+void addWaypoint(std::vector<glm::vec3>& waypoints, const glm::vec3& waypoint)
+{
+  if(waypoints.empty() || glm::distance(waypoints.back(), waypoint) > 1.0f)
+    waypoints.emplace_back(waypoint);
+}
+
+void addWaypoint(std::vector<glm::vec3>& waypoints, const world::Room& room)
+{
+  // rooms without geometry have no meaningful center, they're only passed through their portals
+  if(glm::any(glm::greaterThan(room.verticesBBoxMin, room.verticesBBoxMax)))
+    return;
+
+  addWaypoint(waypoints, room.position.toRenderSystem() + (room.verticesBBoxMin + room.verticesBBoxMax) / 2.0f);
+}
+
+glm::vec3 getCenter(const world::Portal& portal)
+{
+  return std::accumulate(portal.vertices.begin(), portal.vertices.end(), glm::vec3{0.0f})
+         / gsl::narrow_cast<float>(portal.vertices.size());
+}
+
+/**
+ * Walks depth-first through all rooms not visited yet, passing through the center of each portal on the way into a
+ * room and back out of it, so that the camera never has to pass through walls.
+ */
+void visitRooms(const world::Room& room,
+                std::unordered_set<const world::Room*>& visited,
+                std::vector<glm::vec3>& waypoints)
+{
+  addWaypoint(waypoints, room);
+  for(const auto& portal : room.portals)
+  {
+    if(!visited.emplace(portal.adjoiningRoom.get()).second)
+      continue;
+
+    const auto portalCenter = getCenter(portal);
+    addWaypoint(waypoints, portalCenter);
+    visitRooms(*portal.adjoiningRoom, visited, waypoints);
+    addWaypoint(waypoints, portalCenter);
+    addWaypoint(waypoints, room);
+  }
+}
+
+//! Distributes @a frameCount camera frames evenly along the path defined by @a waypoints.
+std::vector<world::CinematicFrame> createFrames(const std::vector<glm::vec3>& waypoints, size_t frameCount)
+{
+  Expects(!waypoints.empty());
+  Expects(frameCount > 0);
+
+  std::vector<float> distances{0.0f};
+  for(size_t i = 1; i < waypoints.size(); ++i)
+    distances.emplace_back(distances.back() + glm::distance(waypoints[i - 1], waypoints[i]));
+
+  static constexpr float LookAheadDistance = core::SectorSize.cast<float>().get();
+
+  std::vector<world::CinematicFrame> frames;
+  frames.reserve(frameCount);
+  size_t segment = 0;
+  glm::vec3 lookDirection{0.0f, 0.0f, -1.0f};
+  for(size_t i = 0; i < frameCount; ++i)
+  {
+    const auto distance = distances.back() * gsl::narrow_cast<float>(i) / gsl::narrow_cast<float>(frameCount);
+    while(segment + 2 < waypoints.size() && distances[segment + 1] <= distance)
+      ++segment;
+
+    auto position = waypoints[segment];
+    if(segment + 1 < waypoints.size())
+    {
+      const auto direction
+        = (waypoints[segment + 1] - waypoints[segment]) / (distances[segment + 1] - distances[segment]);
+      position += direction * (distance - distances[segment]);
+
+      // keep the view level, as looking straight up or down would leave the view's up vector undefined
+      if(const glm::vec3 horizontal{direction.x, 0.0f, direction.z}; glm::length(horizontal) > 0.1f)
+        lookDirection = glm::normalize(horizontal);
+    }
+
+    frames.emplace_back(world::CinematicFrame{
+      core::TRVec{position + lookDirection * LookAheadDistance}, core::TRVec{position}, Presenter::DefaultFov, 0.0f});
+  }
+
+  return frames;
+}
+
+void writeString(std::ostream& stream, const std::string& value)
+{
+  stream << '"';
+  for(const auto c : value)
+  {
+    if(c == '"' || c == '\\')
+      stream << '\\' << c;
+    else if(static_cast<unsigned char>(c) < 0x20)
+      stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec
+             << std::setfill(' ');
+    else
+      stream << c;
+  }
+  stream << '"';
+}
+
+void writeStatistics(std::ostream& stream, std::vector<double> samples)
+{
+  stream << R"({"samples": )" << samples.size();
+  if(!samples.empty())
+  {
+    std::sort(samples.begin(), samples.end());
+    const auto avg = std::accumulate(samples.begin(), samples.end(), 0.0) / gsl::narrow_cast<double>(samples.size());
+    // nearest-rank percentile
+    const auto p99 = samples[(samples.size() * 99 + 99) / 100 - 1];
+    stream << R"(, "min": )" << samples.front() << R"(, "avg": )" << avg << R"(, "p99": )" << p99;
+  }
+  stream << "}";
+}
+
+void writeStatistics(std::ostream& stream, const std::map<std::string, std::vector<double>>& samples)
+{
+  stream << "{";
+  bool first = true;
+  for(const auto& [name, values] : samples)
+  {
+    stream << (first ? "\n" : ",\n") << "        ";
+    writeString(stream, name);
+    stream << ": ";
+    writeStatistics(stream, values);
+    first = false;
+  }
+  stream << (first ? "}" : "\n      }");
+}
+} // namespace
+
+bool FlythroughBenchmark::runCinematic(world::World& world)
+{
+  if(world.getCinematicFrames().empty())
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Skipping " << world.getLevelFilename() << ", it has no cinematic frames";
+    return true;
+  }
+
+  return run(world, world.getCinematicFrames(), true);
+}
+
+bool FlythroughBenchmark::runFlythrough(world::World& world)
+{
+  auto& cameraController = world.getCameraController();
+  const auto startRoom = world.getObjectManager().getLaraPtr() != nullptr
+                           ? world.getObjectManager().getLara().m_state.location.room
+                           : cameraController.getCurrentRoom();
+
+  std::unordered_set<const world::Room*> visited{startRoom.get()};
+  std::vector<glm::vec3> waypoints;
+  visitRooms(*startRoom, visited, waypoints);
+  if(waypoints.empty())
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Skipping " << world.getLevelFilename() << ", it has no room geometry";
+    return true;
+  }
+
+  BOOST_LOG_TRIVIAL(info) << "Flythrough path of " << world.getLevelFilename() << " visits " << visited.size()
+                          << " rooms through " << waypoints.size() << " waypoints";
+
+  const auto frames = createFrames(waypoints, m_frameCount);
+
+  // the frames are in world coordinates, and the camera follows the rooms the path leads through
+  cameraController.m_cinematicPos = core::TRVec{0_len, 0_len, 0_len};
+  cameraController.m_cinematicRot = core::TRRotation{0_deg, 0_deg, 0_deg};
+  cameraController.setEyeRotation(0_deg, 0_deg);
+  cameraController.setLocation(Location{startRoom, frames.front().position});
+
+  return run(world, frames, false);
+}
+
+bool FlythroughBenchmark::run(world::World& world,
+                              const std::vector<world::CinematicFrame>& frames,
+                              const bool isCinematic)
+{
+  Expects(!frames.empty());
+
+  using Clock = std::chrono::high_resolution_clock;
+
+  auto& presenter = world.getPresenter();
+  auto& cameraController = world.getCameraController();
+  auto& gpuProfiler = presenter.getGpuProfiler();
+  // only frames after the warm-up are profiled
+  gpuProfiler.setEnabled(false);
+
+  BOOST_LOG_TRIVIAL(info) << "Benchmarking " << world.getLevelFilename();
+  auto& result = m_results.emplace_back(
+    LevelResult{world.getLevelFilename().stem().string(), isCinematic ? "cinematic" : "rooms"});
+  std::optional<uint64_t> lastGpuFrame;
+
+  for(size_t i = 0; i < WarmupFrames + m_frameCount; ++i)
+  {
+    if(presenter.shouldClose())
+      return false;
+
+    const bool measure = i >= WarmupFrames;
+    if(i == WarmupFrames)
+      gpuProfiler.setEnabled(true);
+
+    const auto frameStart = Clock::now();
+    auto phaseStart = frameStart;
+    const auto endPhase = [&phaseStart, &result, measure](const char* phase)
+    {
+      const auto now = Clock::now();
+      if(measure)
+        result.cpuPhases[phase].emplace_back(toMillis(now - phaseStart));
+      phaseStart = now;
+    };
+
+    if(!presenter.preFrame())
+      continue;
+    endPhase("prepare");
+
+    if(const auto& history = gpuProfiler.getHistory(); !history.empty() && history.back().first != lastGpuFrame)
+    {
+      lastGpuFrame = history.back().first;
+      // passes may be measured more than once per frame, e.g. for each shadow cascade
+      std::map<std::string, double> passes;
+      for(const auto& timing : history.back().second)
+        passes[timing.name] += toMillis(timing.duration);
+      for(const auto& [name, duration] : passes)
+        result.gpuPasses[name].emplace_back(duration);
+    }
+
+    const auto frameIndex = i % frames.size();
+    if(isCinematic)
+      cameraController.m_cinematicFrame = core::Frame{gsl::narrow<core::Frame::type>(frameIndex)};
+    world.update(false);
+    presenter.getMaterialManager()->setDeathStrength(0);
+    const auto waterEntryPortals = cameraController.updateCinematic(frames[frameIndex], !isCinematic);
+    world.doGlobalEffect();
+    endPhase("update");
+
+    ui::Ui ui{presenter.getMaterialManager()->getUi(), world.getPalette(), presenter.getUiViewport()};
+    presenter.renderWorld(world.getRooms(), world.getRoomGeometry(), cameraController, waterEntryPortals);
+    presenter.renderScreenOverlay();
+    presenter.renderUi(ui, 1);
+    endPhase("render");
+
+    presenter.updateSoundEngine();
+    endPhase("audio");
+
+    presenter.swapBuffers();
+    endPhase("swap");
+
+    if(measure)
+      result.frameTimes.emplace_back(toMillis(phaseStart - frameStart));
+  }
+
+  gpuProfiler.setEnabled(false);
+  return true;
+}
+
+void FlythroughBenchmark::writeJson(const std::filesystem::path& path) const
+{
+  std::ofstream file{path, std::ios::out | std::ios::trunc};
+  if(!file.is_open())
+  {
+    BOOST_LOG_TRIVIAL(error) << "Failed to write benchmark results to " << path;
+    return;
+  }
+
+  file << std::fixed << std::setprecision(4);
+  file << "{\n";
+  file << R"(  "unit": "ms",)" << "\n";
+  file << R"(  "warmupFrames": )" << WarmupFrames << ",\n";
+  file << R"(  "framesPerLevel": )" << m_frameCount << ",\n";
+  file << R"(  "levels": [)";
+
+  Samples allFrameTimes;
+  bool first = true;
+  for(const auto& result : m_results)
+  {
+    file << (first ? "\n" : ",\n") << "    {\n";
+    file << R"(      "level": )";
+    writeString(file, result.level);
+    file << ",\n";
+    file << R"(      "path": )";
+    writeString(file, result.path);
+    file << ",\n";
+    file << R"(      "frameTime": )";
+    writeStatistics(file, result.frameTimes);
+    file << ",\n";
+    file << R"(      "cpuPhases": )";
+    writeStatistics(file, result.cpuPhases);
+    file << ",\n";
+    file << R"(      "gpuPasses": )";
+    writeStatistics(file, result.gpuPasses);
+    file << "\n    }";
+
+    allFrameTimes.insert(allFrameTimes.end(), result.frameTimes.begin(), result.frameTimes.end());
+    first = false;
+  }
+
+  file << (first ? "],\n" : "\n  ],\n");
+  file << R"(  "frameTime": )";
+  writeStatistics(file, allFrameTimes);
+  file << "\n}\n";
+
+  BOOST_LOG_TRIVIAL(info) << "Wrote benchmark results of " << m_results.size() << " levels to " << path;
+}
+} // namespace engine
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace engine::world
+{
+class World;
+struct CinematicFrame;
+} // namespace engine::world
+
+namespace engine
+{
+/**
+ * Renders a fixed number of frames per level along a predefined camera path as fast as possible, and reports the
+ * frame times as well as the CPU time of each frame phase and the GPU time of each render pass.
+ */
+class FlythroughBenchmark final
+{
+public:
+  explicit FlythroughBenchmark(size_t frameCount)
+      : m_frameCount{frameCount}
+  {
+  }
+
+  //! Follows the recorded camera frames of a cutscene, restarting them if necessary; returns false if the window was
+  //! closed.
+  bool runCinematic(world::World& world);
+  //! Follows a path through all rooms reachable through portals from Lara's room; returns false if the window was
+  //! closed.
+  bool runFlythrough(world::World& world);
+
+  void writeJson(const std::filesystem::path& path) const;
+
+private:
+  //! Number of frames rendered before measuring, so that the initial resource uploads don't skew the results.
+  static constexpr size_t WarmupFrames = 30;
+
+  //! Durations in milliseconds.
+  using Samples = std::vector<double>;
+
+  struct LevelResult
+  {
+    std::string level;
+    std::string path;
+    Samples frameTimes{};
+    std::map<std::string, Samples> cpuPhases{};
+    std::map<std::string, Samples> gpuPasses{};
+  };
+
+  const size_t m_frameCount;
+  std::vector<LevelResult> m_results;
+
+  bool run(world::World& world, const std::vector<world::CinematicFrame>& frames, bool isCinematic);
+};
+} // namespace engine
@@ -90,9 +90,7 @@ bool GhostManager::askGhostSave(Presenter& presenter, world::World& world)
     msgBox->draw(ui, presenter);
     {
       const auto portals = world.getCameraController().update();
-      if(const auto lara = world.getObjectManager().getLaraPtr())
-        lara->m_state.location.room->node->setVisible(true);
-      presenter.renderWorld(world.getRooms(), world.getCameraController(), portals);
+      presenter.renderWorld(world.getRooms(), world.getRoomGeometry(), world.getCameraController(), portals);
     }
     presenter.renderScreenOverlay();
     presenter.renderUi(ui, 1.0f);
@@ -2,8 +2,9 @@
 
 #include "abstractstatehandler.h"
 #include "engine/collisioninfo.h"
-#include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/world/skeletalmodeltype.h"
+#include "util/helpers.h"
 
 #include <gslu.h>
 
@@ -50,9 +51,8 @@ public:
       p.X += util::rand15s(r);
       p.Y += util::rand15s(r);
       p.Z += util::rand15s(r);
-      auto fx = gsl::make_shared<SparkleParticle>(Location{world.getObjectManager().getLara().m_state.location.room, p},
-                                                  world);
-      world.getObjectManager().registerParticle(fx);
+      world.getObjectManager().getParticlePool().spawnSparkle(
+        world, Location{world.getObjectManager().getLara().m_state.location.room, p});
     }
   }
 };
@@ -0,0 +1,288 @@
+#include "lightgrid.h"
+
+#include "render/scene/camera.h"
+#include "render/scene/node.h"
+#include "world/room.h"
+
+#include <algorithm>
+#include <cmath>
+#include <gl/api/gl.hpp>
+#include <glm/common.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <glm/vector_relational.hpp>
+#include <gsl/gsl-lite.hpp>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <optional>
+
+namespace engine
+{
+namespace
+{
+// lights contributing less than this are cut off; the falloff never reaches zero
+constexpr float LightCutoff = 1.0f / 64.0f;
+
+size_t indexOf(const std::vector<world::Room>& rooms, const world::Room& room)
+{
+  return gsl::narrow_cast<size_t>(&room - rooms.data());
+}
+
+//! The union of the bounds of all rooms up to @a depth portals away from @a room.
+std::optional<render::scene::BoundingBox> getNeighbourhoodBounds(const world::Room& room, const size_t depth)
+{
+  std::vector<const world::Room*> reached{&room};
+  size_t frontierBegin = 0;
+  for(size_t i = 0; i < depth; ++i)
+  {
+    const auto frontierEnd = reached.size();
+    for(size_t j = frontierBegin; j < frontierEnd; ++j)
+    {
+      for(const auto& portal : reached[j]->portals)
+      {
+        if(std::find(reached.begin(), reached.end(), portal.adjoiningRoom.get()) == reached.end())
+          reached.emplace_back(portal.adjoiningRoom.get());
+      }
+    }
+    frontierBegin = frontierEnd;
+  }
+
+  std::optional<render::scene::BoundingBox> bounds;
+  for(const auto& reachedRoom : reached)
+  {
+    const auto& roomBounds = reachedRoom->node->getWorldBounds();
+    if(!roomBounds.has_value())
+      return std::nullopt;
+
+    if(bounds.has_value())
+      bounds->extend(*roomBounds);
+    else
+      bounds = roomBounds;
+  }
+  return bounds;
+}
+
+std::vector<uint32_t> createDisabledTable()
+{
+  return std::vector<uint32_t>(LightGrid::HeaderSize + 2 * LightGrid::ClusterCount, 0);
+}
+
+uint32_t getSlice(const float depth, const float nearPlane, const float farPlane)
+{
+  const auto slice = std::log(std::max(depth, nearPlane) / nearPlane) / std::log(farPlane / nearPlane)
+                     * static_cast<float>(LightGrid::Slices);
+  return static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(LightGrid::Slices - 1)));
+}
+
+uint32_t getTile(const float ndc, const uint32_t tiles)
+{
+  const auto tile = (ndc * 0.5f + 0.5f) * static_cast<float>(tiles);
+  return static_cast<uint32_t>(std::clamp(tile, 0.0f, static_cast<float>(tiles - 1)));
+}
+} // namespace
+
+LightGrid::LightGrid()
+    : m_lightsBuffer{getLightsBuffer()}
+    , m_clusterBuffer{getClusterBuffer()}
+{
+}
+
+gslu::nn_shared<gl::ShaderStorageBuffer<ShaderLight>> LightGrid::getLightsBuffer()
+{
+  static std::weak_ptr<gl::ShaderStorageBuffer<ShaderLight>> instance;
+  if(auto tmp = instance.lock())
+    return gsl::not_null{tmp};
+
+  auto tmp = gsl::make_shared<gl::ShaderStorageBuffer<ShaderLight>>("light-grid-lights");
+  instance = tmp.get();
+  return tmp;
+}
+
+gslu::nn_shared<gl::ShaderStorageBuffer<uint32_t>> LightGrid::getClusterBuffer()
+{
+  static std::weak_ptr<gl::ShaderStorageBuffer<uint32_t>> instance;
+  if(auto tmp = instance.lock())
+    return gsl::not_null{tmp};
+
+  auto tmp = gsl::make_shared<gl::ShaderStorageBuffer<uint32_t>>("light-grid-clusters");
+  tmp->setData(createDisabledTable(), gl::api::BufferUsage::StreamDraw);
+  instance = tmp.get();
+  return tmp;
+}
+
+gslu::nn_shared<gl::ShaderStorageBuffer<uint32_t>> LightGrid::getDisabledBuffer()
+{
+  static std::weak_ptr<gl::ShaderStorageBuffer<uint32_t>> instance;
+  if(auto tmp = instance.lock())
+    return gsl::not_null{tmp};
+
+  auto tmp = gsl::make_shared<gl::ShaderStorageBuffer<uint32_t>>("light-grid-disabled");
+  tmp->setData(createDisabledTable(), gl::api::BufferUsage::StaticDraw);
+  instance = tmp.get();
+  return tmp;
+}
+
+void LightGrid::update(const std::vector<world::Room>& rooms,
+                       const render::scene::Camera& camera,
+                       const size_t collectionDepth)
+{
+  m_lights.clear();
+  m_ranges.clear();
+
+  // every room up to collectionDepth portals away from a visible room may contain a light reaching into it
+  m_seenRooms.assign(rooms.size(), false);
+  std::vector<const world::Room*> lightRooms;
+  for(const auto& room : rooms)
+  {
+    if(!room.node->isVisible())
+      continue;
+
+    m_seenRooms[indexOf(rooms, room)] = true;
+    lightRooms.emplace_back(&room);
+  }
+  size_t frontierBegin = 0;
+  for(size_t i = 0; i < collectionDepth; ++i)
+  {
+    const auto frontierEnd = lightRooms.size();
+    for(size_t j = frontierBegin; j < frontierEnd; ++j)
+    {
+      for(const auto& portal : lightRooms[j]->portals)
+      {
+        const auto roomIndex = indexOf(rooms, *portal.adjoiningRoom);
+        if(m_seenRooms[roomIndex])
+          continue;
+
+        m_seenRooms[roomIndex] = true;
+        lightRooms.emplace_back(portal.adjoiningRoom.get());
+      }
+    }
+    frontierBegin = frontierEnd;
+  }
+
+  const auto& view = camera.getViewMatrix();
+  const auto& projection = camera.getProjectionMatrix();
+  const auto nearPlane = camera.getNearPlane();
+  const auto farPlane = camera.getFarPlane();
+
+  for(const auto& room : lightRooms)
+  {
+    if(room->lights.empty())
+      continue;
+
+    const auto neighbourhoodBounds = getNeighbourhoodBounds(*room, collectionDepth);
+    for(const auto& light : room->lights)
+    {
+      if(light.intensity.get() <= 0)
+        continue;
+
+      const ShaderLight shaderLight{glm::vec4{light.position.toRenderSystem(), 0.0f},
+                                    toBrightness(light.intensity).get(),
+                                    light.fadeDistance.get<float>()};
+      // brightness / ((d/fadeDistance)^2 + 1) = LightCutoff
+      const auto radius
+        = shaderLight.fadeDistance * std::sqrt(std::max(shaderLight.brightness / LightCutoff - 1.0f, 0.0f));
+      if(radius <= 0)
+        continue;
+
+      render::scene::BoundingBox bounds{glm::vec3{shaderLight.position} - radius,
+                                        glm::vec3{shaderLight.position} + radius};
+      if(neighbourhoodBounds.has_value())
+      {
+        bounds.min = glm::max(bounds.min, neighbourhoodBounds->min);
+        bounds.max = glm::min(bounds.max, neighbourhoodBounds->max);
+        if(glm::any(glm::greaterThan(bounds.min, bounds.max)))
+          continue;
+      }
+
+      const auto viewBounds = bounds.transformed(view);
+      // the camera looks along -z
+      const auto minDepth = -viewBounds.max.z;
+      const auto maxDepth = -viewBounds.min.z;
+      if(maxDepth < nearPlane || minDepth > farPlane)
+        continue;
+
+      ClusterRange range{{0, 0, getSlice(minDepth, nearPlane, farPlane)},
+                         {TilesX - 1, TilesY - 1, getSlice(maxDepth, nearPlane, farPlane)}};
+      if(minDepth > nearPlane)
+      {
+        // all corners are in front of the camera, so their projections bound the light's screen area
+        glm::vec2 ndcMin{std::numeric_limits<float>::max()};
+        glm::vec2 ndcMax{std::numeric_limits<float>::lowest()};
+        for(const auto& corner : {glm::vec3{viewBounds.min.x, viewBounds.min.y, viewBounds.min.z},
+                                  glm::vec3{viewBounds.min.x, viewBounds.min.y, viewBounds.max.z},
+                                  glm::vec3{viewBounds.min.x, viewBounds.max.y, viewBounds.min.z},
+                                  glm::vec3{viewBounds.min.x, viewBounds.max.y, viewBounds.max.z},
+                                  glm::vec3{viewBounds.max.x, viewBounds.min.y, viewBounds.min.z},
+                                  glm::vec3{viewBounds.max.x, viewBounds.min.y, viewBounds.max.z},
+                                  glm::vec3{viewBounds.max.x, viewBounds.max.y, viewBounds.min.z},
+                                  glm::vec3{viewBounds.max.x, viewBounds.max.y, viewBounds.max.z}})
+        {
+          const auto clip = projection * glm::vec4{corner, 1.0f};
+          const auto ndc = glm::vec2{clip} / clip.w;
+          ndcMin = glm::min(ndcMin, ndc);
+          ndcMax = glm::max(ndcMax, ndc);
+        }
+
+        if(glm::any(glm::lessThan(ndcMax, glm::vec2{-1.0f})) || glm::any(glm::greaterThan(ndcMin, glm::vec2{1.0f})))
+          continue;
+
+        range.min.x = getTile(ndcMin.x, TilesX);
+        range.min.y = getTile(ndcMin.y, TilesY);
+        range.max.x = getTile(ndcMax.x, TilesX);
+        range.max.y = getTile(ndcMax.y, TilesY);
+      }
+
+      m_lights.emplace_back(shaderLight);
+      m_ranges.emplace_back(range);
+    }
+  }
+
+  // count the lights per cluster, turn the counts into offsets, then fill in the light indices
+  m_table.assign(HeaderSize + 2 * ClusterCount, 0);
+  m_table[0] = 1;
+  const auto forEachCluster = [](const ClusterRange& range, const auto& callback)
+  {
+    for(uint32_t z = range.min.z; z <= range.max.z; ++z)
+      for(uint32_t y = range.min.y; y <= range.max.y; ++y)
+        for(uint32_t x = range.min.x; x <= range.max.x; ++x)
+          callback(HeaderSize + 2 * ((size_t{z} * TilesY + y) * TilesX + x));
+  };
+
+  for(const auto& range : m_ranges)
+  {
+    forEachCluster(range,
+                   [this](const size_t cluster)
+                   {
+                     ++m_table[cluster + 1];
+                   });
+  }
+
+  uint32_t offset = 0;
+  for(size_t i = 0; i < ClusterCount; ++i)
+  {
+    auto& cluster = m_table[HeaderSize + 2 * i];
+    cluster = offset;
+    offset += m_table[HeaderSize + 2 * i + 1];
+    // reset the count, it is incremented again while filling in the indices
+    m_table[HeaderSize + 2 * i + 1] = 0;
+  }
+
+  m_table.resize(m_table.size() + offset);
+  const auto indicesBegin = HeaderSize + 2 * ClusterCount;
+  for(size_t lightIndex = 0; lightIndex < m_ranges.size(); ++lightIndex)
+  {
+    forEachCluster(m_ranges[lightIndex],
+                   [this, lightIndex, indicesBegin](const size_t cluster)
+                   {
+                     m_table[indicesBegin + m_table[cluster] + m_table[cluster + 1]]
+                       = gsl::narrow<uint32_t>(lightIndex);
+                     ++m_table[cluster + 1];
+                   });
+  }
+
+  m_lightsBuffer->setData(m_lights, gl::api::BufferUsage::StreamDraw);
+  m_clusterBuffer->setData(m_table, gl::api::BufferUsage::StreamDraw);
+}
+} // namespace engine
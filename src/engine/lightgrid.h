@@ -0,0 +1,74 @@
+#pragma once
+
+#include "lighting.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <gl/buffer.h>
+#include <glm/vec3.hpp>
+#include <gslu.h>
+#include <vector>
+
+namespace render::scene
+{
+class Camera;
+}
+
+namespace engine::world
+{
+struct Room;
+}
+
+namespace engine
+{
+/**
+ * Assigns the lights around the visible rooms to the clusters of the camera's view frustum, so that each fragment only
+ * evaluates the lights that can reach it. The frustum is split into screen tiles and exponentially growing depth
+ * slices.
+ *
+ * The cluster table is a single buffer, laid out as expected by @c b_lightGrid in lighting.glsl: a flag whether the
+ * grid is enabled, one (offset, count) pair into the light indices per cluster, and the light indices themselves.
+ * With the grid disabled, fragments evaluate all bound lights instead.
+ */
+class LightGrid final
+{
+public:
+  // must match lighting.glsl
+  static constexpr uint32_t TilesX = 16;
+  static constexpr uint32_t TilesY = 9;
+  static constexpr uint32_t Slices = 24;
+  static constexpr size_t ClusterCount = size_t{TilesX} * TilesY * Slices;
+  //! Table header size, in 32 bit words.
+  static constexpr size_t HeaderSize = 2;
+
+  LightGrid();
+
+  /**
+   * Rebuilds the grid from the lights of all visible rooms, and of the rooms up to @a collectionDepth portals away
+   * from them. A light only reaches the rooms up to @a collectionDepth portals away from its own room.
+   */
+  void update(const std::vector<world::Room>& rooms, const render::scene::Camera& camera, size_t collectionDepth);
+
+  //! The lights of the current frame, indexed by the cluster table.
+  [[nodiscard]] static gslu::nn_shared<gl::ShaderStorageBuffer<ShaderLight>> getLightsBuffer();
+  //! The cluster table of the current frame.
+  [[nodiscard]] static gslu::nn_shared<gl::ShaderStorageBuffer<uint32_t>> getClusterBuffer();
+  //! A cluster table with the grid disabled, for nodes with their own light list.
+  [[nodiscard]] static gslu::nn_shared<gl::ShaderStorageBuffer<uint32_t>> getDisabledBuffer();
+
+private:
+  struct ClusterRange
+  {
+    glm::uvec3 min;
+    glm::uvec3 max;
+  };
+
+  const gslu::nn_shared<gl::ShaderStorageBuffer<ShaderLight>> m_lightsBuffer;
+  const gslu::nn_shared<gl::ShaderStorageBuffer<uint32_t>> m_clusterBuffer;
+
+  std::vector<ShaderLight> m_lights;
+  std::vector<ClusterRange> m_ranges;
+  std::vector<uint32_t> m_table;
+  std::vector<bool> m_seenRooms;
+};
+} // namespace engine
@@ -1,6 +1,7 @@
 #include "lighting.h"
 
 #include "engine/world/room.h"
+#include "lightgrid.h"
 #include "render/scene/node.h"
 
 #include <gl/api/gl.hpp>
@@ -13,16 +14,33 @@ class Mesh;
 
 namespace engine
 {
+Lighting::Lighting()
+    : m_gridBuffer{LightGrid::getDisabledBuffer()}
+{
+}
+
 void Lighting::update(const core::Shade& shade, const world::Room& baseRoom)
 {
-  if(shade.get() >= 0)
+  // rooms are swapped with their alternates in place, so compare the actual inputs instead of the room's address
+  const bool hasFixedShade = shade.get() >= 0;
+  const auto& targetShade = hasFixedShade ? shade : baseRoom.ambientShade;
+  if(m_ambientConverged && m_hasFixedShade == hasFixedShade && m_targetShade == targetShade)
+    return;
+
+  m_hasFixedShade = hasFixedShade;
+  m_targetShade = targetShade;
+
+  if(hasFixedShade)
   {
     fadeAmbient(shade);
     m_buffer = ShaderLight::getEmptyBuffer();
+    m_gridBuffer = LightGrid::getDisabledBuffer();
     return;
   }
 
-  m_buffer = baseRoom.lightsBuffer;
+  // the light grid holds the lights around all visible rooms, and is rebuilt every frame
+  m_buffer = LightGrid::getLightsBuffer();
+  m_gridBuffer = LightGrid::getClusterBuffer();
   fadeAmbient(baseRoom.ambientShade);
 }
 
@@ -40,5 +58,12 @@ void Lighting::bind(render::scene::Node& node) const
     {
       shaderStorageBlock.bind(*m_buffer);
     });
+
+  node.bind(
+    "b_lightGrid",
+    [this](const render::scene::Node*, const render::scene::Mesh& /*mesh*/, gl::ShaderStorageBlock& shaderStorageBlock)
+    {
+      shaderStorageBlock.bind(*m_gridBuffer);
+    });
 }
 } // namespace engine
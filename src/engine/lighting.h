@@ -3,12 +3,14 @@
 #include "core/units.h"
 #include "qs/qs.h"
 
+#include <cstdint>
 #include <gl/buffer.h>
 #include <glm/vec4.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
 #include <limits>
 #include <memory>
+#include <optional>
 
 namespace render::scene
 {
@@ -57,22 +59,39 @@ struct Lighting
 {
   core::Brightness ambient{-1.0f};
 
-  Lighting() = default;
+  Lighting();
 
   void update(const core::Shade& shade, const world::Room& baseRoom);
 
   void bind(render::scene::Node& node) const;
 
+  [[nodiscard]] const auto& getBuffer() const
+  {
+    return m_buffer;
+  }
+
+  [[nodiscard]] const auto& getGridBuffer() const
+  {
+    return m_gridBuffer;
+  }
+
 private:
   void fadeAmbient(const core::Shade& shade)
   {
     const auto targetAmbient = toBrightness(shade);
+    const auto previousAmbient = ambient;
     if(ambient.get() < 0)
       ambient = targetAmbient;
     else
       ambient += (targetAmbient - ambient) / 50.0f;
+    // once the step is below float precision, further updates cannot change anything anymore
+    m_ambientConverged = ambient == previousAmbient;
   }
 
   gslu::nn_shared<gl::ShaderStorageBuffer<ShaderLight>> m_buffer{ShaderLight::getEmptyBuffer()};
+  gslu::nn_shared<gl::ShaderStorageBuffer<uint32_t>> m_gridBuffer;
+  std::optional<bool> m_hasFixedShade{};
+  std::optional<core::Shade> m_targetShade{};
+  bool m_ambientConverged = false;
 };
 } // namespace engine
@@ -52,6 +52,7 @@ void ObjectManager::createObjects(world::World& world, std::vector<loader::file:
       continue;
 
     m_objects.emplace(gsl::narrow<ObjectId>(idItem.index()), object);
+    m_objectIds.emplace(object.get(), gsl::narrow<ObjectId>(idItem.index()));
     if(object->isActive())
     {
       object->activate();
@@ -68,27 +69,21 @@ void ObjectManager::applyScheduledDeletions()
   {
     deactivate(del);
 
-    if(auto it = std::find_if(m_dynamicObjects.begin(),
-                              m_dynamicObjects.end(),
-                              [del](const std::shared_ptr<objects::Object>& i)
-                              {
-                                return i.get() == del;
-                              });
-       it != m_dynamicObjects.end())
+    if(const auto it = m_dynamicObjectIndices.find(del); it != m_dynamicObjectIndices.end())
     {
-      m_dynamicObjects.erase(it);
+      // keep the registration order, so that iterating over the dynamic objects stays deterministic
+      const auto index = it->second;
+      m_dynamicObjectIndices.erase(it);
+      m_dynamicObjects.erase(std::next(m_dynamicObjects.begin(), index));
+      for(auto i = index; i < m_dynamicObjects.size(); ++i)
+        m_dynamicObjectIndices[m_dynamicObjects[i].get().get()] = i;
       continue;
     }
 
-    if(auto it = std::find_if(m_objects.begin(),
-                              m_objects.end(),
-                              [del](const std::pair<uint16_t, gslu::nn_shared<objects::Object>>& i)
-                              {
-                                return i.second.get().get() == del;
-                              });
-       it != m_objects.end())
+    if(const auto it = m_objectIds.find(del); it != m_objectIds.end())
     {
-      m_objects.erase(it);
+      m_objects.erase(it->second);
+      m_objectIds.erase(it);
       continue;
     }
   }
@@ -101,6 +96,7 @@ void ObjectManager::registerObject(const gslu::nn_shared<objects::Object>& objec
   if(m_objectCounter == std::numeric_limits<ObjectId>::max())
     BOOST_THROW_EXCEPTION(std::runtime_error("Artificial object counter exceeded"));
 
+  m_objectIds.emplace(object.get().get(), m_objectCounter);
   m_objects.emplace(m_objectCounter++, object);
 }
 
@@ -109,31 +105,26 @@ std::shared_ptr<objects::Object> ObjectManager::find(const objects::Object* obje
   if(object == nullptr)
     return nullptr;
 
-  auto it = std::find_if(m_objects.begin(),
-                         m_objects.end(),
-                         [object](const std::pair<uint16_t, gslu::nn_shared<objects::Object>>& x)
-                         {
-                           return x.second.get().get() == object;
-                         });
-
-  if(it != m_objects.end())
-    return it->second;
+  if(const auto it = m_objectIds.find(object); it != m_objectIds.end())
+    return m_objects.at(it->second);
 
   if(includeDynamicObjects)
   {
-    auto it2 = std::find_if(m_dynamicObjects.begin(),
-                            m_dynamicObjects.end(),
-                            [object](const auto& x)
-                            {
-                              return x.get().get() == object;
-                            });
-    if(it2 != m_dynamicObjects.end())
-      return *it2;
+    if(const auto it = m_dynamicObjectIndices.find(object); it != m_dynamicObjectIndices.end())
+      return m_dynamicObjects[it->second];
   }
 
   return nullptr;
 }
 
+std::optional<ObjectId> ObjectManager::findId(const objects::Object* object) const
+{
+  if(const auto it = m_objectIds.find(object); it != m_objectIds.end())
+    return it->second;
+
+  return std::nullopt;
+}
+
 std::shared_ptr<objects::Object> ObjectManager::getObject(ObjectId id) const
 {
   const auto it = m_objects.find(id);
@@ -145,39 +136,60 @@ std::shared_ptr<objects::Object> ObjectManager::getObject(ObjectId id) const
 
 void ObjectManager::update(world::World& world, bool godMode)
 {
-  for(const auto& object : m_dynamicObjects)
+  // lighting only needs to be kept up to date for objects that are drawn; it catches up on room changes itself
+  const auto updateVisibilityAndLighting = [](const gslu::nn_shared<objects::Object>& object)
   {
-    object->getNode()->setVisible(object->m_state.triggerState != objects::TriggerState::Invisible);
-    object->updateLighting();
-  }
+    const bool visible = object->m_state.triggerState != objects::TriggerState::Invisible;
+    object->getNode()->setVisible(visible);
+    if(visible)
+      object->updateLighting();
+  };
+
+  for(const auto& object : m_dynamicObjects)
+    updateVisibilityAndLighting(object);
 
   for(const auto& object : m_objects | boost::adaptors::map_values)
-  {
-    object->getNode()->setVisible(object->m_state.triggerState != objects::TriggerState::Invisible);
-    object->updateLighting();
-  }
+    updateVisibilityAndLighting(object);
 
-  const auto activeObjects = m_activeObjects; // need to work on a copy because update() may modify the collection
-  for(const auto& object : activeObjects)
+  // update() may (de-)activate objects; these changes are deferred until all currently active objects are updated
+  m_updatingActiveObjects = true;
+  for(auto i = m_activeObjects.size(); i > 0; --i)
   {
-    if(object.get() == m_lara) // Lara is special and needs to be updated last
+    const auto object = m_activeObjects[i - 1];
+    if(object == m_lara.get()) // Lara is special and needs to be updated last
       continue;
     object->update();
   }
+  m_updatingActiveObjects = false;
 
-  auto currentParticles = std::move(m_particles);
-  for(const auto& particle : currentParticles)
+  for(const auto& [activate, object] : m_deferredActivations)
+  {
+    if(activate)
+      activateImmediately(object);
+    else
+      deactivateImmediately(object);
+  }
+  m_deferredActivations.clear();
+
+  // particles may register new particles while being updated, so they must go to m_particles
+  std::swap(m_particles, m_updatingParticles);
+  for(auto& particle : m_updatingParticles)
   {
     if(particle->update(world))
     {
       setParent(particle, particle->location.room->node);
-      m_particles.emplace_back(particle);
+      // sprite particles are drawn through their room's instanced batches instead of their own node
+      particle->setVisible(!m_particleBatcher.add(*particle));
+      m_particles.emplace_back(std::move(particle));
     }
     else
     {
       setParent(particle, nullptr);
     }
   }
+  m_updatingParticles.clear();
+  m_particlePool.update(world, m_particleBatcher);
+  m_particleBatcher.flush();
 
   if(m_lara != nullptr)
   {
@@ -198,38 +210,38 @@ void ObjectManager::serialize(const serialization::Serializer<world::World>& ser
 
   if(ser.loading)
   {
+    m_objectIds.clear();
+    for(const auto& [id, obj] : m_objects)
+      m_objectIds.emplace(obj.get().get(), id);
+
+    // the active objects are not owned by the list, so entries referring to the replaced objects must not survive
+    m_activeObjects.clear();
+    m_deferredActivations.clear();
     const auto activeObjectsNode = ser.node["activeObjects"];
     if(activeObjectsNode.is_seed() || !activeObjectsNode.valid() || activeObjectsNode.type() == ryml::NOTYPE)
     {
       for(const auto& obj : m_objects | boost::adaptors::map_values)
         if(obj->isActive())
-          m_activeObjects.push_front(obj);
+          m_activeObjects.emplace_back(obj.get().get());
     }
     else
     {
       std::vector<ObjectId> activeObjectIds;
       ser(S_NV("activeObjects", activeObjectIds));
-      m_activeObjects.clear();
-      for(const auto id : activeObjectIds)
+      for(auto it = activeObjectIds.rbegin(); it != activeObjectIds.rend(); ++it)
       {
-        m_activeObjects.emplace_back(m_objects.at(id));
+        m_activeObjects.emplace_back(m_objects.at(*it).get().get());
       }
     }
   }
   else
   {
     std::vector<ObjectId> activeObjectIds;
-    for(const auto& obj : m_activeObjects)
+    for(auto it = m_activeObjects.rbegin(); it != m_activeObjects.rend(); ++it)
     {
-      auto it = std::find_if(m_objects.begin(),
-                             m_objects.end(),
-                             [obj](const auto& i)
-                             {
-                               return i.second.get() == obj;
-                             });
-      if(it != m_objects.end())
+      if(const auto id = findId(*it); id.has_value())
       {
-        activeObjectIds.emplace_back(it->first);
+        activeObjectIds.emplace_back(*id);
       }
     }
     ser(S_NV("activeObjects", activeObjectIds));
@@ -270,30 +282,39 @@ void ObjectManager::replaceItems(const TR1ItemId& oldId, const TR1ItemId& newId,
 
 void ObjectManager::deactivate(const engine::objects::Object* object)
 {
-  if(auto it = std::find_if(m_activeObjects.begin(),
-                            m_activeObjects.end(),
-                            [object](const auto& i)
-                            {
-                              return i.get().get() == object;
-                            });
-     it != m_activeObjects.end())
+  if(m_updatingActiveObjects)
+    m_deferredActivations.emplace_back(false, object);
+  else
+    deactivateImmediately(object);
+}
+
+void ObjectManager::activate(const engine::objects::Object* object)
+{
+  if(m_updatingActiveObjects)
+    m_deferredActivations.emplace_back(true, object);
+  else
+    activateImmediately(object);
+}
+
+void ObjectManager::deactivateImmediately(const engine::objects::Object* object)
+{
+  if(const auto it = std::find(m_activeObjects.begin(), m_activeObjects.end(), object); it != m_activeObjects.end())
   {
     m_activeObjects.erase(it);
   }
 }
 
-void ObjectManager::activate(const engine::objects::Object* object)
+void ObjectManager::activateImmediately(const engine::objects::Object* object)
 {
   const auto ob = find(object, true);
   if(ob == nullptr)
   {
     return;
   }
-  
-  const auto it = std::find(m_activeObjects.begin(), m_activeObjects.end(), gsl::not_null{ob});
-  if(it == m_activeObjects.end())
+
+  if(std::find(m_activeObjects.begin(), m_activeObjects.end(), ob.get()) == m_activeObjects.end())
   {
-    m_activeObjects.emplace_front(gsl::not_null{ob});
+    m_activeObjects.emplace_back(ob.get());
   }
 }
 } // namespace engine
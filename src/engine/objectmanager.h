@@ -1,14 +1,17 @@
 #pragma once
 
+#include "particlebatcher.h"
+#include "particlepool.h"
 #include "serialization/serialization_fwd.h"
 
 #include <cstdint>
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
-#include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -40,11 +43,24 @@ class ObjectManager
   std::set<objects::Object*> m_scheduledDeletions;
   ObjectId m_objectCounter = 0;
   std::map<ObjectId, gslu::nn_shared<objects::Object>> m_objects;
-  std::list<gslu::nn_shared<objects::Object>> m_activeObjects;
-  std::set<gslu::nn_shared<objects::Object>> m_dynamicObjects;
+  std::unordered_map<const objects::Object*, ObjectId> m_objectIds;
+  //! Objects are owned by m_objects or m_dynamicObjects; the most recently activated object is at the back.
+  std::vector<objects::Object*> m_activeObjects;
+  //! (De-)activations requested while updating the active objects, applied in order after the update.
+  std::vector<std::pair<bool, const objects::Object*>> m_deferredActivations;
+  bool m_updatingActiveObjects = false;
+  std::vector<gslu::nn_shared<objects::Object>> m_dynamicObjects;
+  std::unordered_map<const objects::Object*, size_t> m_dynamicObjectIndices;
   std::vector<gslu::nn_shared<Particle>> m_particles;
+  //! Holds the particles being updated; kept as a member so that its capacity is reused across frames.
+  std::vector<gslu::nn_shared<Particle>> m_updatingParticles;
+  ParticlePool m_particlePool;
+  ParticleBatcher m_particleBatcher;
   std::shared_ptr<objects::LaraObject> m_lara = nullptr;
 
+  void activateImmediately(const objects::Object* object);
+  void deactivateImmediately(const objects::Object* object);
+
 public:
   auto& getObjects()
   {
@@ -85,7 +101,8 @@ public:
 
   void registerDynamicObject(const gslu::nn_shared<objects::Object>& object)
   {
-    m_dynamicObjects.emplace(object);
+    if(m_dynamicObjectIndices.emplace(object.get().get(), m_dynamicObjects.size()).second)
+      m_dynamicObjects.emplace_back(object);
   }
 
   [[nodiscard]] auto getDynamicObjectCount() const
@@ -108,11 +125,17 @@ public:
     return m_particles;
   }
 
+  [[nodiscard]] auto& getParticlePool()
+  {
+    return m_particlePool;
+  }
+
   void eraseParticle(const std::shared_ptr<Particle>& particle);
 
   void applyScheduledDeletions();
   void registerObject(const gslu::nn_shared<objects::Object>& object);
   std::shared_ptr<objects::Object> find(const objects::Object* object, bool includeDynamicObjects = false) const;
+  [[nodiscard]] std::optional<ObjectId> findId(const objects::Object* object) const;
   void createObjects(world::World& world, std::vector<loader::file::Item>& items);
   [[nodiscard]] std::shared_ptr<objects::Object> getObject(ObjectId id) const;
   [[nodiscard]] auto getObjectCounter() const
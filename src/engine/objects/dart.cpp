@@ -36,8 +36,7 @@ void Dart::update()
     getWorld().getObjectManager().getLara().m_state.health -= 50_hp;
     getWorld().getObjectManager().getLara().m_state.is_hit = true;
 
-    auto fx = createBloodSplat(getWorld(), m_state.location, m_state.speed, m_state.rotation.Y);
-    getWorld().getObjectManager().registerParticle(fx);
+    createBloodSplat(getWorld(), m_state.location, m_state.speed, m_state.rotation.Y);
   }
 
   const auto oldLocation = m_state.location;
@@ -58,10 +57,6 @@ void Dart::update()
   const auto [success, ricochetPos]
     = raycastLineOfSight(oldLocation, m_state.location.position, getWorld().getObjectManager());
 
-  auto particle = gsl::make_shared<RicochetParticle>(ricochetPos, getWorld());
-  setParent(particle, ricochetPos.room->node);
-  particle->angle = m_state.rotation;
-  particle->timePerSpriteFrame = 6;
-  getWorld().getObjectManager().registerParticle(std::move(particle));
+  getWorld().getObjectManager().getParticlePool().spawnRicochet(getWorld(), ricochetPos, m_state.rotation, 6);
 }
 } // namespace engine::objects
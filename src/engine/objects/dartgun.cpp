@@ -9,7 +9,7 @@
 #include "engine/items_tr1.h"
 #include "engine/location.h"
 #include "engine/objectmanager.h"
-#include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/skeletalmodelnode.h"
 #include "engine/soundeffects_tr1.h"
 #include "engine/world/room.h"
@@ -72,9 +72,7 @@ void engine::objects::DartGun::update()
   auto& dartState = dart->m_state;
   dartState.triggerState = TriggerState::Active;
 
-  auto particle = gsl::make_shared<SmokeParticle>(dartState.location, getWorld(), dartState.rotation);
-  setParent(particle, dartState.location.room->node);
-  getWorld().getObjectManager().registerParticle(std::move(particle));
+  getWorld().getObjectManager().getParticlePool().spawnSmoke(getWorld(), dartState.location, dartState.rotation);
 
   playSoundEffect(TR1SoundEffect::DartgunShoot);
   ModelObject::update();
@@ -40,12 +40,15 @@
 #include "weapon.h"
 
 #include <boost/assert.hpp>
+#include <boost/container/flat_set.hpp>
+#include <boost/container/small_vector.hpp>
 #include <boost/log/trivial.hpp>
 #include <boost/range/adaptor/map.hpp>
 #include <boost/throw_exception.hpp>
 #include <cstddef>
 #include <cstdlib>
 #include <exception>
+#include <functional>
 #include <gl/api/gl.hpp>
 #include <gl/program.h>
 #include <gl/renderstate.h>
@@ -56,7 +59,6 @@
 #include <iosfwd>
 #include <limits>
 #include <map>
-#include <set>
 #include <stack>
 #include <stdexcept>
 #include <type_traits>
@@ -383,9 +385,7 @@ void LaraObject::update()
         surfaceLocation.position.Y = *waterSurfaceHeight;
         surfaceLocation.position.Z = m_state.location.position.Z;
 
-        auto particle = gsl::make_shared<SplashParticle>(surfaceLocation, getWorld(), false);
-        setParent(particle, surfaceLocation.room->node);
-        getWorld().getObjectManager().registerParticle(particle);
+        getWorld().getObjectManager().getParticlePool().spawnSplash(getWorld(), surfaceLocation, false);
       }
     }
   }
@@ -441,9 +441,8 @@ void LaraObject::update()
     auto bubbleCount = util::rand15(2);
     while(bubbleCount-- > 0)
     {
-      auto particle = gsl::make_shared<BubbleParticle>(Location{m_state.location.room, position}, getWorld(), false);
-      setParent(particle, m_state.location.room->node);
-      getWorld().getObjectManager().registerParticle(particle);
+      getWorld().getObjectManager().getParticlePool().spawnBubble(
+        getWorld(), Location{m_state.location.room, position}, false);
     }
   }
 
@@ -592,7 +591,12 @@ void LaraObject::testInteractions(CollisionInfo& collisionInfo)
   if(isDead())
     return;
 
-  std::set<gsl::not_null<const world::Room*>> rooms;
+  // rooms rarely have more than a handful of portals, so keep this off the heap
+  boost::container::flat_set<gsl::not_null<const world::Room*>,
+                             std::less<>,
+                             boost::container::small_vector<gsl::not_null<const world::Room*>, 16>>
+    rooms;
+  rooms.reserve(m_state.location.room->portals.size() + 1);
   rooms.insert(m_state.location.room);
   for(const world::Portal& p : m_state.location.room->portals)
     rooms.insert(p.adjoiningRoom);
@@ -1317,9 +1321,8 @@ void LaraObject::hitTarget(ModelObject& object, const core::TRVec& hitPos, const
   }
   object.m_state.is_hit = true;
   object.m_state.health -= damage;
-  auto fx = createBloodSplat(
+  createBloodSplat(
     getWorld(), Location{object.m_state.location.room, hitPos}, object.m_state.speed, object.m_state.rotation.Y);
-  getWorld().getObjectManager().registerParticle(fx);
   if(object.m_state.isDead())
     return;
 
@@ -1879,7 +1882,7 @@ void LaraObject::serialize(const serialization::Serializer<world::World>& ser)
 
   if(ser.loading)
   {
-    forceSourcePosition = nullptr;
+    forceSourcePosition.reset();
     getSkeleton()->getRenderState().setScissorTest(false);
   }
 }
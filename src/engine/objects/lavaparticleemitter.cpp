@@ -2,7 +2,7 @@
 
 #include "engine/location.h"
 #include "engine/objectmanager.h"
-#include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/soundeffects_tr1.h"
 #include "engine/world/room.h"
 #include "engine/world/world.h"
@@ -16,9 +16,7 @@ namespace engine::objects
 {
 void LavaParticleEmitter::update()
 {
-  auto particle = gsl::make_shared<LavaParticle>(m_state.location, getWorld());
-  setParent(particle, m_state.location.room->node);
-  getWorld().getObjectManager().registerParticle(particle);
+  getWorld().getObjectManager().getParticlePool().spawnLava(getWorld(), m_state.location);
 
   playSoundEffect(TR1SoundEffect::ChoppyWater);
 }
@@ -331,6 +331,25 @@ gslu::nn_shared<Particle> ModelObject::emitParticle(
   gslu::nn_shared<Particle> (*generate)(world::World& world, const Location&, const core::Speed&, const core::Angle&))
 {
   BOOST_ASSERT(generate != nullptr);
+
+  auto particle = generate(getWorld(), getBoneLocation(localPosition, boneIndex), m_state.speed, m_state.rotation.Y);
+  getWorld().getObjectManager().registerParticle(particle);
+
+  return particle;
+}
+
+void ModelObject::emitParticle(
+  const core::TRVec& localPosition,
+  const size_t boneIndex,
+  void (*generate)(world::World& world, const Location&, const core::Speed&, const core::Angle&))
+{
+  BOOST_ASSERT(generate != nullptr);
+
+  generate(getWorld(), getBoneLocation(localPosition, boneIndex), m_state.speed, m_state.rotation.Y);
+}
+
+Location ModelObject::getBoneLocation(const core::TRVec& localPosition, const size_t boneIndex) const
+{
   BOOST_ASSERT(boneIndex < m_skeleton->getBoneCount());
 
   const auto boneSpheres = m_skeleton->getBoneCollisionSpheres();
@@ -338,10 +357,7 @@ gslu::nn_shared<Particle> ModelObject::emitParticle(
 
   auto location = m_state.location;
   location.position = core::TRVec{boneSpheres.at(boneIndex).relative(localPosition.toRenderSystem())};
-  auto particle = generate(getWorld(), location, m_state.speed, m_state.rotation.Y);
-  getWorld().getObjectManager().registerParticle(particle);
-
-  return particle;
+  return location;
 }
 
 void ModelObject::updateLighting()
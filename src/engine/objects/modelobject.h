@@ -114,6 +114,13 @@ public:
                                                                                const Location& location,
                                                                                const core::Speed& speed,
                                                                                const core::Angle& angle));
+  //! For particles kept in the particle pool.
+  void emitParticle(const core::TRVec& localPosition,
+                    size_t boneIndex,
+                    void (*generate)(world::World& world,
+                                     const Location& location,
+                                     const core::Speed& speed,
+                                     const core::Angle& angle));
 
   void updateLighting() override;
 
@@ -128,6 +135,9 @@ public:
 protected:
   std::shared_ptr<SkeletalModelNode> m_skeleton;
   Lighting m_lighting;
+
+private:
+  [[nodiscard]] Location getBoneLocation(const core::TRVec& localPosition, size_t boneIndex) const;
 };
 
 #define MODELOBJECT_DEFAULT_CONSTRUCTORS(CLASS, HAS_UPDATE_FUNCTION, SHADOW_CASTER)             \
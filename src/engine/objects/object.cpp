@@ -4,7 +4,7 @@
 #include "engine/engine.h"
 #include "engine/floordata/floordata.h"
 #include "engine/objectmanager.h"
-#include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/presenter.h"
 #include "engine/script/scriptengine.h"
 #include "engine/soundeffects_tr1.h"
@@ -164,10 +164,8 @@ bool InteractionLimits::canInteract(const ObjectState& objectState, const Object
 
 void Object::emitRicochet(const Location& location)
 {
-  const auto particle = gsl::make_shared<RicochetParticle>(location, getWorld());
-  setParent(particle, m_state.location.room->node);
-  getWorld().getObjectManager().registerParticle(particle);
-  getWorld().getAudioEngine().playSoundEffect(TR1SoundEffect::Ricochet, gsl::not_null{particle.get().get()});
+  getWorld().getObjectManager().getParticlePool().spawnRicochet(getWorld(), location, core::TRRotation{}, 4);
+  getWorld().getAudioEngine().playSoundEffect(TR1SoundEffect::Ricochet, location.position.toRenderSystem());
 }
 
 std::optional<core::Length> Object::getWaterSurfaceHeight() const
@@ -135,11 +135,10 @@ void RollingBall::collide(CollisionInfo& collisionInfo)
     {
       const auto tmp = lara.m_state.location.position
                        + core::TRVec{util::rand15s(128_len), -util::rand15s(512_len), util::rand15s(128_len)};
-      auto fx = createBloodSplat(getWorld(),
-                                 Location{m_state.location.room, tmp},
-                                 2 * m_state.speed,
-                                 util::rand15s(22.5_deg) + m_state.rotation.Y);
-      getWorld().getObjectManager().registerParticle(fx);
+      createBloodSplat(getWorld(),
+                       Location{m_state.location.room, tmp},
+                       2 * m_state.speed,
+                       util::rand15s(22.5_deg) + m_state.rotation.Y);
     }
     return;
   }
@@ -155,7 +154,7 @@ void RollingBall::collide(CollisionInfo& collisionInfo)
   const auto z = lara.m_state.location.position.Z - m_state.location.position.Z;
   const auto xyz = std::max(1_sectors / 2, sqrt(util::square(x) + util::square(y) + util::square(z)));
 
-  auto fx = createBloodSplat(
+  createBloodSplat(
     getWorld(),
     Location{m_state.location.room,
              core::TRVec{x * 1_sectors / 2 / xyz + m_state.location.position.X,
@@ -163,7 +162,6 @@ void RollingBall::collide(CollisionInfo& collisionInfo)
                          z * 1_sectors / 2 / xyz + m_state.location.position.Z}},
     m_state.speed,
     m_state.rotation.Y);
-  getWorld().getObjectManager().registerParticle(fx);
 }
 
 RollingBall::RollingBall(const std::string& name,
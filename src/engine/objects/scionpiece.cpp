@@ -14,7 +14,7 @@
 #include "engine/location.h"
 #include "engine/objectmanager.h"
 #include "engine/objects/spriteobject.h"
-#include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/player.h"
 #include "engine/presenter.h"
 #include "engine/skeletalmodelnode.h"
@@ -124,11 +124,9 @@ void ScionPiece3::update()
   {
     const auto pos = m_state.location.position
                      + core::TRVec{util::rand15s(512_len), util::rand15s(64_len) - 500_len, util::rand15s(512_len)};
-    const auto particle = gsl::make_shared<ExplosionParticle>(
-      Location{m_state.location.room, pos}, getWorld(), 0_spd, core::TRRotation{});
-    setParent(particle, m_state.location.room->node);
-    getWorld().getObjectManager().registerParticle(particle);
-    getWorld().getAudioEngine().playSoundEffect(TR1SoundEffect::Explosion2, gsl::not_null{particle.get().get()});
+    getWorld().getObjectManager().getParticlePool().spawnExplosion(
+      getWorld(), Location{m_state.location.room, pos}, 0_spd, core::TRRotation{});
+    getWorld().getAudioEngine().playSoundEffect(TR1SoundEffect::Explosion2, pos.toRenderSystem());
 
     getWorld().getCameraController().setBounce(-200_len);
   }
@@ -1,6 +1,7 @@
 #include "spriteobject.h"
 
 #include "core/id.h"
+#include "engine/lightgrid.h"
 #include "engine/world/room.h"
 #include "engine/world/sprite.h"
 #include "engine/world/world.h"
@@ -71,6 +72,10 @@ void SpriteObject::createModel()
   Expects(m_sprite != nullptr);
 
   m_displayNode->setRenderable(m_billboard ? m_sprite->billboardMesh : m_sprite->yBoundMesh);
+  {
+    const auto radius = m_sprite->getRadius();
+    m_displayNode->setLocalBounds(render::scene::BoundingBox{glm::vec3{-radius}, glm::vec3{radius}});
+  }
   m_displayNode->bind("u_lightAmbient",
                       [brightness = m_brightness](
                         const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
@@ -84,6 +89,13 @@ void SpriteObject::createModel()
     {
       shaderStorageBlock.bind(*emptyBuffer);
     });
+  m_displayNode->bind(
+    "b_lightGrid",
+    [disabledBuffer = LightGrid::getDisabledBuffer()](
+      const render::scene::Node*, const render::scene::Mesh& /*mesh*/, gl::ShaderStorageBlock& shaderStorageBlock)
+    {
+      shaderStorageBlock.bind(*disabledBuffer);
+    });
 
   if(m_sprite->render1.y > 0)
   {
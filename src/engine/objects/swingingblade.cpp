@@ -47,11 +47,10 @@ void SwingingBlade::update()
       getWorld().getObjectManager().getLara().m_state.location.position.X + util::rand15s(128_len),
       getWorld().getObjectManager().getLara().m_state.location.position.Y - util::rand15(745_len),
       getWorld().getObjectManager().getLara().m_state.location.position.Z + util::rand15s(128_len)};
-    auto fx = createBloodSplat(getWorld(),
-                               Location{m_state.location.room, splatPos},
-                               getWorld().getObjectManager().getLara().m_state.speed,
-                               getWorld().getObjectManager().getLara().m_state.rotation.Y + util::rand15s(+22_deg));
-    getWorld().getObjectManager().registerParticle(fx);
+    createBloodSplat(getWorld(),
+                     Location{m_state.location.room, splatPos},
+                     getWorld().getObjectManager().getLara().m_state.speed,
+                     getWorld().getObjectManager().getLara().m_state.rotation.Y + util::rand15s(+22_deg));
   }
 
   const auto sector = m_state.location.updateRoom();
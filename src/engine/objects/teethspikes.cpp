@@ -45,14 +45,13 @@ void engine::objects::TeethSpikes::collide(CollisionInfo& collisionInfo)
     getWorld().getObjectManager().getLara().m_state.health -= 15_hp;
     while(bloodSplats-- > 0)
     {
-      auto fx = createBloodSplat(
+      createBloodSplat(
         getWorld(),
         Location{getWorld().getObjectManager().getLara().m_state.location.room,
                  getWorld().getObjectManager().getLara().m_state.location.position
                    + core::TRVec{util::rand15s(128_len), -util::rand15(512_len), util::rand15s(128_len)}},
         20_spd,
         util::rand15(+180_deg));
-      getWorld().getObjectManager().registerParticle(fx);
     }
     if(getWorld().getObjectManager().getLara().isDead())
     {
@@ -12,6 +12,7 @@
 #include "objectmanager.h"
 #include "objects/laraobject.h"
 #include "objects/objectstate.h"
+#include "particlepool.h"
 #include "presenter.h"
 #include "render/scene/mesh.h" // IWYU pragma: keep
 #include "skeletalmodelnode.h"
@@ -22,6 +23,7 @@
 #include "world/sprite.h"
 #include "world/world.h"
 
+#include <algorithm>
 #include <boost/assert.hpp>
 #include <boost/log/trivial.hpp>
 #include <gl/renderstate.h>
@@ -53,10 +55,15 @@ void Particle::initRenderables(world::World& world, bool billboard)
   }
   else if(const auto& spriteSequence = world.findSpriteSequenceForType(object_number))
   {
+    float radius = 0;
     for(const world::Sprite& spr : spriteSequence->sprites)
     {
       m_renderables.emplace_back(billboard ? spr.billboardMesh : spr.yBoundMesh);
+      m_instancedRenderables.emplace_back(billboard ? spr.instancedBillboardMesh : spr.instancedYBoundMesh);
+      radius = std::max(radius, spr.getRadius());
     }
+    // particles cycle through their sprites, so the bounds must cover all of them
+    setLocalBounds(render::scene::BoundingBox{glm::vec3{-radius}, glm::vec3{radius}});
   }
   else
   {
@@ -131,77 +138,6 @@ void Particle::applyTransform()
   setLocalMatrix(translate(glm::mat4{1.0f}, tr) * angle.toMatrix());
 }
 
-bool BloodSplatterParticle::update(world::World& world)
-{
-  location.position += util::pitch(speed * 1_frame, angle.Y);
-  ++timePerSpriteFrame;
-  if(timePerSpriteFrame != 4)
-  {
-    applyTransform();
-    return true;
-  }
-
-  timePerSpriteFrame = 0;
-  nextFrame();
-  if(gsl::narrow<size_t>(-negSpriteFrameId) >= world.findSpriteSequenceForType(object_number)->sprites.size())
-    return false;
-
-  applyTransform();
-  return true;
-}
-
-bool SplashParticle::update(world::World& world)
-{
-  nextFrame();
-
-  if(gsl::narrow<size_t>(-negSpriteFrameId) >= world.findSpriteSequenceForType(object_number)->sprites.size())
-  {
-    return false;
-  }
-
-  location.position += util::pitch(speed * 1_frame, angle.Y);
-
-  applyTransform();
-  return true;
-}
-
-SplashParticle::SplashParticle(const Location& location, world::World& world, const bool waterfall)
-    : Particle{"splash", TR1ItemId::Splash, location, world, false}
-{
-  if(!waterfall)
-  {
-    speed = util::rand15(128_spd);
-    angle.Y = core::auToAngle(2 * util::rand15s());
-  }
-  else
-  {
-    this->location.position.X += util::rand15s(1_sectors);
-    this->location.position.Z += util::rand15s(1_sectors);
-  }
-  getRenderState().setScissorTest(false);
-}
-
-bool BubbleParticle::update(world::World& world)
-{
-  angle.X += 13_deg;
-  angle.Y += 9_deg;
-  location.position += util::pitch(11_len, angle.Y, -speed * 1_frame);
-  auto sector = location.updateRoom();
-  if(m_onlyInWater && !location.room->isWaterRoom)
-  {
-    return false;
-  }
-
-  if(const auto ceiling = HeightInfo::fromCeiling(sector, location.position, world.getObjectManager().getObjects()).y;
-     ceiling == core::InvalidHeight || location.position.Y <= ceiling)
-  {
-    return false;
-  }
-
-  applyTransform();
-  return true;
-}
-
 FlameParticle::FlameParticle(const Location& location, world::World& world, bool randomize)
     : Particle{"flame", TR1ItemId::Flame, location, world, false}
 {
@@ -331,7 +267,7 @@ bool MeshShrapnelParticle::update(world::World& world)
     lara.m_state.health -= m_damageRadius * 1_hp / 1_len;
     explode = true;
 
-    lara.forceSourcePosition = &location.position;
+    lara.forceSourcePosition = location.position;
     lara.explosionStumblingDuration = 5_frame;
   }
 
@@ -341,10 +277,8 @@ bool MeshShrapnelParticle::update(world::World& world)
   if(!explode)
     return true;
 
-  const auto particle = gsl::make_shared<ExplosionParticle>(location, world, fall_speed, angle);
-  setParent(particle, location.room->node);
-  world.getObjectManager().registerParticle(particle);
-  world.getAudioEngine().playSoundEffect(TR1SoundEffect::Explosion2, particle.get().get());
+  world.getObjectManager().getParticlePool().spawnExplosion(world, location, fall_speed, angle);
+  world.getAudioEngine().playSoundEffect(TR1SoundEffect::Explosion2, location.position.toRenderSystem());
   return false;
 }
 
@@ -386,21 +320,16 @@ bool MutantBulletParticle::update(world::World& world)
      || HeightInfo::fromCeiling(sector, location.position, world.getObjectManager().getObjects()).y
           >= location.position.Y)
   {
-    auto particle = gsl::make_shared<RicochetParticle>(location, world);
-    particle->timePerSpriteFrame = 6;
-    setParent(particle, location.room->node);
-    world.getObjectManager().registerParticle(particle);
-    world.getAudioEngine().playSoundEffect(TR1SoundEffect::Ricochet, particle.get().get());
+    world.getObjectManager().getParticlePool().spawnRicochet(world, location, core::TRRotation{}, 6);
+    world.getAudioEngine().playSoundEffect(TR1SoundEffect::Ricochet, location.position.toRenderSystem());
     return false;
   }
   else if(world.getObjectManager().getLara().isNearInexact(location.position, 200_len))
   {
     auto& laraState = world.getObjectManager().getLara().m_state;
     laraState.health -= 30_hp;
-    auto particle = gsl::make_shared<BloodSplatterParticle>(location, speed, angle.Y, world);
-    setParent(particle, location.room->node);
-    world.getObjectManager().registerParticle(particle);
-    world.getAudioEngine().playSoundEffect(TR1SoundEffect::BulletHitsLara, particle.get().get());
+    world.getObjectManager().getParticlePool().spawnBloodSplatter(world, location, speed, angle.Y);
+    world.getAudioEngine().playSoundEffect(TR1SoundEffect::BulletHitsLara, location.position.toRenderSystem());
     laraState.is_hit = true;
     angle.Y = laraState.rotation.Y;
     speed = laraState.speed;
@@ -422,10 +351,8 @@ bool MutantGrenadeParticle::update(world::World& world)
      || HeightInfo::fromCeiling(sector, location.position, world.getObjectManager().getObjects()).y
           >= location.position.Y)
   {
-    auto particle = gsl::make_shared<ExplosionParticle>(location, world, fall_speed, angle);
-    setParent(particle, location.room->node);
-    world.getObjectManager().registerParticle(particle);
-    world.getAudioEngine().playSoundEffect(TR1SoundEffect::Explosion2, particle.get().get());
+    world.getObjectManager().getParticlePool().spawnExplosion(world, location, fall_speed, angle);
+    world.getAudioEngine().playSoundEffect(TR1SoundEffect::Explosion2, location.position.toRenderSystem());
 
     const auto dd = location.position - world.getObjectManager().getLara().m_state.location.position;
     const auto d = util::square(dd.X) + util::square(dd.Y) + util::square(dd.Z);
@@ -441,15 +368,13 @@ bool MutantGrenadeParticle::update(world::World& world)
   else if(world.getObjectManager().getLara().isNearInexact(location.position, 200_len))
   {
     world.getObjectManager().getLara().m_state.health -= 100_hp;
-    auto particle = gsl::make_shared<ExplosionParticle>(location, world, fall_speed, angle);
-    setParent(particle, location.room->node);
-    world.getObjectManager().registerParticle(particle);
-    world.getAudioEngine().playSoundEffect(TR1SoundEffect::Explosion2, particle.get().get());
+    world.getObjectManager().getParticlePool().spawnExplosion(world, location, fall_speed, angle);
+    world.getAudioEngine().playSoundEffect(TR1SoundEffect::Explosion2, location.position.toRenderSystem());
 
     if(!world.getObjectManager().getLara().isDead())
     {
       world.getObjectManager().getLara().playSoundEffect(TR1SoundEffect::LaraHurt);
-      world.getObjectManager().getLara().forceSourcePosition = &particle->location.position;
+      world.getObjectManager().getLara().forceSourcePosition = location.position;
       world.getObjectManager().getLara().explosionStumblingDuration = 5_frame;
     }
 
@@ -465,44 +390,6 @@ bool MutantGrenadeParticle::update(world::World& world)
   return true;
 }
 
-bool LavaParticle::update(world::World& world)
-{
-  fall_speed += core::Gravity * 1_frame;
-  location.position += util::pitch(speed * 1_frame, angle.Y, fall_speed * 1_frame);
-
-  const auto sector = location.updateRoom();
-  setParent(this, location.room->node);
-  if(HeightInfo::fromFloor(sector, location.position, world.getObjectManager().getObjects()).y <= location.position.Y
-     || HeightInfo::fromCeiling(sector, location.position, world.getObjectManager().getObjects()).y
-          > location.position.Y)
-  {
-    return false;
-  }
-
-  if(world.getObjectManager().getLara().isNearInexact(location.position, 200_len))
-  {
-    world.getObjectManager().getLara().m_state.health -= 10_hp;
-    world.getObjectManager().getLara().m_state.is_hit = true;
-    return false;
-  }
-
-  applyTransform();
-  return true;
-}
-
-bool SparkleParticle::update(world::World&)
-{
-  applyTransform();
-
-  ++timePerSpriteFrame;
-  if(timePerSpriteFrame != 1)
-    return true;
-
-  --negSpriteFrameId;
-  timePerSpriteFrame = 0;
-  return gsl::narrow<size_t>(-negSpriteFrameId) < getLength();
-}
-
 bool MuzzleFlashParticle::update(world::World&)
 {
   --timePerSpriteFrame;
@@ -514,44 +401,6 @@ bool MuzzleFlashParticle::update(world::World&)
   return true;
 }
 
-bool ExplosionParticle::update(world::World&)
-{
-  ++timePerSpriteFrame;
-  if(timePerSpriteFrame == 2)
-  {
-    timePerSpriteFrame = 0;
-    nextFrame();
-    if(static_cast<size_t>(-negSpriteFrameId) >= getLength())
-    {
-      return false;
-    }
-  }
-
-  applyTransform();
-  return true;
-}
-
-bool SmokeParticle::update(world::World&)
-{
-  applyTransform();
-
-  ++timePerSpriteFrame;
-  if(timePerSpriteFrame < 3)
-    return true;
-
-  timePerSpriteFrame = 0;
-  nextFrame();
-  return gsl::narrow<size_t>(-negSpriteFrameId) < getLength();
-}
-
-bool RicochetParticle::update(world::World&)
-{
-  applyTransform();
-
-  --timePerSpriteFrame;
-  return timePerSpriteFrame != 0;
-}
-
 gslu::nn_shared<Particle> createMuzzleFlash(world::World& world,
                                             const Location& location,
                                             const core::Speed& /*speed*/,
@@ -582,11 +431,8 @@ gslu::nn_shared<Particle> createMutantGrenade(world::World& world,
   return particle;
 }
 
-gslu::nn_shared<Particle>
-  createBloodSplat(world::World& world, const Location& location, const core::Speed& speed, const core::Angle& angle)
+void createBloodSplat(world::World& world, const Location& location, const core::Speed& speed, const core::Angle& angle)
 {
-  auto particle = gsl::make_shared<BloodSplatterParticle>(location, speed, angle, world);
-  setParent(particle, location.room->node);
-  return particle;
+  world.getObjectManager().getParticlePool().spawnBloodSplatter(world, location, speed, angle);
 }
 } // namespace engine
@@ -24,8 +24,9 @@
 
 namespace render::scene
 {
+class Mesh;
 class Renderable;
-}
+} // namespace render::scene
 
 namespace engine::world
 {
@@ -50,6 +51,8 @@ public:
 
 private:
   std::deque<gslu::nn_shared<render::scene::Renderable>> m_renderables{};
+  // sprite particles only; rotated in lockstep with m_renderables
+  std::deque<gslu::nn_shared<render::scene::Mesh>> m_instancedRenderables{};
   Lighting m_lighting;
   std::optional<core::Shade> m_shade{std::nullopt};
 
@@ -66,6 +69,12 @@ protected:
     m_renderables.emplace_back(m_renderables.front());
     m_renderables.pop_front();
     setRenderable(m_renderables.front());
+
+    if(!m_instancedRenderables.empty())
+    {
+      m_instancedRenderables.emplace_back(m_instancedRenderables.front());
+      m_instancedRenderables.pop_front();
+    }
   }
 
   void applyTransform();
@@ -78,6 +87,7 @@ protected:
   void clearRenderables()
   {
     m_renderables.clear();
+    m_instancedRenderables.clear();
   }
 
 public:
@@ -103,77 +113,19 @@ public:
   virtual bool update(world::World& world) = 0;
 
   glm::vec3 getPosition() const final;
-};
-
-class BloodSplatterParticle final : public Particle
-{
-public:
-  explicit BloodSplatterParticle(const Location& location,
-                                 const core::Speed& speed_,
-                                 const core::Angle& angle_,
-                                 world::World& world)
-      : Particle{"bloodsplat", TR1ItemId::Blood, location, world, true}
-  {
-    speed = speed_;
-    angle.Y = angle_;
-  }
-
-  bool update(world::World& world) override;
-};
-
-class SplashParticle final : public Particle
-{
-public:
-  explicit SplashParticle(const Location& location, world::World& world, bool waterfall);
-
-  bool update(world::World& world) override;
-};
 
-class RicochetParticle final : public Particle
-{
-public:
-  explicit RicochetParticle(const Location& location, world::World& world)
-      : Particle{"ricochet", TR1ItemId::Ricochet, location, world, false}
+  [[nodiscard]] const Lighting& getLighting() const
   {
-    timePerSpriteFrame = 4;
-
-    const int n = util::rand15(3);
-    for(int i = 0; i < n; ++i)
-      nextFrame();
+    return m_lighting;
   }
 
-  bool update(world::World& /*world*/) override;
-};
-
-class BubbleParticle final : public Particle
-{
-public:
-  explicit BubbleParticle(const Location& location, world::World& world, bool onlyInWater = true)
-      : Particle{"bubble", TR1ItemId::Bubbles, location, world, true, nullptr}
-      , m_onlyInWater{onlyInWater}
+  [[nodiscard]] std::shared_ptr<render::scene::Mesh> getInstancedRenderable() const
   {
-    speed = 10_spd + util::rand15(6_spd);
-
-    const int n = util::rand15(3);
-    for(int i = 0; i < n; ++i)
-      nextFrame();
-  }
-
-  bool update(world::World& world) override;
-
-private:
-  const bool m_onlyInWater;
-};
+    if(m_instancedRenderables.empty())
+      return nullptr;
 
-class SparkleParticle final : public Particle
-{
-public:
-  explicit SparkleParticle(const Location& location, world::World& world)
-      : Particle{"sparkles", TR1ItemId::Sparkles, location, world, true}
-  {
+    return m_instancedRenderables.front().get();
   }
-
-  bool update(world::World& /*world*/) override;
 };
 
 class MuzzleFlashParticle final : public Particle
@@ -198,22 +150,6 @@ public:
   bool update(world::World& world) override;
 };
 
-class ExplosionParticle final : public Particle
-{
-public:
-  explicit ExplosionParticle(const Location& location,
-                             world::World& world,
-                             const core::Speed& fallSpeed,
-                             const core::TRRotation& angle)
-      : Particle{"explosion", TR1ItemId::Explosion, location, world, true}
-  {
-    fall_speed = fallSpeed;
-    this->angle = angle;
-  }
-
-  bool update(world::World& /*world*/) override;
-};
-
 class MeshShrapnelParticle final : public Particle
 {
 public:
@@ -269,34 +205,8 @@ public:
   bool update(world::World& world) override;
 };
 
-class LavaParticle final : public Particle
-{
-public:
-  explicit LavaParticle(const Location& location, world::World& world)
-      : Particle{"lava", TR1ItemId::LavaParticles, location, world, true}
-  {
-    angle.Y = util::rand15(180_deg) * 2;
-    speed = util::rand15(32_spd);
-    fall_speed = -util::rand15(165_spd);
-    negSpriteFrameId = util::rand15(int16_t{-4});
-  }
-
-  bool update(world::World& world) override;
-};
-
-class SmokeParticle final : public Particle
-{
-public:
-  explicit SmokeParticle(const Location& location, world::World& world, const core::TRRotation& rotation)
-      : Particle{"smoke", TR1ItemId::Smoke, location, world, false}
-  {
-    angle = rotation;
-  }
-
-  bool update(world::World& /*world*/) override;
-};
-
-extern gslu::nn_shared<Particle>
+//! Blood splatters are kept in the object manager's particle pool, so nothing is returned.
+extern void
   createBloodSplat(world::World& world, const Location& location, const core::Speed& speed, const core::Angle& angle);
 
 extern gslu::nn_shared<Particle> createMuzzleFlash(world::World& world,
@@ -0,0 +1,151 @@
+#include "particlebatcher.h"
+
+#include "particle.h"
+#include "render/scene/instancedmesh.h"
+#include "render/scene/mesh.h"
+#include "render/scene/node.h"
+#include "world/room.h"
+
+#include <gl/buffer.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/vec3.hpp>
+#include <gsl/gsl-lite.hpp>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace engine
+{
+ParticleBatcher::Batch::Batch(const gslu::nn_shared<render::scene::Mesh>& mesh,
+                              const gslu::nn_shared<gl::ShaderStorageBuffer<ShaderLight>>& lights,
+                              const gslu::nn_shared<gl::ShaderStorageBuffer<uint32_t>>& lightGrid,
+                              gslu::nn_shared<gl::ShaderStorageBuffer<render::scene::Instance>> instanceBuffer)
+    : node{gsl::make_shared<render::scene::Node>("particle-batch")}
+    , renderable{gsl::make_shared<render::scene::InstancedMesh>(mesh)}
+    , instanceBuffer{std::move(instanceBuffer)}
+{
+  node->setRenderable(renderable);
+  node->bind("InstanceData",
+             [buffer = instanceBuffer](const render::scene::Node* /*node*/,
+                                       const render::scene::Mesh& /*mesh*/,
+                                       gl::ShaderStorageBlock& shaderStorageBlock)
+             {
+               shaderStorageBlock.bind(*buffer);
+             });
+  node->bind("b_lights",
+             [lights](const render::scene::Node* /*node*/,
+                      const render::scene::Mesh& /*mesh*/,
+                      gl::ShaderStorageBlock& shaderStorageBlock)
+             {
+               shaderStorageBlock.bind(*lights);
+             });
+  node->bind("b_lightGrid",
+             [lightGrid](const render::scene::Node* /*node*/,
+                         const render::scene::Mesh& /*mesh*/,
+                         gl::ShaderStorageBlock& shaderStorageBlock)
+             {
+               shaderStorageBlock.bind(*lightGrid);
+             });
+}
+
+ParticleBatcher::ParticleBatcher() = default;
+
+ParticleBatcher::~ParticleBatcher() = default;
+
+bool ParticleBatcher::add(const Particle& particle)
+{
+  const auto& mesh = particle.getInstancedRenderable();
+  if(mesh == nullptr)
+    return false;
+
+  const auto& localBounds = particle.getLocalBounds();
+  add(particle.location.room->node,
+      gsl::not_null{mesh},
+      particle.getLighting().getBuffer(),
+      particle.getLighting().getGridBuffer(),
+      particle.getRenderState().getScissorTest().value_or(true),
+      render::scene::Instance{particle.getLocalMatrix(), particle.getLighting().ambient.get()},
+      localBounds.has_value() ? std::optional{localBounds->transformed(particle.getLocalMatrix())} : std::nullopt);
+  return true;
+}
+
+void ParticleBatcher::add(const std::shared_ptr<render::scene::Node>& roomNode,
+                          const gslu::nn_shared<render::scene::Mesh>& mesh,
+                          const gslu::nn_shared<gl::ShaderStorageBuffer<ShaderLight>>& lights,
+                          const gslu::nn_shared<gl::ShaderStorageBuffer<uint32_t>>& lightGrid,
+                          const bool scissorTest,
+                          const render::scene::Instance& instance,
+                          const std::optional<render::scene::BoundingBox>& bounds)
+{
+  // the light grid buffer is determined by the lights buffer, so it doesn't need to be part of the key
+  const Key key{roomNode.get(), mesh.get().get(), lights.get().get(), scissorTest};
+  auto it = m_batches.find(key);
+  if(it == m_batches.end())
+  {
+    std::shared_ptr<gl::ShaderStorageBuffer<render::scene::Instance>> instanceBuffer;
+    if(m_spareInstanceBuffers.empty())
+    {
+      instanceBuffer = std::make_shared<gl::ShaderStorageBuffer<render::scene::Instance>>("particle-instances-ssb");
+    }
+    else
+    {
+      instanceBuffer = m_spareInstanceBuffers.back();
+      m_spareInstanceBuffers.pop_back();
+    }
+    it = m_batches.try_emplace(key, mesh, lights, lightGrid, gsl::not_null{instanceBuffer}).first;
+    auto& batch = it->second;
+    if(!scissorTest)
+      batch.node->getRenderState().setScissorTest(false);
+    setParent(batch.node, roomNode);
+  }
+
+  auto& batch = it->second;
+  if(batch.instances.empty())
+    batch.bounds = bounds;
+  else if(batch.bounds.has_value())
+  {
+    if(bounds.has_value())
+      batch.bounds->extend(*bounds);
+    else
+      batch.bounds.reset();
+  }
+  batch.instances.emplace_back(instance);
+}
+
+void ParticleBatcher::flush()
+{
+  for(auto it = m_batches.begin(); it != m_batches.end();)
+  {
+    auto& batch = it->second;
+    if(batch.instances.empty())
+    {
+      setParent(batch.node, nullptr);
+      m_spareInstanceBuffers.emplace_back(batch.instanceBuffer);
+      it = m_batches.erase(it);
+      continue;
+    }
+
+    batch.renderable->setInstanceCount(gsl::narrow<gl::api::core::SizeType>(batch.instances.size()));
+
+    // place the batch node at the centroid of its instances so that depth sorting of the batch stays meaningful
+    glm::vec3 centroid{0.0f};
+    for(const auto& instance : batch.instances)
+      centroid += glm::vec3{instance.modelMatrix[3]};
+    centroid /= static_cast<float>(batch.instances.size());
+
+    const auto toBatchSpace = glm::translate(glm::mat4{1.0f}, -centroid);
+    for(auto& instance : batch.instances)
+      instance.modelMatrix = toBatchSpace * instance.modelMatrix;
+
+    batch.node->setLocalMatrix(glm::translate(glm::mat4{1.0f}, centroid));
+    if(batch.bounds.has_value())
+      batch.node->setLocalBounds(
+        render::scene::BoundingBox{batch.bounds->min - centroid, batch.bounds->max - centroid});
+    else
+      batch.node->setLocalBounds(std::nullopt);
+    batch.instanceBuffer->setData(batch.instances, gl::api::BufferUsage::StreamDraw);
+    batch.instances.clear();
+    ++it;
+  }
+}
+} // namespace engine
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "lighting.h"
+#include "render/scene/instancedmesh.h"
+#include "render/scene/node.h"
+
+#include <cstdint>
+#include <gl/buffer.h>
+#include <gslu.h>
+#include <map>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace render::scene
+{
+class Mesh;
+} // namespace render::scene
+
+namespace engine
+{
+class Particle;
+
+/**
+ * Groups sprite particles by room, current sprite frame and room lights, and draws each group with a single
+ * instanced draw call. Batches that did not receive any particles during a frame are removed, but their instance
+ * buffers are recycled for new batches instead of being re-created.
+ */
+class ParticleBatcher final
+{
+public:
+  ParticleBatcher();
+  ~ParticleBatcher();
+
+  ParticleBatcher(const ParticleBatcher&) = delete;
+  ParticleBatcher(ParticleBatcher&&) = delete;
+  ParticleBatcher& operator=(const ParticleBatcher&) = delete;
+  ParticleBatcher& operator=(ParticleBatcher&&) = delete;
+
+  /**
+   * @returns @c false if the particle has no instanced representation and must be drawn on its own.
+   */
+  bool add(const Particle& particle);
+
+  /**
+   * Adds an instance of @a mesh, positioned relative to @a roomNode.
+   * @param bounds the instance's bounds relative to @a roomNode, empty if it is unbounded
+   */
+  void add(const std::shared_ptr<render::scene::Node>& roomNode,
+           const gslu::nn_shared<render::scene::Mesh>& mesh,
+           const gslu::nn_shared<gl::ShaderStorageBuffer<ShaderLight>>& lights,
+           const gslu::nn_shared<gl::ShaderStorageBuffer<uint32_t>>& lightGrid,
+           bool scissorTest,
+           const render::scene::Instance& instance,
+           const std::optional<render::scene::BoundingBox>& bounds);
+
+  /**
+   * Uploads all instances added since the last call, and removes batches that did not receive any particles.
+   */
+  void flush();
+
+private:
+  struct Batch
+  {
+    explicit Batch(const gslu::nn_shared<render::scene::Mesh>& mesh,
+                   const gslu::nn_shared<gl::ShaderStorageBuffer<ShaderLight>>& lights,
+                   const gslu::nn_shared<gl::ShaderStorageBuffer<uint32_t>>& lightGrid,
+                   gslu::nn_shared<gl::ShaderStorageBuffer<render::scene::Instance>> instanceBuffer);
+
+    gslu::nn_shared<render::scene::Node> node;
+    gslu::nn_shared<render::scene::InstancedMesh> renderable;
+    gslu::nn_shared<gl::ShaderStorageBuffer<render::scene::Instance>> instanceBuffer;
+    std::vector<render::scene::Instance> instances;
+    //! Room-space bounds of all instances, empty if any of them is unbounded.
+    std::optional<render::scene::BoundingBox> bounds;
+  };
+
+  using Key = std::tuple<const render::scene::Node*,
+                         const render::scene::Mesh*,
+                         const gl::ShaderStorageBuffer<ShaderLight>*,
+                         bool>;
+  std::map<Key, Batch> m_batches;
+  //! Instance buffers of removed batches.
+  std::vector<gslu::nn_shared<gl::ShaderStorageBuffer<render::scene::Instance>>> m_spareInstanceBuffers;
+};
+} // namespace engine
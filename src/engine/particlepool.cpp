@@ -0,0 +1,368 @@
+#include "particlepool.h"
+
+#include "core/magic.h"
+#include "core/vec.h"
+#include "heightinfo.h"
+#include "lighting.h"
+#include "lightgrid.h"
+#include "objectmanager.h"
+#include "objects/laraobject.h"
+#include "particlebatcher.h"
+#include "render/scene/instancedmesh.h"
+#include "render/scene/node.h"
+#include "util/helpers.h"
+#include "world/room.h"
+#include "world/sprite.h"
+#include "world/world.h"
+
+#include <algorithm>
+#include <boost/log/trivial.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <gsl/gsl-lite.hpp>
+#include <utility>
+
+namespace engine
+{
+ParticlePool::Particles::Particles(const TR1ItemId type, const bool billboard, const bool scissorTest)
+    : type{type}
+    , billboard{billboard}
+    , scissorTest{scissorTest}
+{
+  locations.reserve(Capacity);
+  angles.reserve(Capacity);
+  speeds.reserve(Capacity);
+  fallSpeeds.reserve(Capacity);
+  spriteIndices.reserve(Capacity);
+  timers.reserve(Capacity);
+  ambients.reserve(Capacity);
+  onlyInWater.reserve(Capacity);
+}
+
+size_t ParticlePool::Particles::getSpriteCount() const
+{
+  Expects(sprites != nullptr);
+  return sprites->sprites.size();
+}
+
+std::optional<size_t> ParticlePool::Particles::add(const world::World& world, const Location& location)
+{
+  if(sprites == nullptr)
+  {
+    const auto& sequence = world.findSpriteSequenceForType(type);
+    if(sequence == nullptr || sequence->sprites.empty())
+    {
+      BOOST_LOG_TRIVIAL(warning) << "Missing sprite referenced by particle: " << toString(type);
+      return std::nullopt;
+    }
+
+    sprites = sequence.get();
+    for(const auto& sprite : sprites->sprites)
+      radius = std::max(radius, sprite.getRadius());
+  }
+
+  if(size() >= Capacity)
+    return std::nullopt;
+
+  locations.emplace_back(location);
+  angles.emplace_back();
+  speeds.emplace_back(0_spd);
+  fallSpeeds.emplace_back(0_spd);
+  spriteIndices.emplace_back(int16_t{0});
+  timers.emplace_back(int16_t{0});
+  ambients.emplace_back(-1.0f);
+  onlyInWater.emplace_back(false);
+  return size() - 1;
+}
+
+void ParticlePool::Particles::remove(const size_t index)
+{
+  Expects(index < size());
+
+  const auto last = size() - 1;
+  if(index != last)
+  {
+    locations[index] = locations[last];
+    angles[index] = angles[last];
+    speeds[index] = speeds[last];
+    fallSpeeds[index] = fallSpeeds[last];
+    spriteIndices[index] = spriteIndices[last];
+    timers[index] = timers[last];
+    ambients[index] = ambients[last];
+    onlyInWater[index] = onlyInWater[last];
+  }
+
+  locations.pop_back();
+  angles.pop_back();
+  speeds.pop_back();
+  fallSpeeds.pop_back();
+  spriteIndices.pop_back();
+  timers.pop_back();
+  ambients.pop_back();
+  onlyInWater.pop_back();
+}
+
+void ParticlePool::spawnBloodSplatter(world::World& world,
+                                      const Location& location,
+                                      const core::Speed& speed,
+                                      const core::Angle& angle)
+{
+  const auto index = m_bloodSplatters.add(world, location);
+  if(!index.has_value())
+    return;
+
+  m_bloodSplatters.speeds[*index] = speed;
+  m_bloodSplatters.angles[*index].Y = angle;
+}
+
+void ParticlePool::spawnSplash(world::World& world, const Location& location, const bool waterfall)
+{
+  const auto index = m_splashes.add(world, location);
+  if(!index.has_value())
+    return;
+
+  if(!waterfall)
+  {
+    m_splashes.speeds[*index] = util::rand15(128_spd);
+    m_splashes.angles[*index].Y = core::auToAngle(2 * util::rand15s());
+  }
+  else
+  {
+    m_splashes.locations[*index].position.X += util::rand15s(1_sectors);
+    m_splashes.locations[*index].position.Z += util::rand15s(1_sectors);
+  }
+}
+
+void ParticlePool::spawnRicochet(world::World& world,
+                                 const Location& location,
+                                 const core::TRRotation& angle,
+                                 const int16_t duration)
+{
+  const auto index = m_ricochets.add(world, location);
+  if(!index.has_value())
+    return;
+
+  m_ricochets.angles[*index] = angle;
+  m_ricochets.timers[*index] = duration;
+  m_ricochets.spriteIndices[*index] = util::rand15(int16_t{3});
+}
+
+void ParticlePool::spawnBubble(world::World& world, const Location& location, const bool onlyInWater)
+{
+  const auto index = m_bubbles.add(world, location);
+  if(!index.has_value())
+    return;
+
+  m_bubbles.speeds[*index] = 10_spd + util::rand15(6_spd);
+  m_bubbles.spriteIndices[*index] = util::rand15(int16_t{3});
+  m_bubbles.onlyInWater[*index] = onlyInWater;
+}
+
+void ParticlePool::spawnSparkle(world::World& world, const Location& location)
+{
+  m_sparkles.add(world, location);
+}
+
+void ParticlePool::spawnExplosion(world::World& world,
+                                  const Location& location,
+                                  const core::Speed& fallSpeed,
+                                  const core::TRRotation& angle)
+{
+  const auto index = m_explosions.add(world, location);
+  if(!index.has_value())
+    return;
+
+  m_explosions.fallSpeeds[*index] = fallSpeed;
+  m_explosions.angles[*index] = angle;
+}
+
+void ParticlePool::spawnLava(world::World& world, const Location& location)
+{
+  const auto index = m_lava.add(world, location);
+  if(!index.has_value())
+    return;
+
+  m_lava.angles[*index].Y = util::rand15(180_deg) * 2;
+  m_lava.speeds[*index] = util::rand15(32_spd);
+  m_lava.fallSpeeds[*index] = -util::rand15(165_spd);
+  m_lava.spriteIndices[*index] = gsl::narrow_cast<int16_t>(-util::rand15(int16_t{-4}));
+}
+
+void ParticlePool::spawnSmoke(world::World& world, const Location& location, const core::TRRotation& angle)
+{
+  const auto index = m_smoke.add(world, location);
+  if(!index.has_value())
+    return;
+
+  m_smoke.angles[*index] = angle;
+}
+
+void ParticlePool::update(world::World& world, ParticleBatcher& batcher)
+{
+  update(m_bloodSplatters, &updateBloodSplatter, world, batcher);
+  update(m_splashes, &updateSplash, world, batcher);
+  update(m_ricochets, &updateRicochet, world, batcher);
+  update(m_bubbles, &updateBubble, world, batcher);
+  update(m_sparkles, &updateSparkle, world, batcher);
+  update(m_explosions, &updateExplosion, world, batcher);
+  update(m_lava, &updateLava, world, batcher);
+  update(m_smoke, &updateSmoke, world, batcher);
+}
+
+void ParticlePool::update(Particles& particles,
+                          const UpdateFn updateParticle,
+                          world::World& world,
+                          ParticleBatcher& batcher)
+{
+  if(particles.size() == 0)
+    return;
+
+  const auto lights = LightGrid::getLightsBuffer();
+  const auto lightGrid = LightGrid::getClusterBuffer();
+  const render::scene::BoundingBox spriteBounds{glm::vec3{-particles.radius}, glm::vec3{particles.radius}};
+
+  for(size_t i = 0; i < particles.size();)
+  {
+    if(!updateParticle(particles, i, world))
+    {
+      // the last particle takes over the slot, and is updated next
+      particles.remove(i);
+      continue;
+    }
+
+    auto& location = particles.locations[i];
+    location.updateRoom();
+
+    auto& ambient = particles.ambients[i];
+    const auto targetAmbient = toBrightness(location.room->ambientShade);
+    if(ambient.get() < 0)
+      ambient = targetAmbient;
+    else
+      ambient += (targetAmbient - ambient) / 50.0f;
+
+    const auto& sprite = particles.sprites->sprites[gsl::narrow<size_t>(particles.spriteIndices[i])
+                                                    % particles.getSpriteCount()];
+    const auto& mesh = particles.billboard ? sprite.instancedBillboardMesh : sprite.instancedYBoundMesh;
+    if(mesh != nullptr)
+    {
+      const glm::vec3 tr = location.position.toRenderSystem() - location.room->position.toRenderSystem();
+      const auto modelMatrix = glm::translate(glm::mat4{1.0f}, tr) * particles.angles[i].toMatrix();
+      batcher.add(location.room->node,
+                  gsl::not_null{mesh},
+                  lights,
+                  lightGrid,
+                  particles.scissorTest,
+                  render::scene::Instance{modelMatrix, ambient.get()},
+                  spriteBounds.transformed(modelMatrix));
+    }
+
+    ++i;
+  }
+}
+
+bool ParticlePool::updateBloodSplatter(Particles& particles, const size_t index, world::World& /*world*/)
+{
+  particles.locations[index].position += util::pitch(particles.speeds[index] * 1_frame, particles.angles[index].Y);
+  auto& timer = particles.timers[index];
+  ++timer;
+  if(timer != 4)
+    return true;
+
+  timer = 0;
+  ++particles.spriteIndices[index];
+  return gsl::narrow<size_t>(particles.spriteIndices[index]) < particles.getSpriteCount();
+}
+
+bool ParticlePool::updateSplash(Particles& particles, const size_t index, world::World& /*world*/)
+{
+  ++particles.spriteIndices[index];
+  if(gsl::narrow<size_t>(particles.spriteIndices[index]) >= particles.getSpriteCount())
+    return false;
+
+  particles.locations[index].position += util::pitch(particles.speeds[index] * 1_frame, particles.angles[index].Y);
+  return true;
+}
+
+bool ParticlePool::updateRicochet(Particles& particles, const size_t index, world::World& /*world*/)
+{
+  --particles.timers[index];
+  return particles.timers[index] != 0;
+}
+
+bool ParticlePool::updateBubble(Particles& particles, const size_t index, world::World& world)
+{
+  auto& location = particles.locations[index];
+  auto& angle = particles.angles[index];
+  angle.X += 13_deg;
+  angle.Y += 9_deg;
+  location.position += util::pitch(11_len, angle.Y, -particles.speeds[index] * 1_frame);
+  const auto sector = location.updateRoom();
+  if(particles.onlyInWater[index] && !location.room->isWaterRoom)
+    return false;
+
+  const auto ceiling = HeightInfo::fromCeiling(sector, location.position, world.getObjectManager().getObjects()).y;
+  return ceiling != core::InvalidHeight && location.position.Y > ceiling;
+}
+
+bool ParticlePool::updateSparkle(Particles& particles, const size_t index, world::World& /*world*/)
+{
+  auto& timer = particles.timers[index];
+  ++timer;
+  if(timer != 1)
+    return true;
+
+  timer = 0;
+  ++particles.spriteIndices[index];
+  return gsl::narrow<size_t>(particles.spriteIndices[index]) < particles.getSpriteCount();
+}
+
+bool ParticlePool::updateExplosion(Particles& particles, const size_t index, world::World& /*world*/)
+{
+  auto& timer = particles.timers[index];
+  ++timer;
+  if(timer != 2)
+    return true;
+
+  timer = 0;
+  ++particles.spriteIndices[index];
+  return gsl::narrow<size_t>(particles.spriteIndices[index]) < particles.getSpriteCount();
+}
+
+bool ParticlePool::updateLava(Particles& particles, const size_t index, world::World& world)
+{
+  auto& location = particles.locations[index];
+  auto& fallSpeed = particles.fallSpeeds[index];
+  fallSpeed += core::Gravity * 1_frame;
+  location.position += util::pitch(particles.speeds[index] * 1_frame, particles.angles[index].Y, fallSpeed * 1_frame);
+
+  const auto sector = location.updateRoom();
+  if(HeightInfo::fromFloor(sector, location.position, world.getObjectManager().getObjects()).y <= location.position.Y
+     || HeightInfo::fromCeiling(sector, location.position, world.getObjectManager().getObjects()).y
+          > location.position.Y)
+  {
+    return false;
+  }
+
+  if(auto& lara = world.getObjectManager().getLara(); lara.isNearInexact(location.position, 200_len))
+  {
+    lara.m_state.health -= 10_hp;
+    lara.m_state.is_hit = true;
+    return false;
+  }
+
+  return true;
+}
+
+bool ParticlePool::updateSmoke(Particles& particles, const size_t index, world::World& /*world*/)
+{
+  auto& timer = particles.timers[index];
+  ++timer;
+  if(timer < 3)
+    return true;
+
+  timer = 0;
+  ++particles.spriteIndices[index];
+  return gsl::narrow<size_t>(particles.spriteIndices[index]) < particles.getSpriteCount();
+}
+} // namespace engine
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "core/angle.h"
+#include "core/units.h"
+#include "items_tr1.h"
+#include "location.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace engine::world
+{
+class World;
+struct SpriteSequence;
+} // namespace engine::world
+
+namespace engine
+{
+class ParticleBatcher;
+
+/**
+ * Holds the short-lived sprite particles, e.g. blood splatters, splashes and explosions, without creating a scene node
+ * for each of them. Each kind of particle is stored as a structure of arrays with a fixed capacity, and is updated by
+ * its own update function; expired particles are replaced by the last particle of their kind, so that the live
+ * particles always stay packed. While a kind's storage is full, new particles of that kind are dropped.
+ */
+class ParticlePool final
+{
+public:
+  //! Maximum number of live particles of each kind.
+  static constexpr size_t Capacity = 256;
+
+  void spawnBloodSplatter(world::World& world,
+                          const Location& location,
+                          const core::Speed& speed,
+                          const core::Angle& angle);
+  void spawnSplash(world::World& world, const Location& location, bool waterfall);
+  //! @param duration number of frames the ricochet is visible
+  void spawnRicochet(world::World& world, const Location& location, const core::TRRotation& angle, int16_t duration);
+  //! @param onlyInWater whether the bubble vanishes when leaving water rooms
+  void spawnBubble(world::World& world, const Location& location, bool onlyInWater);
+  void spawnSparkle(world::World& world, const Location& location);
+  void spawnExplosion(world::World& world,
+                      const Location& location,
+                      const core::Speed& fallSpeed,
+                      const core::TRRotation& angle);
+  void spawnLava(world::World& world, const Location& location);
+  void spawnSmoke(world::World& world, const Location& location, const core::TRRotation& angle);
+
+  //! Updates all particles, drops the expired ones, and adds the remaining ones to @a batcher.
+  void update(world::World& world, ParticleBatcher& batcher);
+
+private:
+  struct Particles
+  {
+    explicit Particles(TR1ItemId type, bool billboard, bool scissorTest);
+
+    const TR1ItemId type;
+    const bool billboard;
+    const bool scissorTest;
+    //! Resolved when the first particle of this kind is spawned.
+    const world::SpriteSequence* sprites = nullptr;
+    //! The largest radius of all sprites, as particles cycle through their sprites.
+    float radius = 0;
+
+    std::vector<Location> locations;
+    std::vector<core::TRRotation> angles;
+    std::vector<core::Speed> speeds;
+    std::vector<core::Speed> fallSpeeds;
+    //! Index into the sprite sequence; wraps around when drawing.
+    std::vector<int16_t> spriteIndices;
+    //! Kind-specific frame counter, e.g. the number of frames until the next sprite is shown.
+    std::vector<int16_t> timers;
+    std::vector<core::Brightness> ambients;
+    //! Only used by bubbles.
+    std::vector<bool> onlyInWater;
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+      return locations.size();
+    }
+
+    [[nodiscard]] size_t getSpriteCount() const;
+
+    //! Appends a particle in its default state; @returns @c std::nullopt if the particle had to be dropped.
+    std::optional<size_t> add(const world::World& world, const Location& location);
+    void remove(size_t index);
+  };
+
+  using UpdateFn = bool (*)(Particles& particles, size_t index, world::World& world);
+
+  Particles m_bloodSplatters{TR1ItemId::Blood, true, true};
+  Particles m_splashes{TR1ItemId::Splash, false, false};
+  Particles m_ricochets{TR1ItemId::Ricochet, false, true};
+  Particles m_bubbles{TR1ItemId::Bubbles, true, true};
+  Particles m_sparkles{TR1ItemId::Sparkles, true, true};
+  Particles m_explosions{TR1ItemId::Explosion, true, true};
+  Particles m_lava{TR1ItemId::LavaParticles, true, true};
+  Particles m_smoke{TR1ItemId::Smoke, false, true};
+
+  static void update(Particles& particles, UpdateFn updateParticle, world::World& world, ParticleBatcher& batcher);
+
+  // the update functions return false if the particle expired
+  static bool updateBloodSplatter(Particles& particles, size_t index, world::World& world);
+  static bool updateSplash(Particles& particles, size_t index, world::World& world);
+  static bool updateRicochet(Particles& particles, size_t index, world::World& world);
+  static bool updateBubble(Particles& particles, size_t index, world::World& world);
+  static bool updateSparkle(Particles& particles, size_t index, world::World& world);
+  static bool updateExplosion(Particles& particles, size_t index, world::World& world);
+  static bool updateLava(Particles& particles, size_t index, world::World& world);
+  static bool updateSmoke(Particles& particles, size_t index, world::World& world);
+};
+} // namespace engine
@@ -2,14 +2,18 @@
 
 #include "audio/soundengine.h"
 #include "audiosettings.h"
+#include "backgroundworker.h"
 #include "cameracontroller.h"
 #include "core/i18n.h"
 #include "hid/actions.h"
 #include "hid/inputhandler.h"
+#include "lightgrid.h"
 #include "objectmanager.h"
 #include "objects/laraobject.h"
 #include "objects/objectstate.h"
 #include "qs/qs.h"
+#include "render/gpuprofiler.h"
+#include "render/occlusionculler.h"
 #include "render/pass/config.h"
 #include "render/renderpipeline.h"
 #include "render/rendersettings.h"
@@ -28,13 +32,16 @@
 #include "render/scene/shadercache.h"
 #include "render/scene/uniformparameter.h"
 #include "render/scene/visitor.h"
+#include "screencapture.h"
 #include "ui/text.h"
 #include "ui/ui.h"
 #include "util/helpers.h"
 #include "video/videoplayer.h"
 #include "world/room.h"
+#include "world/roomgeometry.h"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstdlib>
 #include <gl/cimgwrapper.h>
@@ -121,22 +128,27 @@ void Presenter::playVideo(const std::filesystem::path& path)
 }
 
 void Presenter::renderWorld(const std::vector<world::Room>& rooms,
+                            world::RoomGeometry& roomGeometry,
                             const CameraController& cameraController,
                             const std::unordered_set<const world::Portal*>& waterEntryPortals)
 {
+  m_renderPipeline->beginWorld(*m_renderer->getCamera());
   m_renderPipeline->updateCamera(m_renderer->getCamera());
+  m_occlusionCuller->cull(rooms, *cameraController.getCurrentRoom());
+  m_lightGrid->update(rooms, *m_renderer->getCamera(), m_lightCollectionDepth);
 
   {
     SOGLB_DEBUGGROUP("csm-pass");
+    const auto gpuScope = m_gpuProfiler->measure("csm-pass");
     gl::RenderState::resetWantedState();
     gl::RenderState::getWantedState().setDepthClamp(true);
     m_csm->updateCamera(*m_renderer->getCamera());
 
-    for(const auto& texture : m_csm->getDepthTextures())
-      texture->clear(gl::ScalarDepth{1.0f});
+    std::array<bool, render::scene::CSMBuffer::NSplits> renderedSplits{};
     for(size_t i = 0; i < render::scene::CSMBuffer::NSplits; ++i)
     {
       SOGLB_DEBUGGROUP("csm-pass/" + std::to_string(i));
+      const auto splitGpuScope = m_gpuProfiler->measure("csm-pass/" + std::to_string(i));
 
       m_csm->setActiveSplit(i);
       m_csm->getActiveFramebuffer()->bind();
@@ -155,6 +167,12 @@ void Presenter::renderWorld(const std::vector<world::Room>& rooms,
           visitor.visit(*child);
         }
       }
+
+      renderedSplits[i] = m_csm->updateActiveSplit(visitor.hashContents());
+      if(!renderedSplits[i])
+        continue;
+
+      m_csm->getDepthTextures()[i]->clear(gl::ScalarDepth{1.0f});
       visitor.render(glm::vec3{0.0f, 0.0f, std::numeric_limits<float>::lowest()});
       m_csm->beginActiveDepthSync();
     }
@@ -164,7 +182,11 @@ void Presenter::renderWorld(const std::vector<world::Room>& rooms,
 
     for(size_t i = 0; i < render::scene::CSMBuffer::NSplits; ++i)
     {
+      if(!renderedSplits[i])
+        continue;
+
       SOGLB_DEBUGGROUP("csm-pass-square/" + std::to_string(i));
+      const auto splitGpuScope = m_gpuProfiler->measure("csm-pass-square/" + std::to_string(i));
       m_csm->setActiveSplit(i);
       m_csm->waitActiveDepthSync();
       m_csm->renderSquare();
@@ -176,7 +198,11 @@ void Presenter::renderWorld(const std::vector<world::Room>& rooms,
 
     for(size_t i = 0; i < render::scene::CSMBuffer::NSplits; ++i)
     {
+      if(!renderedSplits[i])
+        continue;
+
       SOGLB_DEBUGGROUP("csm-pass-blur/" + std::to_string(i));
+      const auto splitGpuScope = m_gpuProfiler->measure("csm-pass-blur/" + std::to_string(i));
       m_csm->setActiveSplit(i);
       m_csm->waitActiveSquareSync();
       m_csm->renderBlur();
@@ -188,6 +214,9 @@ void Presenter::renderWorld(const std::vector<world::Room>& rooms,
 
     for(size_t i = 0; i < render::scene::CSMBuffer::NSplits; ++i)
     {
+      if(!renderedSplits[i])
+        continue;
+
       m_csm->setActiveSplit(i);
       m_csm->waitActiveBlurSync();
     }
@@ -195,38 +224,23 @@ void Presenter::renderWorld(const std::vector<world::Room>& rooms,
 
   {
     SOGLB_DEBUGGROUP("geometry-pass");
+    const auto gpuScope = m_gpuProfiler->measure("geometry-pass");
     m_renderPipeline->bindGeometryFrameBuffer(cameraController.getCamera()->getFarPlane());
 
     {
       SOGLB_DEBUGGROUP("depth-prefill-pass");
-
-      // collect rooms and sort front-to-back
-      std::vector<const world::Room*> renderRooms;
-      for(const auto& room : rooms)
-      {
-        if(room.node->isVisible())
-          renderRooms.emplace_back(&room);
-      }
-      std::sort(renderRooms.begin(),
-                renderRooms.end(),
-                [](const world::Room* a, const world::Room* b)
-                {
-                  return a->node->getRenderOrder() > b->node->getRenderOrder();
-                });
+      const auto prefillGpuScope = m_gpuProfiler->measure("depth-prefill-pass");
 
       render::scene::RenderContext context{render::scene::RenderMode::DepthOnly,
                                            cameraController.getCamera()->getViewProjectionMatrix()};
-      for(const auto& room : renderRooms)
-      {
-        SOGLB_DEBUGGROUP(room->node->getName());
-        auto state = context.getCurrentState();
-        state.setScissorTest(true);
-        const auto [xy, size] = room->node->getCombinedScissors();
-        state.setScissorRegion(xy, size);
-        context.pushState(state);
-        room->node->getRenderable()->render(room->node.get(), context);
-        context.popState();
-      }
+      roomGeometry.update(rooms, context);
+      roomGeometry.render(context);
+      // the results are used by the next frame's culling to avoid stalling
+      m_occlusionCuller->query(rooms,
+                               *cameraController.getCurrentRoom(),
+                               cameraController.getPosition(),
+                               cameraController.getCamera()->getNearPlane(),
+                               context);
       if constexpr(render::pass::FlushPasses)
         GL_ASSERT(gl::api::finish());
     }
@@ -239,6 +253,7 @@ void Presenter::renderWorld(const std::vector<world::Room>& rooms,
 
   {
     SOGLB_DEBUGGROUP("portal-depth-pass");
+    const auto gpuScope = m_gpuProfiler->measure("portal-depth-pass");
     gl::RenderState::resetWantedState();
 
     render::scene::RenderContext context{render::scene::RenderMode::DepthOnly,
@@ -254,6 +269,7 @@ void Presenter::renderWorld(const std::vector<world::Room>& rooms,
   }
 
   m_renderPipeline->worldCompositionPass(rooms, cameraController.getCurrentRoom()->isWaterRoom);
+  m_occlusionCuller->restore(rooms);
   m_screenOverlay.reset();
 }
 
@@ -414,8 +430,12 @@ std::vector<std::filesystem::path> getIconPaths(const std::filesystem::path& bas
 }
 } // namespace
 
-Presenter::Presenter(const std::filesystem::path& engineDataPath, const glm::ivec2& resolution)
-    : m_window{std::make_unique<gl::Window>(getIconPaths(engineDataPath, {24, 32, 64, 128, 256, 512}), resolution)}
+Presenter::Presenter(const std::filesystem::path& engineDataPath,
+                     const std::filesystem::path& userDataPath,
+                     const glm::ivec2& resolution,
+                     const bool headless)
+    : m_window{std::make_unique<gl::Window>(
+      getIconPaths(engineDataPath, {24, 32, 64, 128, 256, 512}), resolution, headless)}
     , m_soundEngine{std::make_shared<audio::SoundEngine>()}
     , m_renderer{std::make_shared<render::scene::Renderer>(
         gsl::make_shared<render::scene::Camera>(DefaultFov, getRenderViewport(), DefaultNearPlane, DefaultFarPlane))}
@@ -426,15 +446,22 @@ Presenter::Presenter(const std::filesystem::path& engineDataPath, const glm::ive
     , m_debugFont{std::make_unique<gl::Font>(util::ensureFileExists(engineDataPath / "DroidSansMono.ttf"))}
     , m_inputHandler{std::make_unique<hid::InputHandler>(m_window->getWindow(),
                                                          engineDataPath / "gamecontrollerdb.txt")}
-    , m_shaderCache{std::make_shared<render::scene::ShaderCache>(engineDataPath / "shaders")}
+    , m_shaderCache{std::make_shared<render::scene::ShaderCache>(engineDataPath / "shaders",
+                                                                 userDataPath / "shadercache")}
     , m_materialManager{std::make_unique<render::scene::MaterialManager>(m_shaderCache, m_renderer)}
     , m_csm{std::make_shared<render::scene::CSM>(1024, *m_materialManager)}
+    , m_gpuProfiler{std::make_shared<render::GpuProfiler>()}
+    , m_backgroundWorker{std::make_shared<BackgroundWorker>("presenter")}
+    , m_screenCapture{std::make_unique<ScreenCapture>(m_backgroundWorker)}
     , m_renderPipeline{std::make_unique<render::RenderPipeline>(
-        *m_materialManager, getRenderViewport(), getUiViewport(), getDisplayViewport())}
+        *m_materialManager, m_gpuProfiler, getRenderViewport(), getUiViewport(), getDisplayViewport())}
+    , m_occlusionCuller{std::make_unique<render::OcclusionCuller>()}
+    , m_lightGrid{std::make_unique<LightGrid>()}
 {
   m_materialManager->setCSM(gsl::not_null{m_csm});
   scaleSplashImage();
   drawLoadingScreen(_("Booting"));
+  warmUpShaders();
 }
 
 Presenter::~Presenter() = default;
@@ -491,6 +518,31 @@ void Presenter::drawLoadingScreen(const std::string& state)
   swapBuffers();
 }
 
+void Presenter::warmUpShaders()
+{
+  // submit everything at once so that the driver can compile in parallel, and keep the loading screen alive meanwhile;
+  // otherwise programs for e.g. underwater rendering or toggled render settings are compiled when first needed
+  m_shaderCache->prepareAll();
+  // the screen space effects are fused depending on the render settings, so prepare every grouping they can produce
+  for(uint8_t toggles = 0; toggles < 1u << 6u; ++toggles)
+  {
+    render::RenderSettings settings{};
+    settings.hbao = (toggles & 1u) != 0;
+    settings.fxaa = (toggles & 2u) != 0;
+    settings.lensDistortion = (toggles & 4u) != 0;
+    settings.velvia = (toggles & 8u) != 0;
+    settings.filmGrain = (toggles & 16u) != 0;
+    settings.crt = (toggles & 32u) != 0;
+    for(const auto& stages : render::RenderPipeline::getFusedEffectStages(settings))
+      m_shaderCache->prepare(render::scene::ShaderCache::describeFusedEffect(stages));
+  }
+  const auto total = m_shaderCache->getPendingCount();
+  while(m_shaderCache->pollPending() > 0)
+  {
+    drawLoadingScreen(_("Preparing Shaders (%1%/%2%)", total - m_shaderCache->getPendingCount(), total));
+  }
+}
+
 bool Presenter::preFrame()
 {
   m_window->updateWindowSize();
@@ -510,6 +562,8 @@ bool Presenter::preFrame()
   }
 
   m_inputHandler->update();
+  m_gpuProfiler->beginFrame();
+  m_screenCapture->poll();
 
   m_renderer->clear(
     gl::api::ClearBufferMask::ColorBufferBit | gl::api::ClearBufferMask::DepthBufferBit, {0, 0, 0, 0}, 1);
@@ -546,8 +600,12 @@ void Presenter::debounceInput()
 
 void Presenter::apply(const render::RenderSettings& renderSettings, const AudioSettings& audioSettings)
 {
-  m_renderResolutionDivisor = renderSettings.renderResolutionDivisorActive ? renderSettings.renderResolutionDivisor : 1;
+  // the dynamic resolution renders into a part of the full size render targets instead
+  m_renderResolutionDivisor = renderSettings.renderResolutionDivisorActive && !renderSettings.dynamicResolution
+                                ? renderSettings.renderResolutionDivisor
+                                : 1;
   m_uiScale = renderSettings.uiScaleActive ? renderSettings.uiScaleMultiplier : 1;
+  m_lightCollectionDepth = renderSettings.getLightCollectionDepth();
   m_renderer->getCamera()->setViewport(getRenderViewport());
   setFullscreen(renderSettings.fullscreen);
   if(m_csm->getResolution() != renderSettings.getCSMResolution())
@@ -555,6 +613,7 @@ void Presenter::apply(const render::RenderSettings& renderSettings, const AudioS
     m_csm = gsl::make_shared<render::scene::CSM>(renderSettings.getCSMResolution(), *m_materialManager);
     m_materialManager->setCSM(m_csm);
   }
+  m_csm->setReuseDistantSplits(renderSettings.reuseDistantShadows);
   m_renderPipeline->apply(renderSettings, *m_materialManager);
   m_materialManager->setFiltering(renderSettings.bilinearFiltering,
                                   !renderSettings.anisotropyActive
@@ -563,18 +622,9 @@ void Presenter::apply(const render::RenderSettings& renderSettings, const AudioS
   m_soundEngine->setListenerGain(audioSettings.globalVolume);
 }
 
-gl::CImgWrapper Presenter::takeScreenshot() const
+void Presenter::takeScreenshot(std::function<void(gl::CImgWrapper& image)> onCaptured)
 {
-  const auto vp = getDisplayViewport();
-
-  std::vector<uint8_t> pixels;
-  pixels.resize(gsl::narrow<size_t>(vp.x) * gsl::narrow<size_t>(vp.y) * 4u);
-  GL_ASSERT(
-    gl::api::readPixel(0, 0, vp.x, vp.y, gl::api::PixelFormat::Rgba, gl::api::PixelType::UnsignedByte, pixels.data()));
-
-  gl::CImgWrapper img{pixels.data(), vp.x, vp.y, false};
-  img.fromScreenshot();
-  return img;
+  m_screenCapture->capture(getDisplayViewport(), std::move(onCaptured));
 }
 
 void Presenter::renderScreenOverlay()
@@ -5,7 +5,9 @@
 #include "qs/quantity.h"
 
 #include <array>
+#include <cstddef>
 #include <filesystem>
+#include <functional>
 #include <gl/cimgwrapper.h>
 #include <gl/pixel.h>
 #include <gl/soglb_fwd.h> // IWYU pragma: keep
@@ -37,6 +39,8 @@ class InputHandler;
 
 namespace render
 {
+class GpuProfiler;
+class OcclusionCuller;
 class RenderPipeline;
 struct RenderSettings;
 } // namespace render
@@ -54,6 +58,7 @@ class ShaderCache;
 namespace engine::world
 {
 struct Room;
+class RoomGeometry;
 struct Portal;
 } // namespace engine::world
 
@@ -61,6 +66,9 @@ namespace engine
 {
 class ObjectManager;
 class CameraController;
+class BackgroundWorker;
+class ScreenCapture;
+class LightGrid;
 struct AudioSettings;
 
 class Presenter final
@@ -71,12 +79,16 @@ public:
   static const constexpr float DefaultFov = glm::radians(60.0f);
   static const constexpr core::Frame DefaultHealthBarTimeout = core::FrameRate * 1_sec * 4 / 3;
 
-  explicit Presenter(const std::filesystem::path& engineDataPath, const glm::ivec2& resolution);
+  explicit Presenter(const std::filesystem::path& engineDataPath,
+                     const std::filesystem::path& userDataPath,
+                     const glm::ivec2& resolution,
+                     bool headless);
   ~Presenter();
 
   void playVideo(const std::filesystem::path& path);
 
   void renderWorld(const std::vector<world::Room>& rooms,
+                   world::RoomGeometry& roomGeometry,
                    const CameraController& cameraController,
                    const std::unordered_set<const world::Portal*>& waterEntryPortals);
 
@@ -128,12 +140,18 @@ public:
     return *m_renderer;
   }
 
+  [[nodiscard]] auto& getGpuProfiler()
+  {
+    return *m_gpuProfiler;
+  }
+
   void renderScreenOverlay();
   void renderUi(ui::Ui& ui, float alpha);
 
   void apply(const render::RenderSettings& renderSettings, const AudioSettings& audioSettings);
 
   void drawLoadingScreen(const std::string& state);
+  void warmUpShaders();
   bool preFrame();
   [[nodiscard]] bool shouldClose() const;
 
@@ -150,6 +168,11 @@ public:
     m_window->setFullscreen(value);
   }
 
+  void setVsync(bool enabled)
+  {
+    m_window->setVsync(enabled);
+  }
+
   [[nodiscard]] const auto& getDisplayViewport() const
   {
     return m_window->getViewport();
@@ -159,7 +182,14 @@ public:
 
   [[nodiscard]] glm::ivec2 getUiViewport() const;
 
-  [[nodiscard]] gl::CImgWrapper takeScreenshot() const;
+  //! Captures the displayed frame without stalling; @a onCaptured is invoked on the background worker.
+  void takeScreenshot(std::function<void(gl::CImgWrapper& image)> onCaptured);
+
+  //! Runs tasks off the game loop, in the order they were posted.
+  [[nodiscard]] const auto& getBackgroundWorker() const
+  {
+    return m_backgroundWorker;
+  }
 
   void disableScreenOverlay();
 
@@ -169,6 +199,7 @@ private:
   const std::unique_ptr<gl::Window> m_window;
   uint8_t m_renderResolutionDivisor = 1;
   uint8_t m_uiScale = 1;
+  size_t m_lightCollectionDepth = 1;
 
   std::shared_ptr<audio::SoundEngine> m_soundEngine;
   const gslu::nn_shared<render::scene::Renderer> m_renderer;
@@ -186,7 +217,12 @@ private:
   const gslu::nn_unique<render::scene::MaterialManager> m_materialManager;
   gslu::nn_shared<render::scene::CSM> m_csm;
 
+  const gslu::nn_shared<render::GpuProfiler> m_gpuProfiler;
+  const gslu::nn_shared<BackgroundWorker> m_backgroundWorker;
+  const gslu::nn_unique<ScreenCapture> m_screenCapture;
   const gslu::nn_unique<render::RenderPipeline> m_renderPipeline;
+  const gslu::nn_unique<render::OcclusionCuller> m_occlusionCuller;
+  const gslu::nn_unique<LightGrid> m_lightGrid;
   std::unique_ptr<render::scene::ScreenOverlay> m_screenOverlay;
 
   void scaleSplashImage();
@@ -0,0 +1,115 @@
+#include "screencapture.h"
+
+#include "backgroundworker.h"
+
+#include <boost/log/trivial.hpp>
+#include <chrono>
+#include <exception>
+#include <gl/api/gl.hpp>
+#include <gl/cimgwrapper.h>
+#include <gl/framebuffer.h>
+#include <gl/glassert.h>
+#include <gsl/gsl-lite.hpp>
+#include <utility>
+
+namespace engine
+{
+namespace
+{
+void process(const gsl::span<uint8_t>& pixels, const glm::ivec2& size, const ScreenCapture::Callback& callback)
+{
+  gl::CImgWrapper img{pixels.data(), size.x, size.y, false};
+  img.fromScreenshot();
+  callback(img);
+}
+} // namespace
+
+ScreenCapture::ScreenCapture(gslu::nn_shared<BackgroundWorker> worker)
+    : m_worker{std::move(worker)}
+{
+}
+
+ScreenCapture::~ScreenCapture()
+{
+  for(auto& capture : m_captures)
+  {
+    if(capture.processed.has_value())
+    {
+      capture.processed->wait();
+    }
+    else
+    {
+      // don't lose captures taken right before shutting down
+      capture.fence->clientWait();
+      try
+      {
+        process(capture.buffer->map(), capture.size, capture.callback);
+      }
+      catch(const std::exception& ex)
+      {
+        BOOST_LOG_TRIVIAL(error) << "Failed to process screen capture: " << ex.what();
+      }
+    }
+    capture.buffer->unmap();
+  }
+}
+
+void ScreenCapture::capture(const glm::ivec2& size, Callback callback)
+{
+  auto buffer = gsl::make_unique<gl::PixelPackBuffer<uint8_t>>("screen-capture");
+  buffer->allocate(gsl::narrow<size_t>(size.x) * gsl::narrow<size_t>(size.y) * 4u, gl::api::BufferUsage::StreamRead);
+
+  // with a pack buffer bound, the pixels are written to the buffer asynchronously instead of client memory
+  buffer->bind();
+  gl::Framebuffer::bindDefaultForReading();
+  GL_ASSERT(gl::api::readPixel(
+    0, 0, size.x, size.y, gl::api::PixelFormat::Rgba, gl::api::PixelType::UnsignedByte, nullptr));
+  buffer->unbind();
+
+  m_captures.emplace_back(
+    Capture{size, std::move(callback), std::move(buffer), gsl::make_unique<gl::FenceSync>(), std::nullopt});
+}
+
+void ScreenCapture::poll()
+{
+  for(auto it = m_captures.begin(); it != m_captures.end();)
+  {
+    auto& capture = *it;
+    if(capture.processed.has_value())
+    {
+      if(capture.processed->wait_for(std::chrono::seconds::zero()) != std::future_status::ready)
+      {
+        ++it;
+        continue;
+      }
+
+      capture.buffer->unmap();
+      it = m_captures.erase(it);
+      continue;
+    }
+
+    if(capture.fence->isSignaled())
+    {
+      // the mapping stays valid until it is released here after the worker is done with it
+      const auto pixels = capture.buffer->map();
+      auto done = std::make_shared<std::promise<void>>();
+      capture.processed = done->get_future();
+      m_worker->post(
+        [pixels, size = capture.size, callback = capture.callback, done]()
+        {
+          try
+          {
+            process(pixels, size, callback);
+            done->set_value();
+          }
+          catch(...)
+          {
+            done->set_exception(std::current_exception());
+            throw;
+          }
+        });
+    }
+    ++it;
+  }
+}
+} // namespace engine
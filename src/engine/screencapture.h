@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <gl/buffer.h>
+#include <gl/fencesync.h>
+#include <gl/soglb_fwd.h>
+#include <glm/vec2.hpp>
+#include <gslu.h>
+#include <list>
+#include <optional>
+
+namespace engine
+{
+class BackgroundWorker;
+
+/**
+ * Reads back the contents of the default framebuffer without stalling: the pixels are transferred into a pixel pack
+ * buffer, and converted to an image on a background worker once a fence signals the end of the transfer.
+ */
+class ScreenCapture final
+{
+public:
+  using Callback = std::function<void(gl::CImgWrapper& image)>;
+
+  explicit ScreenCapture(gslu::nn_shared<BackgroundWorker> worker);
+  //! Waits until all started captures have been processed.
+  ~ScreenCapture();
+
+  ScreenCapture(const ScreenCapture&) = delete;
+  ScreenCapture(ScreenCapture&&) = delete;
+  ScreenCapture& operator=(ScreenCapture&&) = delete;
+  ScreenCapture& operator=(const ScreenCapture&) = delete;
+
+  //! Starts capturing the lower left @a size pixels; @a callback is invoked on the background worker.
+  void capture(const glm::ivec2& size, Callback callback);
+
+  //! Hands finished transfers to the background worker and releases the buffers of processed captures; must be
+  //! called regularly on the thread owning the GL context.
+  void poll();
+
+private:
+  struct Capture
+  {
+    glm::ivec2 size;
+    Callback callback;
+    gslu::nn_unique<gl::PixelPackBuffer<uint8_t>> buffer;
+    gslu::nn_unique<gl::FenceSync> fence;
+    //! Set while the mapped buffer is being processed by the worker.
+    std::optional<std::future<void>> processed{};
+  };
+
+  const gslu::nn_shared<BackgroundWorker> m_worker;
+  std::list<Capture> m_captures;
+};
+} // namespace engine
@@ -6,6 +6,7 @@
 #include "engine/cameracontroller.h"
 #include "engine/engine.h"
 #include "engine/engineconfig.h"
+#include "engine/flythroughbenchmark.h"
 #include "engine/inventory.h"
 #include "engine/location.h"
 #include "engine/objectmanager.h"
@@ -107,8 +108,9 @@ std::vector<std::filesystem::path> Video::getFilepathsIfInvalid(const Engine& en
   return m_paths;
 }
 
-std::pair<RunResult, std::optional<size_t>>
-  Cutscene::run(Engine& engine, const std::shared_ptr<Player>& player, const std::shared_ptr<Player>& levelStartPlayer)
+std::unique_ptr<world::World> Cutscene::loadWorld(Engine& engine,
+                                                  const std::shared_ptr<Player>& player,
+                                                  const std::shared_ptr<Player>& levelStartPlayer)
 {
   auto world
     = std::make_unique<world::World>(engine,
@@ -150,9 +152,25 @@ std::pair<RunResult, std::optional<size_t>>
     }
   }
 
+  return world;
+}
+
+std::pair<RunResult, std::optional<size_t>>
+  Cutscene::run(Engine& engine, const std::shared_ptr<Player>& player, const std::shared_ptr<Player>& levelStartPlayer)
+{
+  auto world = loadWorld(engine, player, levelStartPlayer);
   return engine.run(*world, true, false);
 }
 
+bool Cutscene::runBenchmark(Engine& engine,
+                            FlythroughBenchmark& benchmark,
+                            const std::shared_ptr<Player>& player,
+                            const std::shared_ptr<Player>& levelStartPlayer)
+{
+  auto world = loadWorld(engine, player, levelStartPlayer);
+  return benchmark.runCinematic(*world);
+}
+
 std::vector<std::filesystem::path> Cutscene::getFilepathsIfInvalid(const Engine& engine) const
 {
   if(std::filesystem::is_regular_file(getAssetPath(engine, m_name)))
@@ -236,6 +254,18 @@ std::pair<RunResult, std::optional<size_t>> Level::runFromSave(Engine& engine,
   return engine.run(*world, false, m_allowSave);
 }
 
+bool Level::runBenchmark(Engine& engine,
+                         FlythroughBenchmark& benchmark,
+                         const std::shared_ptr<Player>& player,
+                         const std::shared_ptr<Player>& levelStartPlayer)
+{
+  player->requestedWeaponType = m_defaultWeapon;
+  player->selectedWeaponType = m_defaultWeapon;
+
+  auto world = loadWorld(engine, player, levelStartPlayer, false);
+  return benchmark.runFlythrough(*world);
+}
+
 std::vector<std::filesystem::path> Level::getFilepathsIfInvalid(const Engine& engine) const
 {
   if(std::filesystem::is_regular_file(getAssetPath(engine, m_name)))
@@ -391,6 +421,14 @@ std::pair<RunResult, std::optional<size_t>> LevelSequenceItem::runFromSave(Engin
   BOOST_THROW_EXCEPTION(std::runtime_error("Cannot run from save"));
 }
 
+bool LevelSequenceItem::runBenchmark(Engine&,
+                                     FlythroughBenchmark&,
+                                     const std::shared_ptr<Player>&,
+                                     const std::shared_ptr<Player>&)
+{
+  return true;
+}
+
 std::pair<RunResult, std::optional<size_t>> ModifyInventory::run(Engine& /*engine*/,
                                                                  const std::shared_ptr<Player>& player,
                                                                  const std::shared_ptr<Player>& /*levelStartPlayer*/)
@@ -26,6 +26,7 @@ namespace engine
 enum class RunResult;
 enum class WeaponType;
 class Engine;
+class FlythroughBenchmark;
 class Player;
 } // namespace engine
 
@@ -83,6 +84,12 @@ public:
                                                                   const std::optional<size_t>& /*slot*/,
                                                                   const std::shared_ptr<Player>& /*player*/,
                                                                   const std::shared_ptr<Player>& /*levelStartPlayer*/);
+  //! Loads and renders the world of this item with @a benchmark, if there is one; returns false if the benchmark
+  //! was cancelled.
+  virtual bool runBenchmark(Engine& /*engine*/,
+                            FlythroughBenchmark& /*benchmark*/,
+                            const std::shared_ptr<Player>& /*player*/,
+                            const std::shared_ptr<Player>& /*levelStartPlayer*/);
 
   [[nodiscard]] virtual bool isLevel(const std::filesystem::path& path) const = 0;
   [[nodiscard]] virtual std::vector<std::filesystem::path> getFilepathsIfInvalid(const Engine& engine) const = 0;
@@ -130,6 +137,10 @@ public:
                                                           const std::optional<size_t>& slot,
                                                           const std::shared_ptr<Player>& player,
                                                           const std::shared_ptr<Player>& levelStartPlayer) override;
+  bool runBenchmark(Engine& engine,
+                    FlythroughBenchmark& benchmark,
+                    const std::shared_ptr<Player>& player,
+                    const std::shared_ptr<Player>& levelStartPlayer) override;
 
   [[nodiscard]] bool isLevel(const std::filesystem::path& path) const override;
 
@@ -222,6 +233,9 @@ private:
   const std::optional<core::Length> m_cameraPosX;
   const std::optional<core::Length> m_cameraPosZ;
 
+  [[nodiscard]] std::unique_ptr<world::World>
+    loadWorld(Engine& engine, const std::shared_ptr<Player>& player, const std::shared_ptr<Player>& levelStartPlayer);
+
 public:
   explicit Cutscene(std::string name,
                     TR1TrackId track,
@@ -254,6 +268,10 @@ public:
   std::pair<RunResult, std::optional<size_t>> run(Engine& engine,
                                                   const std::shared_ptr<Player>& player,
                                                   const std::shared_ptr<Player>& levelStartPlayer) override;
+  bool runBenchmark(Engine& engine,
+                    FlythroughBenchmark& benchmark,
+                    const std::shared_ptr<Player>& player,
+                    const std::shared_ptr<Player>& levelStartPlayer) override;
 
   [[nodiscard]] bool isLevel(const std::filesystem::path& /*path*/) const override
   {
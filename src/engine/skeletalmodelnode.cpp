@@ -103,6 +103,16 @@ void SkeletalModelNode::updatePose(const InterpolationInfo& framePair)
   BOOST_ASSERT(framePair.firstFrame->numValues > 0);
   BOOST_ASSERT(framePair.secondFrame->numValues > 0);
 
+  {
+    // keyframe boxes are not always tight around the posed meshes, so leave some room
+    core::BoundingBox bbox{framePair.firstFrame->bbox.toBBox(), framePair.secondFrame->bbox.toBBox(), framePair.bias};
+    bbox.x = bbox.x.broadened(bbox.x.size() / 2);
+    bbox.y = bbox.y.broadened(bbox.y.size() / 2);
+    bbox.z = bbox.z.broadened(bbox.z.size() / 2);
+    const auto [min, max] = bbox.toRenderSystem();
+    setLocalBounds(render::scene::BoundingBox{min, max});
+  }
+
   const auto angleDataFirst = framePair.firstFrame->getAngleData();
   std::stack<glm::mat4> transformsFirst;
   transformsFirst.push(glm::translate(glm::mat4{1.0f}, framePair.firstFrame->pos.toGl())
@@ -314,28 +324,6 @@ void SkeletalModelNode::rebuildMesh()
     setRenderable(compositor.toMesh(*m_world->getPresenter().getMaterialManager(), true, m_shadowCaster, getName()));
 }
 
-bool SkeletalModelNode::canBeCulled(const glm::mat4& viewProjection) const
-{
-  auto bbox = getInterpolationInfo().firstFrame->bbox.toBBox();
-  bbox.x = bbox.x.broadened(bbox.x.size() / 2);
-  bbox.y = bbox.x.broadened(bbox.y.size() / 2);
-  bbox.z = bbox.x.broadened(bbox.z.size() / 2);
-
-  glm::vec2 min{1000.0f}, max{-1000.0f};
-  for(const auto& x : {bbox.x.min, bbox.x.max})
-    for(const auto& y : {bbox.y.min, bbox.y.max})
-      for(const auto& z : {bbox.z.min, bbox.z.max})
-      {
-        const auto v = core::TRVec{x, y, z}.toRenderSystem();
-        auto proj = viewProjection * getModelMatrix() * glm::vec4{v, 1.0f};
-        proj /= proj.w;
-        min = glm::min(min, glm::vec2{proj});
-        max = glm::max(max, glm::vec2{proj});
-      }
-
-  return min.x > 1 || min.y > 1 || max.x < -1 || max.y < -1;
-}
-
 void SkeletalModelNode::setAnim(const gsl::not_null<const world::Animation*>& anim,
                                 const std::optional<core::Frame>& frame)
 {
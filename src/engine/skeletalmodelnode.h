@@ -133,8 +133,6 @@ public:
 
   void rebuildMesh();
 
-  [[nodiscard]] bool canBeCulled(const glm::mat4& viewProjection) const override;
-
   void setMeshPart(size_t idx, const std::shared_ptr<world::RenderMeshData>& mesh)
   {
     m_meshParts.at(idx).mesh = mesh;
@@ -207,10 +207,8 @@ RenderMeshData::RenderMeshData(const loader::file::Mesh& mesh,
   }
 }
 
-gslu::nn_shared<render::scene::Mesh> RenderMeshDataCompositor::toMesh(render::scene::MaterialManager& materialManager,
-                                                                      bool skeletal,
-                                                                      bool shadowCaster,
-                                                                      const std::string& label)
+gslu::nn_shared<RenderMeshDataCompositor::VertexArray>
+  RenderMeshDataCompositor::createVertexArray(const std::vector<const gl::Program*>& programs, const std::string& label)
 {
   auto vb = gsl::make_shared<gl::VertexBuffer<RenderMeshData::RenderVertex>>(RenderMeshData::RenderVertex::getLayout(),
                                                                              label);
@@ -225,17 +223,22 @@ gslu::nn_shared<render::scene::Mesh> RenderMeshDataCompositor::toMesh(render::sc
   auto indexBuffer = gsl::make_shared<gl::ElementArrayBuffer<RenderMeshData::IndexType>>(label);
   indexBuffer->setData(m_indices, gl::api::BufferUsage::StaticDraw);
 
-  const auto material = materialManager.getGeometry(false, skeletal, false);
+  return gsl::make_shared<VertexArray>(indexBuffer, vb, programs, label);
+}
+
+gslu::nn_shared<render::scene::Mesh> RenderMeshDataCompositor::toMesh(render::scene::MaterialManager& materialManager,
+                                                                      bool skeletal,
+                                                                      bool shadowCaster,
+                                                                      const std::string& label)
+{
+  const auto material = materialManager.getGeometry(false, skeletal, false, false);
   const auto materialCSMDepthOnly = materialManager.getCSMDepthOnly(skeletal);
-  const auto materialDepthOnly = materialManager.getDepthOnly(skeletal);
-
-  auto va = gsl::make_shared<gl::VertexArray<RenderMeshData::IndexType, RenderMeshData::RenderVertex>>(
-    indexBuffer,
-    vb,
-    std::vector<const gl::Program*>{&material->getShaderProgram()->getHandle(),
-                                    &materialDepthOnly->getShaderProgram()->getHandle(),
-                                    &materialCSMDepthOnly->getShaderProgram()->getHandle()},
-    label);
+  const auto materialDepthOnly = materialManager.getDepthOnly(skeletal, false);
+
+  auto va = createVertexArray({&material->getShaderProgram()->getHandle(),
+                               &materialDepthOnly->getShaderProgram()->getHandle(),
+                               &materialCSMDepthOnly->getShaderProgram()->getHandle()},
+                              label);
   auto mesh = gsl::make_shared<render::scene::MeshImpl<RenderMeshData::IndexType, RenderMeshData::RenderVertex>>(
     va, gl::api::PrimitiveType::Triangles);
 
@@ -253,4 +256,26 @@ gslu::nn_shared<render::scene::Mesh> RenderMeshDataCompositor::toMesh(render::sc
 
   return mesh;
 }
+
+gslu::nn_shared<render::scene::Mesh>
+  RenderMeshDataCompositor::toInstancedMesh(render::scene::MaterialManager& materialManager, const std::string& label)
+{
+  const auto material = materialManager.getGeometry(false, false, true, false);
+  const auto materialDepthOnly = materialManager.getDepthOnly(false, true);
+
+  auto va = createVertexArray(
+    {&material->getShaderProgram()->getHandle(), &materialDepthOnly->getShaderProgram()->getHandle()}, label);
+  auto mesh = gsl::make_shared<render::scene::MeshImpl<RenderMeshData::IndexType, RenderMeshData::RenderVertex>>(
+    va, gl::api::PrimitiveType::Triangles);
+
+  mesh->getMaterialGroup()
+    .set(render::scene::RenderMode::Full, material)
+    .set(render::scene::RenderMode::DepthOnly, materialDepthOnly);
+
+  mesh->getRenderState().setDepthTest(true);
+  mesh->getRenderState().setDepthWrite(true);
+  mesh->getRenderState().setDepthFunction(gl::api::DepthFunction::Less);
+
+  return mesh;
+}
 } // namespace engine::world
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <gl/api/gl.hpp>
 #include <gl/pixel.h>
+#include <gl/vertexarray.h>
 #include <gl/vertexbuffer.h>
 #include <glm/ext/scalar_int_sized.hpp>
 #include <glm/fwd.hpp>
@@ -125,12 +126,21 @@ public:
   gslu::nn_shared<render::scene::Mesh>
     toMesh(render::scene::MaterialManager& materialManager, bool skeletal, bool shadowCaster, const std::string& label);
 
+  //! Creates a non-skeletal mesh that is meant to be drawn through a @c render::scene::InstancedMesh.
+  gslu::nn_shared<render::scene::Mesh> toInstancedMesh(render::scene::MaterialManager& materialManager,
+                                                       const std::string& label);
+
   [[nodiscard]] bool empty() const
   {
     return m_vertices.empty() || m_indices.empty();
   }
 
 private:
+  using VertexArray = gl::VertexArray<RenderMeshData::IndexType, RenderMeshData::RenderVertex>;
+
+  gslu::nn_shared<VertexArray> createVertexArray(const std::vector<const gl::Program*>& programs,
+                                                 const std::string& label);
+
   std::vector<RenderMeshData::RenderVertex> m_vertices{};
   std::vector<RenderMeshData::IndexType> m_indices{};
   glm::int32_t m_boneIndex = 0;
@@ -5,28 +5,30 @@
 #include "core/angle.h"
 #include "core/containeroffset.h"
 #include "core/genericvec.h"
-#include "core/i18n.h"
 #include "core/id.h"
 #include "engine/engine.h"
 #include "engine/engineconfig.h"
+#include "engine/lightgrid.h"
 #include "engine/lighting.h"
 #include "engine/location.h"
 #include "engine/objects/object.h"
 #include "engine/objects/objectstate.h"
-#include "engine/presenter.h"
 #include "loader/file/datatypes.h"
 #include "loader/file/primitives.h"
 #include "loader/file/texture.h"
+#include "render/occlusionculler.h"
 #include "render/rendersettings.h"
 #include "render/scene/material.h"
 #include "render/scene/materialgroup.h"
 #include "render/scene/materialmanager.h"
 #include "render/scene/mesh.h"
+#include "render/scene/instancedmesh.h"
 #include "render/scene/names.h"
 #include "render/scene/node.h"
+#include "render/scene/proceduralmesh.h"
 #include "render/scene/rendermode.h"
 #include "render/scene/shaderprogram.h"
-#include "render/textureanimator.h"
+#include "roomgeometry.h"
 #include "sector.h"
 #include "serialization/serialization.h"
 #include "serialization/vector.h"
@@ -36,9 +38,13 @@
 #include "util.h"
 #include "world.h"
 
+#include <algorithm>
+#include <array>
 #include <boost/assert.hpp>
 #include <boost/log/trivial.hpp>
+#include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include <exception>
 #include <gl/buffer.h>
 #include <gl/program.h>
@@ -52,12 +58,14 @@
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
+#include <glm/vector_relational.hpp>
 #include <gslu.h>
 #include <initializer_list>
 #include <iosfwd>
 #include <iterator>
 #include <limits>
-#include <set>
+#include <map>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -66,80 +74,59 @@ namespace engine::world
 {
 namespace
 {
-#pragma pack(push, 1)
-
-struct RenderVertex
+//! Collects room-space instances of a mesh to draw them with a single instanced draw call.
+struct InstanceBatch
 {
-  glm::vec3 position{};
-  glm::vec4 color{1.0f};
-  glm::vec3 normal{0.0f};
-  glm::int32 isQuad{0};
-  glm::vec3 quadVert1{};
-  glm::vec3 quadVert2{};
-  glm::vec3 quadVert3{};
-  glm::vec3 quadVert4{};
-  glm::vec4 reflective{};
-
-  static const gl::VertexLayout<RenderVertex>& getLayout()
+  gslu::nn_shared<render::scene::Mesh> mesh;
+  std::vector<render::scene::Instance> instances{};
+  std::optional<render::scene::BoundingBox> bounds{};
+
+  void add(const glm::mat4& modelMatrix, const float lightAmbient, const render::scene::BoundingBox& localBounds)
   {
-    static const gl::VertexLayout<RenderVertex> layout{
-      {VERTEX_ATTRIBUTE_POSITION_NAME, &RenderVertex::position},
-      {VERTEX_ATTRIBUTE_NORMAL_NAME, &RenderVertex::normal},
-      {VERTEX_ATTRIBUTE_COLOR_NAME, &RenderVertex::color},
-      {VERTEX_ATTRIBUTE_IS_QUAD, &RenderVertex::isQuad},
-      {VERTEX_ATTRIBUTE_QUAD_VERT1, &RenderVertex::quadVert1},
-      {VERTEX_ATTRIBUTE_QUAD_VERT2, &RenderVertex::quadVert2},
-      {VERTEX_ATTRIBUTE_QUAD_VERT3, &RenderVertex::quadVert3},
-      {VERTEX_ATTRIBUTE_QUAD_VERT4, &RenderVertex::quadVert4},
-      {VERTEX_ATTRIBUTE_REFLECTIVE_NAME, &RenderVertex::reflective},
-    };
-
-    return layout;
+    instances.emplace_back(render::scene::Instance{modelMatrix, lightAmbient});
+    const auto instanceBounds = localBounds.transformed(modelMatrix);
+    if(bounds.has_value())
+      bounds->extend(instanceBounds);
+    else
+      bounds = instanceBounds;
   }
-};
 
-#pragma pack(pop)
-
-struct RenderMesh
-{
-  using IndexType = uint16_t;
-  std::vector<IndexType> m_indices;
-  std::shared_ptr<render::scene::Material> m_materialFull;
-  std::shared_ptr<render::scene::Material> m_materialCSMDepthOnly;
-  std::shared_ptr<render::scene::Material> m_materialDepthOnly;
-
-  std::shared_ptr<render::scene::Mesh>
-    toMesh(const gslu::nn_shared<gl::VertexBuffer<RenderVertex>>& vbuf,
-           const gslu::nn_shared<gl::VertexBuffer<render::TextureAnimator::AnimatedUV>>& uvBuf,
-           const std::string& label)
+  [[nodiscard]] gslu::nn_shared<render::scene::Node>
+    createNode(const std::string& label,
+               const gslu::nn_shared<gl::ShaderStorageBuffer<ShaderLight>>& lights,
+               const gslu::nn_shared<gl::ShaderStorageBuffer<uint32_t>>& lightGrid) const
   {
-#ifndef NDEBUG
-    for(auto idx : m_indices)
-    {
-      BOOST_ASSERT(idx < vbuf->size());
-    }
-#endif
-
-    auto indexBuffer = gsl::make_shared<gl::ElementArrayBuffer<IndexType>>(label);
-    indexBuffer->setData(m_indices, gl::api::BufferUsage::StaticDraw);
-
-    auto vBufs = std::make_tuple(vbuf, uvBuf);
-
-    auto mesh = std::make_shared<render::scene::MeshImpl<IndexType, RenderVertex, render::TextureAnimator::AnimatedUV>>(
-      gsl::make_shared<gl::VertexArray<IndexType, RenderVertex, render::TextureAnimator::AnimatedUV>>(
-        indexBuffer,
-        vBufs,
-        std::vector{&m_materialFull->getShaderProgram()->getHandle(),
-                    m_materialDepthOnly == nullptr ? nullptr : &m_materialDepthOnly->getShaderProgram()->getHandle(),
-                    m_materialCSMDepthOnly == nullptr ? nullptr
-                                                      : &m_materialCSMDepthOnly->getShaderProgram()->getHandle()},
-        label));
-    mesh->getMaterialGroup()
-      .set(render::scene::RenderMode::Full, m_materialFull)
-      .set(render::scene::RenderMode::CSMDepthOnly, m_materialCSMDepthOnly)
-      .set(render::scene::RenderMode::DepthOnly, m_materialDepthOnly);
-
-    return mesh;
+    auto renderable = gsl::make_shared<render::scene::InstancedMesh>(mesh);
+    renderable->setInstanceCount(gsl::narrow<gl::api::core::SizeType>(instances.size()));
+
+    auto instanceBuffer = gsl::make_shared<gl::ShaderStorageBuffer<render::scene::Instance>>(label + "-instances");
+    instanceBuffer->setData(instances, gl::api::BufferUsage::StaticDraw);
+
+    auto node = gsl::make_shared<render::scene::Node>(label);
+    node->setRenderable(renderable);
+    node->setLocalBounds(bounds);
+    node->bind("InstanceData",
+               [instanceBuffer](const render::scene::Node* /*node*/,
+                                const render::scene::Mesh& /*mesh*/,
+                                gl::ShaderStorageBlock& shaderStorageBlock)
+               {
+                 shaderStorageBlock.bind(*instanceBuffer);
+               });
+    node->bind("b_lights",
+               [lights](const render::scene::Node* /*node*/,
+                        const render::scene::Mesh& /*mesh*/,
+                        gl::ShaderStorageBlock& shaderStorageBlock)
+               {
+                 shaderStorageBlock.bind(*lights);
+               });
+    node->bind("b_lightGrid",
+               [lightGrid](const render::scene::Node* /*node*/,
+                           const render::scene::Mesh& /*mesh*/,
+                           gl::ShaderStorageBlock& shaderStorageBlock)
+               {
+                 shaderStorageBlock.bind(*lightGrid);
+               });
+    return node;
   }
 };
 
@@ -160,7 +147,9 @@ core::TRVec getCenter(const std::array<loader::file::VertexIndex, N>& faceVertic
 }
 } // namespace
 
-void Portal::buildMesh(const loader::file::Portal& srcPortal, const gslu::nn_shared<render::scene::Material>& material)
+void Portal::buildMesh(const loader::file::Portal& srcPortal,
+                       const gslu::nn_shared<render::scene::Material>& material,
+                       const gslu::nn_shared<render::scene::Material>& occlusionMaterial)
 {
   struct Vertex
   {
@@ -184,34 +173,27 @@ void Portal::buildMesh(const loader::file::Portal& srcPortal, const gslu::nn_sha
   indexBuffer->setData(indices, gl::api::BufferUsage::StaticDraw);
 
   auto vao = gsl::make_shared<gl::VertexArray<uint16_t, Vertex>>(
-    indexBuffer, vb, std::vector{&material->getShaderProgram()->getHandle()}, "portal");
+    indexBuffer,
+    vb,
+    std::vector{&material->getShaderProgram()->getHandle(), &occlusionMaterial->getShaderProgram()->getHandle()},
+    "portal");
   mesh = std::make_shared<render::scene::MeshImpl<uint16_t, Vertex>>(vao);
   mesh->getMaterialGroup().set(render::scene::RenderMode::DepthOnly, material);
+
+  auto occlusionMesh = gsl::make_shared<render::scene::MeshImpl<uint16_t, Vertex>>(vao);
+  occlusionMesh->getMaterialGroup().set(render::scene::RenderMode::DepthOnly, occlusionMaterial);
+  occlusionQuery = std::make_shared<render::PortalOcclusionQuery>(occlusionMesh);
 }
 
 void Room::createSceneNode(const loader::file::Room& srcRoom,
                            const size_t roomId,
                            World& world,
-                           render::TextureAnimator& animator,
+                           RoomGeometry& roomGeometry,
                            render::scene::MaterialManager& materialManager)
 {
-  RenderMesh renderMesh;
-  renderMesh.m_materialDepthOnly = materialManager.getDepthOnly(false);
-  renderMesh.m_materialCSMDepthOnly = nullptr;
-  renderMesh.m_materialFull = materialManager.getGeometry(isWaterRoom, false, true);
-
-  std::vector<RenderVertex> vbufData;
-  std::vector<render::TextureAnimator::AnimatedUV> uvCoordsData;
-
-  const auto label = "Room:" + std::to_string(roomId);
-  auto vbuf = gsl::make_shared<gl::VertexBuffer<RenderVertex>>(RenderVertex::getLayout(), label);
-
-  static const gl::VertexLayout<render::TextureAnimator::AnimatedUV> uvAttribs{
-    {VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME, gl::VertexAttribute{&render::TextureAnimator::AnimatedUV::uv}},
-    {VERTEX_ATTRIBUTE_QUAD_UV12, &render::TextureAnimator::AnimatedUV::quadUv12},
-    {VERTEX_ATTRIBUTE_QUAD_UV34, &render::TextureAnimator::AnimatedUV::quadUv34},
-  };
-  auto uvCoords = gsl::make_shared<gl::VertexBuffer<render::TextureAnimator::AnimatedUV>>(uvAttribs, label + "-uv");
+  std::vector<RoomRenderVertex> vbufData;
+  std::vector<RoomGeometry::IndexType> roomIndices;
+  std::vector<RoomQuad> roomQuads;
 
   for(const loader::file::QuadFace& quad : srcRoom.rectangles)
   {
@@ -239,58 +221,52 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
       }
     }
 
-    const auto& tile = world.getAtlasTiles().at(quad.tileId.get());
+    Expects(quad.tileId.get() < world.getAtlasTiles().size());
 
     bool useQuadHandling = isDistortedQuad(quad.vertices[0].from(srcRoom.vertices).position.toRenderSystem(),
                                            quad.vertices[1].from(srcRoom.vertices).position.toRenderSystem(),
                                            quad.vertices[2].from(srcRoom.vertices).position.toRenderSystem(),
                                            quad.vertices[3].from(srcRoom.vertices).position.toRenderSystem());
 
-    const auto firstVertex = vbufData.size();
+    size_t quadRef = 0;
+    if(useQuadHandling)
+    {
+      RoomQuad& roomQuad = roomQuads.emplace_back();
+      for(size_t i = 0; i < 4; ++i)
+        roomQuad.vertices[i] = glm::vec4{quad.vertices[i].from(srcRoom.vertices).position.toRenderSystem(), 1.0f};
+      quadRef = roomQuads.size();
+    }
+
+    std::array<RoomGeometry::IndexType, 4> vertexIndices{};
     for(int i = 0; i < 4; ++i)
     {
-      RenderVertex iv;
-      iv.position = quad.vertices[i].from(srcRoom.vertices).position.toRenderSystem();
-      iv.color = quad.vertices[i].from(srcRoom.vertices).color;
-
-      uvCoordsData.emplace_back(tile.textureKey.tileAndFlag & loader::file::TextureIndexMask,
-                                tile.uvCoordinates[i],
-                                glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]},
-                                glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]});
-      if(useQuadHandling)
-      {
-        iv.isQuad = 1;
-        iv.quadVert1 = quad.vertices[0].from(srcRoom.vertices).position.toRenderSystem();
-        iv.quadVert2 = quad.vertices[1].from(srcRoom.vertices).position.toRenderSystem();
-        iv.quadVert3 = quad.vertices[2].from(srcRoom.vertices).position.toRenderSystem();
-        iv.quadVert4 = quad.vertices[3].from(srcRoom.vertices).position.toRenderSystem();
-      }
+      RoomRenderVertex iv;
+      iv.setPosition(quad.vertices[i].from(srcRoom.vertices).position);
+      iv.setColor(quad.vertices[i].from(srcRoom.vertices).color);
+      iv.setTile(quad.tileId, i, quadRef);
 
       if(i <= 2)
       {
         static const std::array<int, 3> indices{0, 1, 2};
-        iv.normal = generateNormal(quad.vertices[indices[(i + 0) % 3]].from(srcRoom.vertices).position,
-                                   quad.vertices[indices[(i + 1) % 3]].from(srcRoom.vertices).position,
-                                   quad.vertices[indices[(i + 2) % 3]].from(srcRoom.vertices).position);
+        iv.setNormal(generateNormal(quad.vertices[indices[(i + 0) % 3]].from(srcRoom.vertices).position,
+                                    quad.vertices[indices[(i + 1) % 3]].from(srcRoom.vertices).position,
+                                    quad.vertices[indices[(i + 2) % 3]].from(srcRoom.vertices).position));
       }
       else
       {
         static const std::array<int, 3> indices{0, 2, 3};
-        iv.normal = generateNormal(quad.vertices[indices[(i + 0) % 3]].from(srcRoom.vertices).position,
-                                   quad.vertices[indices[(i + 1) % 3]].from(srcRoom.vertices).position,
-                                   quad.vertices[indices[(i + 2) % 3]].from(srcRoom.vertices).position);
+        iv.setNormal(generateNormal(quad.vertices[indices[(i + 0) % 3]].from(srcRoom.vertices).position,
+                                    quad.vertices[indices[(i + 1) % 3]].from(srcRoom.vertices).position,
+                                    quad.vertices[indices[(i + 2) % 3]].from(srcRoom.vertices).position));
       }
 
+      vertexIndices[i] = gsl::narrow<RoomGeometry::IndexType>(vbufData.size());
       vbufData.emplace_back(iv);
     }
 
     for(int i : {0, 1, 2, 0, 2, 3})
     {
-      renderMesh.m_indices.emplace_back(gsl::narrow<RenderMesh::IndexType>(firstVertex + i));
-    }
-    for(int i : {0, 1, 2, 3})
-    {
-      animator.registerVertex(quad.tileId, uvCoords, i, firstVertex + i);
+      roomIndices.emplace_back(vertexIndices[i]);
     }
   }
   for(const loader::file::Triangle& tri : srcRoom.triangles)
@@ -311,120 +287,103 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
       }
     }
 
-    const auto& tile = world.getAtlasTiles().at(tri.tileId.get());
+    Expects(tri.tileId.get() < world.getAtlasTiles().size());
 
-    const auto firstVertex = vbufData.size();
     for(int i = 0; i < 3; ++i)
     {
-      RenderVertex iv;
-      iv.position = tri.vertices[i].from(srcRoom.vertices).position.toRenderSystem();
-      iv.color = tri.vertices[i].from(srcRoom.vertices).color;
-      uvCoordsData.emplace_back(tile.textureKey.tileAndFlag & loader::file::TextureIndexMask,
-                                tile.uvCoordinates[i],
-                                glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]},
-                                glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]});
+      RoomRenderVertex iv;
+      iv.setPosition(tri.vertices[i].from(srcRoom.vertices).position);
+      iv.setColor(tri.vertices[i].from(srcRoom.vertices).color);
+      iv.setTile(tri.tileId, i, 0);
 
       static const std::array<int, 3> indices{0, 1, 2};
-      iv.normal = generateNormal(tri.vertices[indices[(i + 0) % 3]].from(srcRoom.vertices).position,
-                                 tri.vertices[indices[(i + 1) % 3]].from(srcRoom.vertices).position,
-                                 tri.vertices[indices[(i + 2) % 3]].from(srcRoom.vertices).position);
-
-      vbufData.push_back(iv);
-    }
+      iv.setNormal(generateNormal(tri.vertices[indices[(i + 0) % 3]].from(srcRoom.vertices).position,
+                                  tri.vertices[indices[(i + 1) % 3]].from(srcRoom.vertices).position,
+                                  tri.vertices[indices[(i + 2) % 3]].from(srcRoom.vertices).position));
 
-    for(int i : {0, 1, 2})
-    {
-      renderMesh.m_indices.emplace_back(gsl::narrow<RenderMesh::IndexType>(firstVertex + i));
-    }
-    for(int i : {0, 1, 2})
-    {
-      animator.registerVertex(tri.tileId, uvCoords, i, firstVertex + i);
+      roomIndices.emplace_back(gsl::narrow<RoomGeometry::IndexType>(vbufData.size()));
+      vbufData.emplace_back(iv);
     }
   }
 
-  vbuf->setData(vbufData, gl::api::BufferUsage::StaticDraw);
-  uvCoords->setData(uvCoordsData, gl::api::BufferUsage::DynamicDraw);
-
-  auto resMesh = renderMesh.toMesh(vbuf, uvCoords, label);
-  resMesh->getRenderState().setCullFace(true);
-  resMesh->getRenderState().setCullFaceSide(gl::api::CullFaceMode::Back);
+  roomGeometry.add(physicalId, isWaterRoom, position.toRenderSystem(), vbufData, roomIndices, roomQuads);
 
+  // the room's geometry is drawn by the room geometry batches, the node only carries the room's transform, bounds
+  // and scissors
   node = std::make_shared<render::scene::Node>("Room:" + std::to_string(roomId));
-  node->setRenderable(resMesh);
-  node->bind("u_lightAmbient",
-             [](const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
-             {
-               uniform.set(1.0f);
-             });
-
-  node->bind("b_lights",
-             [emptyBuffer = ShaderLight::getEmptyBuffer()](const render::scene::Node*,
-                                                           const render::scene::Mesh& /*mesh*/,
-                                                           gl::ShaderStorageBlock& shaderStorageBlock)
-             {
-               shaderStorageBlock.bind(*emptyBuffer);
-             });
+  if(!vbufData.empty())
+  {
+    const glm::vec3 first{vbufData.front().position};
+    render::scene::BoundingBox bounds{first, first};
+    for(const auto& vertex : vbufData)
+    {
+      const glm::vec3 p{vertex.position};
+      bounds.extend({p, p});
+    }
+    node->setLocalBounds(bounds);
+  }
 
+  // static meshes and sprites sharing the same mesh are drawn with a single instanced draw call each
+  std::map<const render::scene::Mesh*, InstanceBatch> staticMeshBatches;
   for(const RoomStaticMesh& sm : staticMeshes)
   {
     if(sm.staticMesh->renderMesh == nullptr)
       continue;
 
-    auto subNode = std::make_shared<render::scene::Node>("staticMesh");
-    subNode->setRenderable(sm.staticMesh->renderMesh);
-    subNode->setLocalMatrix(translate(glm::mat4{1.0f}, (sm.position - position).toRenderSystem())
-                            * rotate(glm::mat4{1.0f}, toRad(sm.rotation), glm::vec3{0, -1, 0}));
-
-    subNode->bind("u_lightAmbient",
-                  [brightness = toBrightness(ambientShade)](
-                    const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
-                  {
-                    uniform.set(brightness.get());
-                  });
-
-    subNode->bind("b_lights",
-                  [this](const render::scene::Node*,
-                         const render::scene::Mesh& /*mesh*/,
-                         gl::ShaderStorageBlock& shaderStorageBlock)
-                  {
-                    shaderStorageBlock.bind(*lightsBuffer);
-                  });
-
-    sceneryNodes.emplace_back(std::move(subNode));
+    auto it = staticMeshBatches.find(sm.staticMesh->renderMesh.get());
+    if(it == staticMeshBatches.end())
+    {
+      it = staticMeshBatches
+             .emplace(sm.staticMesh->renderMesh.get(),
+                      InstanceBatch{gsl::not_null{sm.staticMesh->renderMesh}})
+             .first;
+    }
+
+    const auto [min, max] = sm.staticMesh->visibilityBox.toRenderSystem();
+    it->second.add(translate(glm::mat4{1.0f}, (sm.position - position).toRenderSystem())
+                     * rotate(glm::mat4{1.0f}, toRad(sm.rotation), glm::vec3{0, -1, 0}),
+                   toBrightness(ambientShade).get(),
+                   {min, max});
   }
+  for(const auto& [mesh, batch] : staticMeshBatches)
+    sceneryNodes.emplace_back(
+      batch.createNode("staticMeshes", LightGrid::getLightsBuffer(), LightGrid::getClusterBuffer()));
+
   node->setLocalMatrix(translate(glm::mat4{1.0f}, position.toRenderSystem()));
 
+  std::map<const render::scene::Mesh*, InstanceBatch> spriteBatches;
   for(const loader::file::SpriteInstance& spriteInstance : srcRoom.sprites)
   {
     BOOST_ASSERT(spriteInstance.vertex.get() < srcRoom.vertices.size());
 
     const auto& sprite = world.getSprites().at(spriteInstance.id.get());
+    auto it = spriteBatches.find(sprite.instancedYBoundMesh.get());
+    if(it == spriteBatches.end())
+    {
+      it = spriteBatches
+             .emplace(sprite.instancedYBoundMesh.get(), InstanceBatch{gsl::not_null{sprite.instancedYBoundMesh}})
+             .first;
+    }
 
-    auto spriteNode = std::make_shared<render::scene::Node>("sprite");
-    spriteNode->setRenderable(sprite.yBoundMesh);
+    // y-bound sprites rotate around the y axis to face the camera
+    const auto radius = static_cast<float>(std::max(std::abs(sprite.render0.x), std::abs(sprite.render1.x)));
+    const auto y0 = static_cast<float>(-sprite.render0.y);
+    const auto y1 = static_cast<float>(-sprite.render1.y);
     const auto& v = srcRoom.vertices.at(spriteInstance.vertex.get());
-    spriteNode->setLocalMatrix(translate(glm::mat4{1.0f}, v.position.toRenderSystem()));
-    spriteNode->bind("u_lightAmbient",
-                     [brightness = toBrightness(v.shade)](
-                       const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
-                     {
-                       uniform.set(brightness.get());
-                     });
-    spriteNode->bind("b_lights",
-                     [emptyLightsBuffer = ShaderLight::getEmptyBuffer()](const render::scene::Node*,
-                                                                         const render::scene::Mesh& /*mesh*/,
-                                                                         gl::ShaderStorageBlock& shaderStorageBlock)
-                     {
-                       shaderStorageBlock.bind(*emptyLightsBuffer);
-                     });
-
-    sceneryNodes.emplace_back(std::move(spriteNode));
+    it->second.add(translate(glm::mat4{1.0f}, v.position.toRenderSystem()),
+                   toBrightness(v.shade).get(),
+                   {{-radius, std::min(y0, y1), -radius}, {radius, std::max(y0, y1), radius}});
   }
+  for(const auto& [mesh, batch] : spriteBatches)
+    sceneryNodes.emplace_back(
+      batch.createNode("sprites", ShaderLight::getEmptyBuffer(), LightGrid::getDisabledBuffer()));
 
   std::transform(srcRoom.portals.begin(),
                  srcRoom.portals.end(),
                  std::back_inserter(portals),
-                 [material = materialManager.getWaterSurface(), &world](const loader::file::Portal& portal)
+                 [material = materialManager.getWaterSurface(),
+                  occlusionMaterial = materialManager.getPortalOcclusion(),
+                  &world](const loader::file::Portal& portal)
                  {
                    Portal p{gsl::not_null{&world.getRooms().at(portal.adjoining_room.get())},
                             portal.normal.toRenderSystem(),
@@ -432,13 +391,12 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
                              portal.vertices[1].toRenderSystem(),
                              portal.vertices[2].toRenderSystem(),
                              portal.vertices[3].toRenderSystem()},
+                            nullptr,
                             nullptr};
-                   p.buildMesh(portal, material);
+                   p.buildMesh(portal, material, occlusionMaterial);
                    return p;
                  });
 
-  collectShaderLights(world.getEngine().getEngineConfig()->renderSettings.getLightCollectionDepth());
-
   for(const auto& v : srcRoom.vertices)
   {
     const auto vv = v.position.toRenderSystem();
@@ -446,8 +404,7 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
     verticesBBoxMax = glm::max(verticesBBoxMax, vv);
   }
 
-  regenerateDust(nullptr,
-                 materialManager.getDustParticle(),
+  regenerateDust(materialManager.getDustParticle(),
                  world.getEngine().getEngineConfig()->renderSettings.dustActive,
                  world.getEngine().getEngineConfig()->renderSettings.dustDensity);
 
@@ -541,126 +498,27 @@ const Sector* Room::getSectorByIndex(const int dx, const int dz) const
   return &sectors[sectorCountZ * dx + dz];
 }
 
-void Room::collectShaderLights(size_t depth)
-{
-  bufferLights.clear();
-  if(lights.empty())
-  {
-    lightsBuffer->setData(bufferLights, gl::api::BufferUsage::StaticDraw);
-    return;
-  }
-
-  std::set<gsl::not_null<const Room*>> testRooms;
-  testRooms.emplace(this);
-  for(size_t i = 0; i < depth; ++i)
-  {
-    std::set<gsl::not_null<const Room*>> newTestRooms;
-    for(const auto& room : testRooms)
-    {
-      newTestRooms.emplace(room);
-      for(const auto& portal : room->portals)
-      {
-        newTestRooms.emplace(portal.adjoiningRoom);
-      }
-    }
-    testRooms = std::move(newTestRooms);
-  }
-
-  for(const auto& room : testRooms)
-  {
-    // http://www-f9.ijs.si/~matevz/docs/PovRay/pov274.htm
-    // 1 / ( 1 + (d/fade_distance) ^ fade_power );
-    // assuming fade_power = 1, multiply numerator and denominator with fade_distance (identity transform):
-    // fade_distance / ( fade_distance + d )
-
-    for(const auto& light : room->lights)
-    {
-      if(light.intensity.get() <= 0)
-        continue;
-      bufferLights.emplace_back(ShaderLight{glm::vec4{light.position.toRenderSystem(), 0.0f},
-                                            toBrightness(light.intensity).get(),
-                                            light.fadeDistance.get<float>()});
-    }
-  }
-
-  lightsBuffer->setData(bufferLights, gl::api::BufferUsage::StaticDraw);
-}
-
-void Room::regenerateDust(const std::shared_ptr<engine::Presenter>& presenter,
-                          const gslu::nn_shared<render::scene::Material>& dustMaterial,
+void Room::regenerateDust(const gslu::nn_shared<render::scene::Material>& dustMaterial,
                           bool isDustEnabled,
                           uint8_t dustDensityDivisor)
 {
-  if(!isDustEnabled)
+  if(!isDustEnabled || glm::any(glm::greaterThan(verticesBBoxMin, verticesBBoxMax)))
   {
     dust = nullptr;
     return;
   }
 
-  if(const auto it = dustCache.find(dustDensityDivisor); it != dustCache.end())
-  {
-    dust = it->second;
-    return;
-  }
-  if(presenter != nullptr)
-    presenter->drawLoadingScreen(_("Generating Dust Particles..."));
-  auto dustNode
-    = createParticleMesh(node->getName() + "/dust", verticesBBoxMin, verticesBBoxMax, dustMaterial, dustDensityDivisor);
-  dustCache.emplace(dustDensityDivisor, dustNode);
-  dust = dustNode;
-}
-
-std::shared_ptr<render::scene::Node>
-  Room::createParticleMesh(const std::string& label,
-                           const glm::vec3& min,
-                           const glm::vec3& max,
-                           const gslu::nn_shared<render::scene::Material>& dustMaterial,
-                           uint8_t dustDensityDivisor)
-{
+  // the particles are generated in the vertex shader from the grid parameters, so there is nothing to upload
   static const constexpr auto BaseGridAxisSubdivision = 12;
   const auto resolution = (cbrt(dustDensityDivisor) / BaseGridAxisSubdivision * 1_sectors).cast<float>().get();
-
-  // https://stackoverflow.com/a/3747462
-  static const auto fastrand = []()
-  {
-    static uint32_t seed = 12345;
-    seed = (214013 * seed + 2531011);
-    return static_cast<float>(seed >> 16u) / 0x8000 - 0.5f;
-  };
-
-  std::vector<glm::vec3> vertices;
-  vertices.reserve(std::lround(std::max(0.0f,
-                                        ((max.x - min.x) / resolution - 2) * ((max.y - min.y) / resolution - 2)
-                                          * ((max.z - min.z) / resolution - 2))));
-  std::vector<uint32_t> indices;
-  indices.reserve(vertices.capacity());
-  BOOST_LOG_TRIVIAL(debug) << "generating " << vertices.capacity() << " particles for " << label;
-
-  for(float x = min.x + resolution; x < max.x - resolution; x += resolution)
-  {
-    for(float y = min.y + resolution; y < max.y - resolution; y += resolution)
-    {
-      for(float z = min.z + resolution; z < max.z - resolution; z += resolution)
-      {
-        glm::vec3 p0 = glm::vec3{x, y, z};
-        glm::vec3 offset{fastrand() * resolution, fastrand() * resolution, fastrand() * resolution};
-        vertices.emplace_back(p0 + offset);
-        indices.emplace_back(gsl::narrow_cast<uint32_t>(vertices.size()));
-      }
-    }
-  }
-
-  static const gl::VertexLayout<glm::vec3> layout{
-    {VERTEX_ATTRIBUTE_POSITION_NAME, gl::VertexAttribute<glm::vec3>::Trivial{}}};
-
-  auto vbuf = gsl::make_shared<gl::VertexBuffer<glm::vec3>>(layout, label + "-particles");
-  vbuf->setData(vertices, gl::api::BufferUsage::StaticDraw);
-  auto indexBuffer = gsl::make_shared<gl::ElementArrayBuffer<uint32_t>>(label + "-particles");
-  indexBuffer->setData(indices, gl::api::BufferUsage::StaticDraw);
-
-  auto vao = gsl::make_shared<gl::VertexArray<uint32_t, glm::vec3>>(
-    indexBuffer, vbuf, std::vector{&dustMaterial->getShaderProgram()->getHandle()}, label + "-particles");
-  auto mesh = std::make_shared<render::scene::MeshImpl<uint32_t, glm::vec3>>(vao, gl::api::PrimitiveType::Points);
+  // keep a margin of one grid cell to the room bounds
+  const auto cells = glm::max(glm::floor((verticesBBoxMax - verticesBBoxMin) / resolution) - 1.0f, glm::vec3{0.0f});
+  const auto particleCount = gsl::narrow<gl::api::core::SizeType>(std::lround(cells.x * cells.y * cells.z));
+  BOOST_LOG_TRIVIAL(debug) << "generating " << particleCount << " particles for " << node->getName();
+
+  const auto label = node->getName() + "/dust-particles";
+  auto mesh = std::make_shared<render::scene::ProceduralMesh>(gl::api::PrimitiveType::Points, label);
+  mesh->setVertexCount(particleCount);
   mesh->getMaterialGroup().set(render::scene::RenderMode::Full, dustMaterial);
 
   mesh->bind("u_baseColor",
@@ -669,12 +527,34 @@ std::shared_ptr<render::scene::Node>
              {
                uniform.set(color);
              });
+  mesh->bind("u_dustOrigin",
+             [origin = verticesBBoxMin + resolution](
+               const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
+             {
+               uniform.set(origin);
+             });
+  mesh->bind("u_dustCells",
+             [cells](const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
+             {
+               uniform.set(cells);
+             });
+  mesh->bind(
+    "u_dustResolution",
+    [resolution](const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
+    {
+      uniform.set(resolution);
+    });
+  mesh->bind("u_dustSeed",
+             [seed = gsl::narrow<uint32_t>(physicalId)](
+               const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
+             {
+               uniform.set(seed);
+             });
 
-  auto dustNode = std::make_shared<render::scene::Node>(label + "-particles");
+  auto dustNode = std::make_shared<render::scene::Node>(label);
   dustNode->setLocalMatrix(translate(glm::mat4{1.0f}, position.toRenderSystem()));
   dustNode->setRenderable(mesh);
   dustNode->setVisible(true);
-
-  return dustNode;
+  dust = dustNode;
 }
 } // namespace engine::world
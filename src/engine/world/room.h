@@ -7,6 +7,7 @@
 #include "qs/qs.h"
 #include "sector.h"
 #include "serialization/serialization_fwd.h"
+#include "staticmeshcollisionindex.h"
 
 #include <algorithm>
 #include <array>
@@ -15,7 +16,6 @@
 #include <glm/fwd.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
-#include <map>
 #include <memory>
 #include <optional>
 #include <string>
@@ -23,12 +23,13 @@
 
 namespace engine::world
 {
+class RoomGeometry;
 class World;
-}
+} // namespace engine::world
 
 namespace render
 {
-class TextureAnimator;
+class PortalOcclusionQuery;
 }
 
 namespace render::scene
@@ -53,7 +54,6 @@ struct Room;
 namespace engine
 {
 struct Location;
-class Presenter;
 } // namespace engine
 
 namespace engine::world
@@ -67,8 +67,12 @@ struct Portal
   glm::vec3 normal;
   std::array<glm::vec3, 4> vertices;
   std::shared_ptr<render::scene::Mesh> mesh;
+  //! Occlusion query of the portal quad, drawn with a different material than @c mesh.
+  std::shared_ptr<render::PortalOcclusionQuery> occlusionQuery;
 
-  void buildMesh(const loader::file::Portal& srcPortal, const gslu::nn_shared<render::scene::Material>& material);
+  void buildMesh(const loader::file::Portal& srcPortal,
+                 const gslu::nn_shared<render::scene::Material>& material,
+                 const gslu::nn_shared<render::scene::Material>& occlusionMaterial);
 };
 
 struct Light
@@ -100,13 +104,13 @@ struct Room
   std::vector<Portal> portals{};
   std::vector<Sector> sectors{};
   std::vector<RoomStaticMesh> staticMeshes{};
+  StaticMeshCollisionIndex staticMeshCollisions{};
 
   Room* alternateRoom{nullptr};
 
   std::shared_ptr<render::scene::Node> node = nullptr;
   std::vector<gslu::nn_shared<render::scene::Node>> sceneryNodes{};
 
-  std::map<uint8_t, std::shared_ptr<render::scene::Node>> dustCache{};
   glm::vec3 verticesBBoxMin{std::numeric_limits<float>::max()};
   glm::vec3 verticesBBoxMax{std::numeric_limits<float>::lowest()};
   std::shared_ptr<render::scene::Node> dust = nullptr;
@@ -114,7 +118,7 @@ struct Room
   void createSceneNode(const loader::file::Room& srcRoom,
                        size_t roomId,
                        World&,
-                       render::TextureAnimator& animator,
+                       RoomGeometry& roomGeometry,
                        render::scene::MaterialManager& materialManager);
 
   [[nodiscard]] const Sector* getSectorByAbsolutePosition(const core::TRVec& worldPos) const
@@ -160,22 +164,9 @@ struct Room
 
   void serialize(const serialization::Serializer<World>& ser);
 
-  std::vector<engine::ShaderLight> bufferLights{};
-  gslu::nn_shared<gl::ShaderStorageBuffer<engine::ShaderLight>> lightsBuffer{
-    std::make_shared<gl::ShaderStorageBuffer<engine::ShaderLight>>("lights-buffer")};
-
-  void collectShaderLights(size_t depth);
-  void regenerateDust(const std::shared_ptr<engine::Presenter>& presenter,
-                      const gslu::nn_shared<render::scene::Material>& dustMaterial,
+  void regenerateDust(const gslu::nn_shared<render::scene::Material>& dustMaterial,
                       bool isDustEnabled,
-                      uint8_t dustResolutionDivisor);
-
-private:
-  std::shared_ptr<render::scene::Node> createParticleMesh(const std::string& label,
-                                                          const glm::vec3& min,
-                                                          const glm::vec3& max,
-                                                          const gslu::nn_shared<render::scene::Material>& dustMaterial,
-                                                          uint8_t dustDensity);
+                      uint8_t dustDensityDivisor);
 };
 
 extern void patchHeightsForBlock(const engine::objects::Object& object, const core::Length& height);
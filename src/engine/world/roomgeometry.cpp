@@ -0,0 +1,242 @@
+#include "roomgeometry.h"
+
+#include "engine/lightgrid.h"
+#include "engine/lighting.h"
+#include "render/scene/instancedmesh.h"
+#include "render/scene/material.h"
+#include "render/scene/materialgroup.h"
+#include "render/scene/materialmanager.h"
+#include "render/scene/multidrawmesh.h"
+#include "render/scene/names.h"
+#include "render/scene/node.h"
+#include "render/scene/rendercontext.h"
+#include "render/scene/rendermode.h"
+#include "render/scene/shaderprogram.h"
+#include "render/textureanimator.h"
+#include "room.h"
+
+#include <algorithm>
+#include <gl/debuggroup.h>
+#include <gl/program.h>
+#include <gl/renderstate.h>
+#include <gl/vertexarray.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/mat4x4.hpp>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <tuple>
+
+namespace engine::world
+{
+const gl::VertexLayout<RoomRenderVertex>& RoomRenderVertex::getLayout()
+{
+  static const gl::VertexLayout<RoomRenderVertex> layout{
+    {VERTEX_ATTRIBUTE_POSITION_NAME, &RoomRenderVertex::position},
+    {VERTEX_ATTRIBUTE_NORMAL_NAME, {&RoomRenderVertex::normal, true}},
+    {VERTEX_ATTRIBUTE_COLOR_NAME, {&RoomRenderVertex::color, true}},
+    {VERTEX_ATTRIBUTE_TILE_NAME, &RoomRenderVertex::tile},
+  };
+
+  return layout;
+}
+
+RoomGeometry::RoomGeometry()
+    : m_scissorBuffer{gsl::make_shared<gl::ShaderStorageBuffer<glm::vec4>>("rooms-scissors")}
+{
+}
+
+RoomGeometry::~RoomGeometry() = default;
+
+void RoomGeometry::add(const size_t physicalId,
+                       const bool inWater,
+                       const glm::vec3& position,
+                       const std::vector<RoomRenderVertex>& vertices,
+                       const std::vector<IndexType>& indices,
+                       const std::vector<RoomQuad>& quads)
+{
+  Expects(physicalId == m_draws.size());
+  Expects(m_nodes.empty());
+
+  m_draws.emplace_back(Draw{inWater,
+                            position,
+                            gsl::narrow<uint32_t>(indices.size()),
+                            gsl::narrow<uint32_t>(m_indices.size()),
+                            gsl::narrow<int32_t>(m_vertices.size())});
+
+  // quad references are relative to the room's quads, but the quad buffer is shared by all rooms
+  const auto quadOffset = m_quads.size();
+  for(RoomRenderVertex vertex : vertices)
+  {
+    if(vertex.tile.z > 0)
+      vertex.tile.z = gsl::narrow<uint16_t>(vertex.tile.z + quadOffset);
+    m_vertices.emplace_back(vertex);
+  }
+  m_indices.insert(m_indices.end(), indices.begin(), indices.end());
+  m_quads.insert(m_quads.end(), quads.begin(), quads.end());
+}
+
+void RoomGeometry::upload(render::scene::MaterialManager& materialManager, const render::TextureAnimator& animator)
+{
+  Expects(m_nodes.empty());
+
+  auto vbuf = gsl::make_shared<gl::VertexBuffer<RoomRenderVertex>>(RoomRenderVertex::getLayout(), "rooms");
+  vbuf->setData(m_vertices, gl::api::BufferUsage::StaticDraw);
+
+  // each draw's base instance is its room's draw index, which is passed to the shaders through a per-instance
+  // attribute
+  static const gl::VertexLayout<uint32_t> drawIndexLayout{{"a_drawIndex", gl::VertexAttribute<uint32_t>::Trivial{}}};
+  std::vector<uint32_t> drawIndices(m_draws.size());
+  std::iota(drawIndices.begin(), drawIndices.end(), 0);
+  auto drawIndexBuffer = gsl::make_shared<gl::VertexBuffer<uint32_t>>(drawIndexLayout, "rooms-draw-index", 1);
+  drawIndexBuffer->setData(drawIndices, gl::api::BufferUsage::StaticDraw);
+
+  auto indexBuffer = gsl::make_shared<gl::ElementArrayBuffer<IndexType>>("rooms");
+  indexBuffer->setData(m_indices, gl::api::BufferUsage::StaticDraw);
+
+  auto quadBuffer = gsl::make_shared<gl::ShaderStorageBuffer<RoomQuad>>("rooms-quads");
+  quadBuffer->setData(m_quads, gl::api::BufferUsage::StaticDraw);
+
+  std::vector<render::scene::Instance> instances;
+  std::transform(m_draws.begin(),
+                 m_draws.end(),
+                 std::back_inserter(instances),
+                 [](const Draw& draw)
+                 {
+                   return render::scene::Instance{translate(glm::mat4{1.0f}, draw.position), 1.0f};
+                 });
+  auto instanceBuffer = gsl::make_shared<gl::ShaderStorageBuffer<render::scene::Instance>>("rooms-instances");
+  instanceBuffer->setData(instances, gl::api::BufferUsage::StaticDraw);
+
+  const auto depthOnly = materialManager.getRoomDepthOnly();
+  for(const bool inWater : {false, true})
+  {
+    const auto label = std::string{inWater ? "rooms-water" : "rooms"};
+    const auto geometry = materialManager.getRoomGeometry(inWater);
+
+    auto mesh = std::make_shared<Mesh>(
+      gsl::make_shared<gl::VertexArray<IndexType, RoomRenderVertex, uint32_t>>(
+        indexBuffer,
+        std::tuple{vbuf, drawIndexBuffer},
+        std::vector{&geometry->getShaderProgram()->getHandle(), &depthOnly->getShaderProgram()->getHandle()},
+        label),
+      label + "-commands");
+    mesh->getMaterialGroup()
+      .set(render::scene::RenderMode::Full, geometry)
+      .set(render::scene::RenderMode::DepthOnly, depthOnly);
+    mesh->getRenderState().setCullFace(true);
+    mesh->getRenderState().setCullFaceSide(gl::api::CullFaceMode::Back);
+    // scissors are applied per draw in the shaders
+    mesh->getRenderState().setScissorTest(false);
+
+    auto node = gsl::make_shared<render::scene::Node>(label);
+    node->setRenderable(mesh);
+    node->getRenderState().setScissorTest(false);
+    node->setVisible(false);
+    node->bind("InstanceData",
+               [instanceBuffer](const render::scene::Node* /*node*/,
+                                const render::scene::Mesh& /*mesh*/,
+                                gl::ShaderStorageBlock& shaderStorageBlock)
+               {
+                 shaderStorageBlock.bind(*instanceBuffer);
+               });
+    node->bind("b_drawScissors",
+               [scissorBuffer = m_scissorBuffer](const render::scene::Node* /*node*/,
+                                                 const render::scene::Mesh& /*mesh*/,
+                                                 gl::ShaderStorageBlock& shaderStorageBlock)
+               {
+                 shaderStorageBlock.bind(*scissorBuffer);
+               });
+    node->bind("b_lights",
+               [emptyBuffer = ShaderLight::getEmptyBuffer()](const render::scene::Node* /*node*/,
+                                                             const render::scene::Mesh& /*mesh*/,
+                                                             gl::ShaderStorageBlock& shaderStorageBlock)
+               {
+                 shaderStorageBlock.bind(*emptyBuffer);
+               });
+    node->bind("b_lightGrid",
+               [disabledBuffer = LightGrid::getDisabledBuffer()](const render::scene::Node* /*node*/,
+                                                                 const render::scene::Mesh& /*mesh*/,
+                                                                 gl::ShaderStorageBlock& shaderStorageBlock)
+               {
+                 shaderStorageBlock.bind(*disabledBuffer);
+               });
+    node->bind("b_tiles",
+               [tileBuffer = animator.getTileBuffer()](const render::scene::Node* /*node*/,
+                                                       const render::scene::Mesh& /*mesh*/,
+                                                       gl::ShaderStorageBlock& shaderStorageBlock)
+               {
+                 shaderStorageBlock.bind(*tileBuffer);
+               });
+    node->bind("b_roomQuads",
+               [quadBuffer](const render::scene::Node* /*node*/,
+                            const render::scene::Mesh& /*mesh*/,
+                            gl::ShaderStorageBlock& shaderStorageBlock)
+               {
+                 shaderStorageBlock.bind(*quadBuffer);
+               });
+
+    m_meshes[inWater ? 1 : 0] = mesh;
+    m_nodes.emplace_back(node);
+  }
+
+  // the geometry lives on the gpu from now on
+  m_vertices = {};
+  m_indices = {};
+  m_quads = {};
+}
+
+void RoomGeometry::update(const std::vector<Room>& rooms, const render::scene::RenderContext& context)
+{
+  Expects(!m_nodes.empty());
+
+  std::vector<const Room*> renderRooms;
+  for(const auto& room : rooms)
+  {
+    if(room.node->isVisible() && !room.node->canBeCulled(context, false))
+      renderRooms.emplace_back(&room);
+  }
+  std::sort(renderRooms.begin(),
+            renderRooms.end(),
+            [](const Room* a, const Room* b)
+            {
+              return a->node->getRenderOrder() > b->node->getRenderOrder();
+            });
+
+  std::vector<glm::vec4> scissors(m_draws.size(), glm::vec4{-1, -1, 1, 1});
+  std::array<std::vector<gl::DrawElementsIndirectCommand>, 2> commands;
+  for(const auto& room : renderRooms)
+  {
+    const auto drawIndex = room->physicalId;
+    const auto& draw = m_draws.at(drawIndex);
+    if(draw.indexCount == 0)
+      continue;
+
+    const auto [xy, size] = room->node->getCombinedScissors();
+    scissors[drawIndex] = glm::vec4{xy, xy + size};
+    commands[draw.inWater ? 1 : 0].emplace_back(gl::DrawElementsIndirectCommand{
+      draw.indexCount, 1, draw.firstIndex, draw.baseVertex, gsl::narrow<uint32_t>(drawIndex)});
+  }
+
+  m_scissorBuffer->setData(scissors, gl::api::BufferUsage::StreamDraw);
+  for(size_t i = 0; i < m_meshes.size(); ++i)
+  {
+    m_meshes[i]->setCommands(commands[i]);
+    m_nodes[i]->setVisible(m_meshes[i]->getDrawCount() > 0);
+  }
+}
+
+void RoomGeometry::render(render::scene::RenderContext& context) const
+{
+  for(const auto& node : m_nodes)
+  {
+    if(!node->isVisible())
+      continue;
+
+    SOGLB_DEBUGGROUP(node->getName());
+    context.pushState(node->getRenderState());
+    node->getRenderable()->render(node.get(), context);
+    context.popState();
+  }
+}
+} // namespace engine::world
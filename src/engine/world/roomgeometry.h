@@ -0,0 +1,155 @@
+#pragma once
+
+#include "core/id.h"
+#include "core/vec.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <gl/buffer.h>
+#include <gl/vertexbuffer.h>
+#include <glm/common.hpp>
+#include <glm/ext/vector_int3_sized.hpp>
+#include <glm/ext/vector_uint4_sized.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <gsl/gsl-lite.hpp>
+#include <gslu.h>
+#include <memory>
+#include <vector>
+
+namespace render
+{
+class TextureAnimator;
+}
+
+namespace render::scene
+{
+class MaterialManager;
+class Node;
+class RenderContext;
+template<typename IndexT, typename... VertexTs>
+class MultiDrawMesh;
+} // namespace render::scene
+
+namespace engine::world
+{
+struct Room;
+
+// must match RoomColorScale in room_vertex.glsl
+constexpr float RoomColorScale = 2.0f;
+
+#pragma pack(push, 1)
+
+//! Packed room vertex, decoded by room_vertex.glsl.
+struct RoomRenderVertex
+{
+  //! Relative to the room origin; room vertices are 16 bit in the level data, so this is lossless.
+  glm::i16vec3 position{0};
+  int16_t _pad0 = 0;
+  glm::i8vec3 normal{0};
+  int8_t _pad1 = 0;
+  //! Scaled by 1/RoomColorScale to cover the brightness range of room vertices.
+  glm::u8vec4 color{0};
+  //! Tile id plus one, quad corner, distorted quad index plus one, unused.
+  glm::u16vec4 tile{0};
+
+  static const gl::VertexLayout<RoomRenderVertex>& getLayout();
+
+  void setPosition(const core::TRVec& p)
+  {
+    const auto v = p.toRenderSystem();
+    position = {gsl::narrow<int16_t>(v.x), gsl::narrow<int16_t>(v.y), gsl::narrow<int16_t>(v.z)};
+  }
+
+  void setNormal(const glm::vec3& n)
+  {
+    normal = glm::i8vec3{glm::round(glm::clamp(n, -1.0f, 1.0f) * 127.0f)};
+  }
+
+  void setColor(const glm::vec4& c)
+  {
+    color = glm::u8vec4{glm::round(glm::clamp(c / RoomColorScale, 0.0f, 1.0f) * 255.0f)};
+  }
+
+  //! @param quadRef index of the distorted quad plus one, or zero
+  void setTile(const core::TextureTileId& tileId, const int corner, const size_t quadRef)
+  {
+    Expects(corner >= 0 && corner < 4);
+    tile = {gsl::narrow<uint16_t>(tileId.get() + 1), gsl::narrow<uint16_t>(corner), gsl::narrow<uint16_t>(quadRef), 0};
+  }
+};
+static_assert(sizeof(RoomRenderVertex) == 24, "Invalid RoomRenderVertex struct size");
+
+#pragma pack(pop)
+
+//! Screen space corners of a distorted quad, entry of @c b_roomQuads.
+struct RoomQuad
+{
+  std::array<glm::vec4, 4> vertices{};
+};
+static_assert(sizeof(RoomQuad) == 64, "Invalid RoomQuad struct size");
+
+/**
+ * The geometry of all rooms of a level, packed into shared buffers. All visible rooms with the same material are drawn
+ * with a single indirect multi-draw call per pass, each room clipped against its own portal scissor region.
+ */
+class RoomGeometry final
+{
+public:
+  using IndexType = uint16_t;
+
+  RoomGeometry();
+  ~RoomGeometry();
+
+  RoomGeometry(const RoomGeometry&) = delete;
+  RoomGeometry(RoomGeometry&&) = delete;
+  RoomGeometry& operator=(RoomGeometry&&) = delete;
+  RoomGeometry& operator=(const RoomGeometry&) = delete;
+
+  //! Appends the geometry of a room; the quad references of @a vertices index into @a quads.
+  void add(size_t physicalId,
+           bool inWater,
+           const glm::vec3& position,
+           const std::vector<RoomRenderVertex>& vertices,
+           const std::vector<IndexType>& indices,
+           const std::vector<RoomQuad>& quads);
+
+  //! Uploads all rooms and creates the batch nodes; must be called once after the last room has been added.
+  void upload(render::scene::MaterialManager& materialManager, const render::TextureAnimator& animator);
+
+  //! Collects the draws of all visible rooms front-to-back and hides the batches without any draws.
+  void update(const std::vector<Room>& rooms, const render::scene::RenderContext& context);
+
+  //! Renders all collected draws, e.g. for the depth prefill pass.
+  void render(render::scene::RenderContext& context) const;
+
+  //! The scene nodes of the batches, to be attached to the renderer's root node.
+  [[nodiscard]] const auto& getNodes() const
+  {
+    return m_nodes;
+  }
+
+private:
+  using Mesh = render::scene::MultiDrawMesh<IndexType, RoomRenderVertex, uint32_t>;
+
+  struct Draw
+  {
+    bool inWater;
+    glm::vec3 position;
+    uint32_t indexCount;
+    uint32_t firstIndex;
+    int32_t baseVertex;
+  };
+
+  std::vector<Draw> m_draws;
+  std::vector<RoomRenderVertex> m_vertices;
+  std::vector<IndexType> m_indices;
+  std::vector<RoomQuad> m_quads;
+
+  gslu::nn_shared<gl::ShaderStorageBuffer<glm::vec4>> m_scissorBuffer;
+  //! Dry and water room batches.
+  std::array<std::shared_ptr<Mesh>, 2> m_meshes;
+  std::vector<gslu::nn_shared<render::scene::Node>> m_nodes;
+};
+} // namespace engine::world
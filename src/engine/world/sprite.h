@@ -24,6 +24,17 @@ struct Sprite
 
   std::shared_ptr<render::scene::Mesh> yBoundMesh;
   std::shared_ptr<render::scene::Mesh> billboardMesh;
+  // same geometry as above, but with materials for drawing many instances at once
+  std::shared_ptr<render::scene::Mesh> instancedYBoundMesh;
+  std::shared_ptr<render::scene::Mesh> instancedBillboardMesh;
+
+  //! The largest distance of the sprite's corners from its origin, which bounds the sprite in any orientation.
+  [[nodiscard]] float getRadius() const
+  {
+    const auto x = glm::max(glm::abs(render0.x), glm::abs(render1.x));
+    const auto y = glm::max(glm::abs(render0.y), glm::abs(render1.y));
+    return glm::length(glm::vec2{x, y});
+  }
 };
 
 struct SpriteSequence
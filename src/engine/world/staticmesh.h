@@ -13,8 +13,10 @@ namespace engine::world
 struct StaticMesh
 {
   const core::BoundingBox collisionBox;
+  const core::BoundingBox visibilityBox;
   const bool doNotCollide;
 
+  //! Drawn through a @c render::scene::InstancedMesh.
   std::shared_ptr<render::scene::Mesh> renderMesh{nullptr};
 };
 } // namespace engine::world
@@ -0,0 +1,107 @@
+#include "staticmeshcollisionindex.h"
+
+#include "core/angle.h"
+#include "core/interval.h"
+#include "core/vec.h"
+#include "qs/qs.h"
+#include "room.h"
+#include "staticmesh.h"
+
+#include <algorithm>
+#include <gsl/gsl-lite.hpp>
+
+namespace engine::world
+{
+namespace
+{
+[[nodiscard]] core::BoundingBox
+  rotateTranslate(const core::BoundingBox& bbox, const core::TRVec& pos, const core::Angle& angle)
+{
+  auto result = bbox;
+
+  const auto axis = axisFromAngle(angle);
+  switch(axis)
+  {
+  case core::Axis::Deg0:
+    // nothing to do
+    break;
+  case core::Axis::Right90:
+    result.x = {bbox.z.min, bbox.z.max};
+    result.z = {-bbox.x.max, -bbox.x.min};
+    break;
+  case core::Axis::Deg180:
+    result.x = {-bbox.x.max, -bbox.x.min};
+    result.z = {-bbox.z.max, -bbox.z.min};
+    break;
+  case core::Axis::Left90:
+    result.x = {-bbox.z.max, -bbox.z.min};
+    result.z = {bbox.x.min, bbox.x.max};
+    break;
+  }
+
+  result.x += pos.X;
+  result.y += pos.Y;
+  result.z += pos.Z;
+  return result;
+}
+} // namespace
+
+void StaticMeshCollisionIndex::build(const std::vector<RoomStaticMesh>& staticMeshes)
+{
+  m_entries.clear();
+  m_maxExtentX = 0_len;
+
+  for(size_t i = 0; i < staticMeshes.size(); ++i)
+  {
+    const auto& rsm = staticMeshes[i];
+    if(rsm.staticMesh->doNotCollide)
+      continue;
+
+    const auto box = rotateTranslate(rsm.staticMesh->collisionBox, rsm.position, rsm.rotation);
+    m_maxExtentX = std::max(m_maxExtentX, box.x.max - box.x.min);
+    m_entries.emplace_back(Entry{box, i});
+  }
+
+  std::sort(m_entries.begin(),
+            m_entries.end(),
+            [](const Entry& a, const Entry& b)
+            {
+              return a.box.x.min < b.box.x.min;
+            });
+}
+
+std::optional<core::BoundingBox> StaticMeshCollisionIndex::findFirstIntersection(const core::BoundingBox& box) const
+{
+  // any entry starting at or before this cannot reach into the query box, as no entry is wider than m_maxExtentX
+  const auto sweepMin = box.x.min - m_maxExtentX;
+  const auto first = std::upper_bound(m_entries.begin(),
+                                      m_entries.end(),
+                                      sweepMin,
+                                      [](const core::Length& x, const Entry& entry)
+                                      {
+                                        return x < entry.box.x.min;
+                                      });
+  const auto last = std::lower_bound(first,
+                                     m_entries.end(),
+                                     box.x.max,
+                                     [](const Entry& entry, const core::Length& x)
+                                     {
+                                       return entry.box.x.min < x;
+                                     });
+
+  // the original engine tests static meshes in room order, so we must return the first one of those
+  const Entry* found = nullptr;
+  for(auto it = first; it != last; ++it)
+  {
+    if(found != nullptr && found->staticMeshIndex < it->staticMeshIndex)
+      continue;
+
+    if(it->box.intersectsExclusive(box))
+      found = &*it;
+  }
+
+  if(found == nullptr)
+    return std::nullopt;
+  return found->box;
+}
+} // namespace engine::world
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "core/boundingbox.h"
+#include "core/units.h"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace engine::world
+{
+struct RoomStaticMesh;
+
+/**
+ * @brief Sweep-and-prune index over the world-space collision boxes of a room's collidable static meshes.
+ *
+ * Boxes are sorted by their minimum X coordinate; together with the largest X extent of all boxes this allows
+ * limiting a query to a narrow slice of the list instead of testing every static mesh in the room.
+ */
+class StaticMeshCollisionIndex
+{
+public:
+  void build(const std::vector<RoomStaticMesh>& staticMeshes);
+
+  /**
+   * @brief Finds the static mesh collision box intersecting @a box.
+   * @return The world-space collision box of the intersecting static mesh with the lowest index within the room.
+   */
+  [[nodiscard]] std::optional<core::BoundingBox> findFirstIntersection(const core::BoundingBox& box) const;
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return m_entries.empty();
+  }
+
+private:
+  struct Entry
+  {
+    core::BoundingBox box;
+    size_t staticMeshIndex;
+  };
+
+  std::vector<Entry> m_entries{};
+  core::Length m_maxExtentX = 0_len;
+};
+} // namespace engine::world
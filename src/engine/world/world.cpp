@@ -30,7 +30,7 @@
 #include "engine/objects/objectstate.h"
 #include "engine/objects/pickupobject.h"
 #include "engine/objects/tallblock.h" // IWYU pragma: keep
-#include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/player.h"
 #include "engine/presenter.h"
 #include "engine/script/scriptengine.h"
@@ -61,6 +61,7 @@
 #include "render/textureatlas.h"
 #include "rendermeshdata.h"
 #include "room.h"
+#include "roomgeometry.h"
 #include "sector.h"
 #include "serialization/array.h"
 #include "serialization/bitset.h"
@@ -339,9 +340,7 @@ void World::laraBubblesEffect(objects::Object& object)
 
   while(bubbleCount-- > 0)
   {
-    auto particle = gsl::make_shared<BubbleParticle>(Location{object.m_state.location.room, position}, *this);
-    setParent(particle, object.m_state.location.room->node);
-    m_objectManager.registerParticle(particle);
+    m_objectManager.getParticlePool().spawnBubble(*this, Location{object.m_state.location.room, position}, true);
   }
 }
 
@@ -958,6 +957,8 @@ void World::serialize(const serialization::Serializer<World>& ser)
       room.resetScenery();
       setParent(gsl::not_null{room.node}, getPresenter().getRenderer().getRootNode());
     }
+    for(const auto& node : m_roomGeometry->getNodes())
+      setParent(node, getPresenter().getRenderer().getRootNode());
 
     ser(S_NV("roomPhysicalIds", serialization::FrozenVector{physicalIds}));
     for(size_t i = 0; i < m_rooms.size(); ++i)
@@ -1004,9 +1005,7 @@ void World::gameLoop(bool godMode, float blackAlpha, ui::Ui& ui)
   getPresenter().drawBars(ui, m_palette, getObjectManager(), getEngine().getEngineConfig()->pulseLowHealthHealthBar);
 
   drawPickupWidgets(ui);
-  if(const auto lara = getObjectManager().getLaraPtr())
-    lara->m_state.location.room->node->setVisible(true);
-  getPresenter().renderWorld(getRooms(), getCameraController(), waterEntryPortals);
+  getPresenter().renderWorld(getRooms(), getRoomGeometry(), getCameraController(), waterEntryPortals);
   getPresenter().renderScreenOverlay();
   if(blackAlpha > 0)
   {
@@ -1032,7 +1031,7 @@ bool World::cinematicLoop()
   doGlobalEffect();
 
   ui::Ui ui{getPresenter().getMaterialManager()->getUi(), getPalette(), getPresenter().getUiViewport()};
-  getPresenter().renderWorld(getRooms(), getCameraController(), waterEntryPortals);
+  getPresenter().renderWorld(getRooms(), getRoomGeometry(), getCameraController(), waterEntryPortals);
   getPresenter().renderScreenOverlay();
   getPresenter().renderUi(ui, 1);
   getPresenter().updateSoundEngine();
@@ -1064,12 +1063,18 @@ void World::load(const std::optional<size_t>& slot)
 void World::save(const std::filesystem::path& filename, bool isQuicksave)
 {
   BOOST_LOG_TRIVIAL(info) << "Save " << filename;
-  serialization::YAMLDocument<false> doc{filename};
+  serialize(filename, isQuicksave)->write();
+}
+
+std::unique_ptr<serialization::YAMLDocument<false>> World::serialize(const std::filesystem::path& filename,
+                                                                     bool isQuicksave)
+{
+  auto doc = std::make_unique<serialization::YAMLDocument<false>>(filename);
   SavegameMeta meta{std::filesystem::relative(m_levelFilename, m_engine.getAssetDataPath()).string(),
                     isQuicksave ? _("Quicksave") : m_title};
-  doc.save("meta", meta, meta);
-  doc.save("data", *this, *this);
-  doc.write();
+  doc->save("meta", meta, meta);
+  doc->save("data", *this, *this);
+  return doc;
 }
 
 void World::save(const std::optional<size_t>& slot)
@@ -1135,6 +1140,7 @@ World::World(Engine& engine,
     , m_player{std::move(player)}
     , m_levelStartPlayer{std::move(levelStartPlayer)}
     , m_samplesData{std::move(level->m_samplesData)}
+    , m_roomGeometry{std::make_unique<RoomGeometry>()}
 {
   m_engine.registerWorld(this);
   m_audioEngine->setMusicGain(m_engine.getEngineConfig()->audioSettings.musicVolume);
@@ -1146,7 +1152,7 @@ World::World(Engine& engine,
   m_controllerLayouts
     = loadControllerButtonIcons(atlases,
                                 util::ensureFileExists(m_engine.getEngineDataPath() / "button-icons" / "buttons.yaml"),
-                                getPresenter().getMaterialManager()->getSprite(true));
+                                getPresenter().getMaterialManager()->getSprite(true, false));
   m_allTextures = buildTextures(*level,
                                 m_engine.getGlidos(),
                                 atlases,
@@ -1156,6 +1162,7 @@ World::World(Engine& engine,
                                 {
                                   getPresenter().drawLoadingScreen(s);
                                 });
+  m_textureAnimator->uploadTiles(m_atlasTiles);
 
   auto sampler = gsl::make_unique<gl::Sampler>("all-textures-sampler")
                  | set(gl::api::TextureMinFilter::NearestMipmapLinear) | set(gl::api::TextureMagFilter::Nearest)
@@ -1171,24 +1178,34 @@ World::World(Engine& engine,
   for(size_t i = 0; i < m_sprites.size(); ++i)
   {
     auto& sprite = m_sprites[i];
-    sprite.yBoundMesh = render::scene::createSpriteMesh(static_cast<float>(sprite.render0.x),
-                                                        static_cast<float>(-sprite.render0.y),
-                                                        static_cast<float>(sprite.render1.x),
-                                                        static_cast<float>(-sprite.render1.y),
-                                                        sprite.uv0,
-                                                        sprite.uv1,
-                                                        getPresenter().getMaterialManager()->getSprite(false),
-                                                        sprite.textureId.get_as<int32_t>(),
-                                                        "sprite-" + std::to_string(i));
-    sprite.billboardMesh = render::scene::createSpriteMesh(static_cast<float>(sprite.render0.x),
-                                                           static_cast<float>(-sprite.render0.y),
-                                                           static_cast<float>(sprite.render1.x),
-                                                           static_cast<float>(-sprite.render1.y),
-                                                           sprite.uv0,
-                                                           sprite.uv1,
-                                                           getPresenter().getMaterialManager()->getSprite(true),
-                                                           sprite.textureId.get_as<int32_t>(),
-                                                           "sprite-" + std::to_string(i));
+    const auto& materialManager = getPresenter().getMaterialManager();
+    const auto [yBoundMesh, instancedYBoundMesh]
+      = render::scene::createSpriteMeshWithInstanced(static_cast<float>(sprite.render0.x),
+                                                     static_cast<float>(-sprite.render0.y),
+                                                     static_cast<float>(sprite.render1.x),
+                                                     static_cast<float>(-sprite.render1.y),
+                                                     sprite.uv0,
+                                                     sprite.uv1,
+                                                     materialManager->getSprite(false, false),
+                                                     materialManager->getSprite(false, true),
+                                                     sprite.textureId.get_as<int32_t>(),
+                                                     "sprite-" + std::to_string(i));
+    sprite.yBoundMesh = yBoundMesh.get();
+    sprite.instancedYBoundMesh = instancedYBoundMesh.get();
+
+    const auto [billboardMesh, instancedBillboardMesh]
+      = render::scene::createSpriteMeshWithInstanced(static_cast<float>(sprite.render0.x),
+                                                     static_cast<float>(-sprite.render0.y),
+                                                     static_cast<float>(sprite.render1.x),
+                                                     static_cast<float>(-sprite.render1.y),
+                                                     sprite.uv0,
+                                                     sprite.uv1,
+                                                     materialManager->getSprite(true, false),
+                                                     materialManager->getSprite(true, true),
+                                                     sprite.textureId.get_as<int32_t>(),
+                                                     "sprite-" + std::to_string(i));
+    sprite.billboardMesh = billboardMesh.get();
+    sprite.instancedBillboardMesh = instancedBillboardMesh.get();
   }
 
   m_audioEngine->init(level->m_soundEffectProperties, level->m_soundEffects);
@@ -1460,11 +1477,16 @@ void World::initRooms(const loader::file::level::Level& level)
         BOOST_LOG_TRIVIAL(warning) << "No static mesh found for id " << rsm.meshId.get();
       }
     }
+    m_rooms[i].staticMeshCollisions.build(m_rooms[i].staticMeshes);
     m_rooms[i].alternateRoom = srcRoom.alternateRoom.get() >= 0 ? &m_rooms.at(srcRoom.alternateRoom.get()) : nullptr;
 
-    m_rooms[i].createSceneNode(level.m_rooms.at(i), i, *this, *m_textureAnimator, *getPresenter().getMaterialManager());
+    m_rooms[i].createSceneNode(level.m_rooms.at(i), i, *this, *m_roomGeometry, *getPresenter().getMaterialManager());
     setParent(gsl::not_null{m_rooms[i].node}, getPresenter().getRenderer().getRootNode());
   }
+
+  m_roomGeometry->upload(*getPresenter().getMaterialManager(), *m_textureAnimator);
+  for(const auto& node : m_roomGeometry->getNodes())
+    setParent(node, getPresenter().getRenderer().getRootNode());
 }
 
 void World::initStaticMeshes(const loader::file::level::Level& level,
@@ -1475,10 +1497,12 @@ void World::initStaticMeshes(const loader::file::level::Level& level,
     RenderMeshDataCompositor compositor;
     if(staticMesh.isVisible())
       compositor.append(*meshesDirect.at(staticMesh.mesh)->meshData, gl::SRGBA8{0, 0, 0, 0});
-    auto mesh = compositor.toMesh(*getPresenter().getMaterialManager(), false, false, {});
+    auto mesh = compositor.toInstancedMesh(*getPresenter().getMaterialManager(), {});
     mesh->getRenderState().setScissorTest(false);
     const bool distinct
-      = m_staticMeshes.emplace(staticMesh.id, StaticMesh{staticMesh.collision_box, staticMesh.doNotCollide(), mesh})
+      = m_staticMeshes
+          .emplace(staticMesh.id,
+                   StaticMesh{staticMesh.collision_box, staticMesh.visibility_box, staticMesh.doNotCollide(), mesh})
           .second;
 
     Expects(distinct);
@@ -1687,7 +1711,6 @@ void World::connectSectors()
 {
   for(auto& room : m_rooms)
   {
-    room.collectShaderLights(m_engine.getEngineConfig()->renderSettings.getLightCollectionDepth());
     for(auto& sector : room.sectors)
       sector.connect(m_rooms);
   }
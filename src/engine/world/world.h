@@ -95,6 +95,7 @@ struct Location;
 namespace engine::world
 {
 class RenderMeshData;
+class RoomGeometry;
 struct SkeletalModelType;
 
 class World final
@@ -201,6 +202,11 @@ public:
   [[nodiscard]] const std::vector<Box>& getBoxes() const;
   [[nodiscard]] const std::vector<Room>& getRooms() const;
   std::vector<Room>& getRooms();
+
+  [[nodiscard]] RoomGeometry& getRoomGeometry()
+  {
+    return *m_roomGeometry;
+  }
   [[nodiscard]] const StaticMesh* findStaticMeshById(const core::StaticMeshId& meshId) const;
   [[nodiscard]] const std::unique_ptr<SpriteSequence>& findSpriteSequenceForType(const core::TypeId& type) const;
   [[nodiscard]] const Animation& getAnimation(loader::file::AnimationId id) const;
@@ -244,6 +250,9 @@ public:
   void load(const std::optional<size_t>& slot);
   void save(const std::optional<size_t>& slot);
   void save(const std::filesystem::path& path, bool isQuicksave);
+  //! Serializes the current state without writing it, so that writing can be done on another thread.
+  [[nodiscard]] std::unique_ptr<serialization::YAMLDocument<false>> serialize(const std::filesystem::path& path,
+                                                                              bool isQuicksave);
   [[nodiscard]] std::tuple<std::optional<SavegameInfo>, std::map<size_t, SavegameInfo>> getSavedGames() const;
   [[nodiscard]] bool hasSavedGames() const;
 
@@ -431,6 +440,7 @@ private:
   std::map<core::TypeId, std::unique_ptr<SpriteSequence>> m_spriteSequences;
   std::vector<AtlasTile> m_atlasTiles;
   std::vector<Room> m_rooms;
+  std::unique_ptr<RoomGeometry> m_roomGeometry;
   std::vector<CinematicFrame> m_cinematicFrames;
   std::vector<CameraSink> m_cameraSinks;
   std::vector<StaticSoundEffect> m_staticSoundEffects;
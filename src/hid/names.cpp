@@ -354,6 +354,10 @@ std::string getName(Action action)
     return /* translators: TR charmap encoding */ pgettext("Action", "Screenshot");
   case Action::BugReport: 
     return /* translators: TR charmap encoding */ pgettext("Action", "Bug Report");
+  case Action::GpuTimings:
+    return /* translators: TR charmap encoding */ pgettext("Action", "GPU Timings");
+  case Action::DumpGpuTimings:
+    return /* translators: TR charmap encoding */ pgettext("Action", "Save GPU Timings");
   }
   BOOST_THROW_EXCEPTION(std::domain_error("action"));
 }
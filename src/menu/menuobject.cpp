@@ -3,6 +3,7 @@
 #include "core/angle.h"
 #include "core/id.h"
 #include "core/vec.h"
+#include "engine/lightgrid.h"
 #include "engine/objectmanager.h"
 #include "engine/objects/laraobject.h"
 #include "engine/objects/objectstate.h"
@@ -144,6 +145,13 @@ void MenuObject::initModel(const engine::world::World& world,
              {
                shaderStorageBlock.bind(*lights);
              });
+  node->bind("b_lightGrid",
+             [disabledBuffer = engine::LightGrid::getDisabledBuffer()](const render::scene::Node*,
+                                                                       const render::scene::Mesh& /*mesh*/,
+                                                                       gl::ShaderStorageBlock& shaderStorageBlock)
+             {
+               shaderStorageBlock.bind(*disabledBuffer);
+             });
   core::AnimStateId animState{0_as};
   engine::SkeletalModelNode::buildMesh(node, animState);
   node->getRenderable()->getRenderState().setCullFace(true);
@@ -295,6 +295,16 @@ RenderSettingsMenuState::RenderSettingsMenuState(const std::shared_ptr<MenuRingT
     {
       toggle(engine, engine.getEngineConfig()->renderSettings.highQualityShadows);
     });
+  listBox->addSetting(
+    /* translators: TR charmap encoding */ _("Update Distant Shadows Less Often"),
+    [&engine]()
+    {
+      return engine.getEngineConfig()->renderSettings.reuseDistantShadows;
+    },
+    [&engine]()
+    {
+      toggle(engine, engine.getEngineConfig()->renderSettings.reuseDistantShadows);
+    });
 
   m_renderResolutionDivisorSelector = std::make_shared<ui::widgets::ValueSelector<uint8_t>>(
     [](uint32_t value)
@@ -314,6 +324,16 @@ RenderSettingsMenuState::RenderSettingsMenuState(const std::shared_ptr<MenuRingT
       toggle(engine, engine.getEngineConfig()->renderSettings.renderResolutionDivisorActive);
     });
   m_renderResolutionDivisorSelector->selectValue(engine.getEngineConfig()->renderSettings.renderResolutionDivisor);
+  listBox->addSetting(
+    /* translators: TR charmap encoding */ _("Dynamic Render Scale"),
+    [&engine]()
+    {
+      return engine.getEngineConfig()->renderSettings.dynamicResolution;
+    },
+    [&engine]()
+    {
+      toggle(engine, engine.getEngineConfig()->renderSettings.dynamicResolution);
+    });
 
   m_uiScaleSelector = std::make_shared<ui::widgets::ValueSelector<uint8_t>>(
     [](uint32_t value)
@@ -0,0 +1,39 @@
+#include "dynamicresolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+namespace render
+{
+DynamicResolution::DynamicResolution()
+    : m_timer{"dynamic-resolution"}
+{
+}
+
+void DynamicResolution::beginFrame()
+{
+  if(const auto gpuTime = m_timer.takeResult(); gpuTime.has_value())
+  {
+    // aim a bit below the budget to leave headroom for spikes
+    static constexpr float TargetLoad = 0.8f;
+    // ignore small deviations to avoid the scale jittering from frame to frame
+    static constexpr float Tolerance = 0.02f;
+
+    const auto load = std::chrono::duration<float>{*gpuTime} / std::chrono::duration<float>{FrameBudget};
+    const auto targetScale = m_scale * std::sqrt(TargetLoad / std::max(load, 0.01f));
+    if(std::abs(targetScale - m_scale) > Tolerance)
+    {
+      // react quickly to overload, but recover slowly so that the scale doesn't oscillate
+      m_scale = std::clamp(m_scale + std::clamp(targetScale - m_scale, -0.1f, 0.02f), MinScale, MaxScale);
+    }
+  }
+
+  m_timer.begin();
+}
+
+void DynamicResolution::endFrame()
+{
+  m_timer.end();
+}
+} // namespace render
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "gputimer.h"
+
+#include <chrono>
+
+namespace render
+{
+/**
+ * Adjusts the render scale of the world so that the GPU time of a frame stays within the frame budget. The cost of a
+ * frame is assumed to be roughly proportional to the number of rendered pixels, i.e. to the square of the scale.
+ */
+class DynamicResolution final
+{
+public:
+  static constexpr float MinScale = 0.5f;
+  static constexpr float MaxScale = 1.0f;
+  //! The engine runs at 30 frames per second.
+  static constexpr std::chrono::milliseconds FrameBudget{33};
+
+  DynamicResolution();
+
+  //! Updates the scale from the latest finished measurement, and starts measuring the current frame.
+  void beginFrame();
+  void endFrame();
+
+  void reset()
+  {
+    m_scale = MaxScale;
+  }
+
+  [[nodiscard]] auto getScale() const
+  {
+    return m_scale;
+  }
+
+private:
+  GpuTimer m_timer;
+  float m_scale = MaxScale;
+};
+} // namespace render
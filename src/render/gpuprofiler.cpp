@@ -0,0 +1,128 @@
+#include "gpuprofiler.h"
+
+#include <boost/assert.hpp>
+#include <boost/log/trivial.hpp>
+#include <fstream>
+#include <gl/api/gl.hpp>
+#include <gl/query.h>
+#include <gsl/gsl-lite.hpp>
+#include <iomanip>
+
+namespace render
+{
+GpuProfiler::Scope::~Scope()
+{
+  if(m_record.has_value())
+    m_profiler->end(*m_record);
+}
+
+GpuProfiler::GpuProfiler() = default;
+
+GpuProfiler::~GpuProfiler() = default;
+
+void GpuProfiler::setEnabled(const bool enabled)
+{
+  if(enabled && !m_enabled)
+  {
+    m_timings.clear();
+    m_history.clear();
+  }
+  m_enabled = enabled;
+}
+
+void GpuProfiler::beginFrame()
+{
+  BOOST_ASSERT(m_depth == 0);
+
+  m_currentFrame = (m_currentFrame + 1) % FrameCount;
+  auto& frame = m_frames[m_currentFrame];
+  collect(frame);
+  frame.number = m_frameNumber++;
+  frame.records.clear();
+  frame.usedQueries = 0;
+}
+
+GpuProfiler::Scope GpuProfiler::measure(const std::string& name)
+{
+  if(!m_enabled)
+    return Scope{this, std::nullopt};
+
+  auto& frame = m_frames[m_currentFrame];
+  const auto record = frame.records.size();
+  frame.records.emplace_back(Record{name, m_depth, recordTimestamp(), std::nullopt});
+  ++m_depth;
+  return Scope{this, record};
+}
+
+size_t GpuProfiler::recordTimestamp()
+{
+  auto& frame = m_frames[m_currentFrame];
+  if(frame.usedQueries == frame.queries.size())
+  {
+    frame.queries.emplace_back(gsl::make_unique<gl::Query>(
+      gl::api::QueryCounterTarget::Timestamp,
+      "gpu-profiler/" + std::to_string(m_currentFrame) + "/" + std::to_string(frame.queries.size())));
+  }
+
+  const auto query = frame.usedQueries++;
+  frame.queries[query]->recordTimestamp();
+  return query;
+}
+
+void GpuProfiler::end(const size_t record)
+{
+  BOOST_ASSERT(m_depth > 0);
+  --m_depth;
+
+  const auto query = recordTimestamp();
+  m_frames[m_currentFrame].records.at(record).endQuery = query;
+}
+
+void GpuProfiler::collect(Frame& frame)
+{
+  if(frame.records.empty() || frame.usedQueries == 0)
+    return;
+
+  // the queries finish in order, so the last one decides whether the frame is complete
+  if(!frame.queries[frame.usedQueries - 1]->isResultAvailable())
+    return;
+
+  std::vector<Timing> timings;
+  timings.reserve(frame.records.size());
+  for(const auto& record : frame.records)
+  {
+    BOOST_ASSERT(record.endQuery.has_value());
+    const auto begin = frame.queries[record.beginQuery]->getResult();
+    const auto end = frame.queries[*record.endQuery]->getResult();
+    timings.emplace_back(Timing{record.name, record.depth, std::chrono::nanoseconds{end - begin}});
+  }
+
+  m_timings = timings;
+  m_history.emplace_back(frame.number, std::move(timings));
+  while(m_history.size() > HistorySize)
+    m_history.pop_front();
+}
+
+void GpuProfiler::writeCsv(const std::filesystem::path& path) const
+{
+  std::ofstream file{path, std::ios::out | std::ios::trunc};
+  if(!file.is_open())
+  {
+    BOOST_LOG_TRIVIAL(error) << "Failed to write GPU timings to " << path;
+    return;
+  }
+
+  file << "frame,pass,depth,ms\n";
+  file << std::fixed << std::setprecision(4);
+  for(const auto& [frameNumber, timings] : m_history)
+  {
+    for(const auto& timing : timings)
+    {
+      file << frameNumber << "," << timing.name << "," << timing.depth << ","
+           << std::chrono::duration<double, std::milli>{timing.duration}.count() << "\n";
+    }
+  }
+
+  BOOST_LOG_TRIVIAL(info) << "Wrote GPU timings of " << m_history.size() << " frames to " << path;
+}
+} // namespace render
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <gl/soglb_fwd.h>
+#include <gslu.h>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace render
+{
+/**
+ * Measures the GPU time of named, possibly nested render passes with timestamp queries. The queries of a frame are
+ * read back without stalling when its slot is reused, i.e. two frames later; frames whose results are not available
+ * by then are dropped.
+ */
+class GpuProfiler final
+{
+public:
+  struct Timing
+  {
+    std::string name;
+    //! Nesting level of the pass, zero for top-level passes.
+    size_t depth;
+    std::chrono::nanoseconds duration;
+  };
+
+  //! Measures the GPU time from its construction to its destruction.
+  class Scope final
+  {
+  public:
+    Scope(const Scope&) = delete;
+    Scope(Scope&&) = delete;
+    Scope& operator=(Scope&&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope();
+
+  private:
+    friend class GpuProfiler;
+
+    explicit Scope(GpuProfiler* profiler, const std::optional<size_t>& record)
+        : m_profiler{profiler}
+        , m_record{record}
+    {
+    }
+
+    GpuProfiler* const m_profiler;
+    const std::optional<size_t> m_record;
+  };
+
+  GpuProfiler();
+  ~GpuProfiler();
+
+  GpuProfiler(const GpuProfiler&) = delete;
+  GpuProfiler(GpuProfiler&&) = delete;
+  GpuProfiler& operator=(GpuProfiler&&) = delete;
+  GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+  //! Enabling the profiler discards all previously collected timings.
+  void setEnabled(bool enabled);
+
+  [[nodiscard]] bool isEnabled() const noexcept
+  {
+    return m_enabled;
+  }
+
+  //! Collects the results of the oldest recorded frame, and starts recording a new one.
+  void beginFrame();
+
+  //! Starts measuring a pass; does nothing while the profiler is disabled.
+  [[nodiscard]] Scope measure(const std::string& name);
+
+  //! The timings of the most recent frame whose results are available, in the order the passes were started.
+  [[nodiscard]] const auto& getTimings() const noexcept
+  {
+    return m_timings;
+  }
+
+  //! The timings of the last few seconds, together with the numbers of the frames they were recorded in.
+  [[nodiscard]] const auto& getHistory() const noexcept
+  {
+    return m_history;
+  }
+
+  //! Writes the timings of the last few seconds as a CSV table.
+  void writeCsv(const std::filesystem::path& path) const;
+
+private:
+  static constexpr size_t FrameCount = 3;
+  static constexpr size_t HistorySize = 300;
+
+  struct Record
+  {
+    std::string name;
+    size_t depth;
+    size_t beginQuery;
+    std::optional<size_t> endQuery;
+  };
+
+  struct Frame
+  {
+    uint64_t number = 0;
+    std::vector<Record> records;
+    std::vector<gslu::nn_unique<gl::Query>> queries;
+    size_t usedQueries = 0;
+  };
+
+  bool m_enabled = false;
+  uint64_t m_frameNumber = 0;
+  std::array<Frame, FrameCount> m_frames;
+  size_t m_currentFrame = 0;
+  size_t m_depth = 0;
+  std::vector<Timing> m_timings;
+  std::deque<std::pair<uint64_t, std::vector<Timing>>> m_history;
+
+  size_t recordTimestamp();
+  void end(size_t record);
+  void collect(Frame& frame);
+};
+} // namespace render
@@ -0,0 +1,54 @@
+#include "gputimer.h"
+
+#include <boost/assert.hpp>
+#include <gl/api/gl.hpp>
+#include <gl/query.h>
+#include <gsl/gsl-lite.hpp>
+
+namespace render
+{
+GpuTimer::GpuTimer(const std::string& label)
+{
+  for(size_t i = 0; i < QueryCount; ++i)
+    m_queries.emplace_back(
+      gsl::make_unique<gl::Query>(gl::api::QueryTarget::TimeElapsed, label + "/" + std::to_string(i)));
+}
+
+GpuTimer::~GpuTimer() = default;
+
+void GpuTimer::begin()
+{
+  BOOST_ASSERT(!m_active);
+  if(m_pending == QueryCount)
+    return;
+
+  m_queries[m_next]->begin();
+  m_active = true;
+}
+
+void GpuTimer::end()
+{
+  if(!m_active)
+    return;
+
+  m_queries[m_next]->end();
+  m_next = (m_next + 1) % QueryCount;
+  ++m_pending;
+  m_active = false;
+}
+
+std::optional<std::chrono::nanoseconds> GpuTimer::takeResult()
+{
+  std::optional<std::chrono::nanoseconds> result;
+  while(m_pending > 0)
+  {
+    const auto& oldest = m_queries[(m_next + QueryCount - m_pending) % QueryCount];
+    if(!oldest->isResultAvailable())
+      break;
+
+    result = std::chrono::nanoseconds{oldest->getResult()};
+    --m_pending;
+  }
+  return result;
+}
+} // namespace render
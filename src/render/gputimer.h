@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <gl/soglb_fwd.h>
+#include <gslu.h>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace render
+{
+/**
+ * Measures the GPU time spent between begin() and end() without stalling; results become available a few frames
+ * later. Time elapsed queries must not be nested, so measured ranges must not overlap.
+ */
+class GpuTimer final
+{
+public:
+  explicit GpuTimer(const std::string& label);
+  ~GpuTimer();
+
+  GpuTimer(const GpuTimer&) = delete;
+  GpuTimer(GpuTimer&&) = delete;
+  GpuTimer& operator=(GpuTimer&&) = delete;
+  GpuTimer& operator=(const GpuTimer&) = delete;
+
+  //! Starts a measurement, unless all queries are still waiting for their results.
+  void begin();
+  void end();
+
+  //! The most recent result that became available since the last call, if any.
+  [[nodiscard]] std::optional<std::chrono::nanoseconds> takeResult();
+
+private:
+  static constexpr size_t QueryCount = 3;
+
+  std::vector<gslu::nn_unique<gl::Query>> m_queries;
+  //! Index of the query used by the next measurement.
+  size_t m_next = 0;
+  //! Number of issued queries whose results have not been read yet.
+  size_t m_pending = 0;
+  bool m_active = false;
+};
+} // namespace render
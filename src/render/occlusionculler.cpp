@@ -0,0 +1,150 @@
+#include "occlusionculler.h"
+
+#include "engine/world/room.h"
+#include "scene/mesh.h"
+#include "scene/node.h"
+#include "scene/rendercontext.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/geometric.hpp>
+#include <gsl/gsl-lite.hpp>
+#include <utility>
+
+namespace render
+{
+namespace
+{
+// results of the previous frame, or of the one before if the gpu lags behind
+constexpr uint64_t MaxResultAge = 2;
+// portal quads are only slightly offset from the wall, so they're clipped by the near plane when the camera stands in a
+// doorway
+constexpr float NearPlaneMargin = 16.0f;
+} // namespace
+
+PortalOcclusionQuery::PortalOcclusionQuery(gslu::nn_shared<scene::Mesh> mesh)
+    : m_mesh{std::move(mesh)}
+    , m_query{gl::api::QueryTarget::AnySamplesPassedConservative, "portal-occlusion"}
+{
+}
+
+void PortalOcclusionQuery::fetchResult()
+{
+  Expects(m_pendingFrame.has_value());
+  // don't replace a newer result set by setVisible()
+  if(!m_result.has_value() || m_result->frame < *m_pendingFrame)
+    m_result = Result{*m_pendingFrame, m_query.getResult() == 0};
+  m_pendingFrame.reset();
+}
+
+void PortalOcclusionQuery::setVisible(const uint64_t frame)
+{
+  m_result = Result{frame, false};
+}
+
+void PortalOcclusionQuery::issue(const uint64_t frame, scene::RenderContext& context)
+{
+  if(m_pendingFrame.has_value())
+  {
+    if(!m_query.isResultAvailable())
+      return;
+    fetchResult();
+  }
+
+  m_query.begin();
+  m_mesh->render(nullptr, context);
+  m_query.end();
+  m_pendingFrame = frame;
+}
+
+bool PortalOcclusionQuery::isOccluded(const uint64_t frame)
+{
+  if(m_pendingFrame.has_value() && m_query.isResultAvailable())
+    fetchResult();
+
+  return m_result.has_value() && m_result->frame + MaxResultAge >= frame && m_result->occluded;
+}
+
+bool OcclusionCuller::isTraced(const std::vector<engine::world::Room>& rooms, const engine::world::Room& room) const
+{
+  if(room.node->isVisible())
+    return true;
+
+  const auto roomIndex = gsl::narrow_cast<size_t>(&room - rooms.data());
+  return std::find(m_hiddenRooms.begin(), m_hiddenRooms.end(), roomIndex) != m_hiddenRooms.end();
+}
+
+void OcclusionCuller::cull(const std::vector<engine::world::Room>& rooms, const engine::world::Room& cameraRoom)
+{
+  Expects(m_hiddenRooms.empty());
+  ++m_frame;
+
+  // a room is only occluded if all portals it can be seen through are
+  m_incomingPortals.assign(rooms.size(), IncomingPortals{});
+  for(const auto& room : rooms)
+  {
+    if(!room.node->isVisible())
+      continue;
+
+    for(const auto& portal : room.portals)
+    {
+      if(portal.adjoiningRoom == &cameraRoom || !portal.adjoiningRoom->node->isVisible())
+        continue;
+
+      auto& incoming = m_incomingPortals.at(gsl::narrow_cast<size_t>(portal.adjoiningRoom.get() - rooms.data()));
+      ++incoming.total;
+      if(portal.occlusionQuery->isOccluded(m_frame))
+        ++incoming.occluded;
+    }
+  }
+
+  for(size_t i = 0; i < rooms.size(); ++i)
+  {
+    const auto& incoming = m_incomingPortals[i];
+    if(incoming.total == 0 || incoming.occluded < incoming.total)
+      continue;
+
+    rooms[i].node->setVisible(false);
+    m_hiddenRooms.emplace_back(i);
+  }
+}
+
+void OcclusionCuller::query(const std::vector<engine::world::Room>& rooms,
+                            const engine::world::Room& cameraRoom,
+                            const glm::vec3& cameraPosition,
+                            const float nearPlane,
+                            scene::RenderContext& context)
+{
+  for(const auto& room : rooms)
+  {
+    if(!isTraced(rooms, room))
+      continue;
+
+    for(const auto& portal : room.portals)
+    {
+      if(portal.adjoiningRoom == &cameraRoom || !isTraced(rooms, *portal.adjoiningRoom))
+        continue;
+
+      const auto distance = dot(glm::normalize(portal.normal), cameraPosition - portal.vertices[0]);
+      if(std::abs(distance) < nearPlane + NearPlaneMargin)
+      {
+        portal.occlusionQuery->setVisible(m_frame);
+        continue;
+      }
+
+      // the camera can't see through portals facing away from it
+      if(distance < 0)
+        continue;
+
+      portal.occlusionQuery->issue(m_frame, context);
+    }
+  }
+}
+
+void OcclusionCuller::restore(const std::vector<engine::world::Room>& rooms)
+{
+  for(const auto roomIndex : m_hiddenRooms)
+    rooms.at(roomIndex).node->setVisible(true);
+  m_hiddenRooms.clear();
+}
+} // namespace render
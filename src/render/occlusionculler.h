@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <gl/query.h>
+#include <glm/vec3.hpp>
+#include <gslu.h>
+#include <optional>
+#include <vector>
+
+namespace engine::world
+{
+struct Room;
+} // namespace engine::world
+
+namespace render::scene
+{
+class Mesh;
+class RenderContext;
+} // namespace render::scene
+
+namespace render
+{
+//! Occlusion query of a single portal quad; results are read without stalling, at the earliest in the next frame.
+class PortalOcclusionQuery final
+{
+public:
+  explicit PortalOcclusionQuery(gslu::nn_shared<scene::Mesh> mesh);
+
+  //! Draws the portal within an occlusion query, unless the result of a previous query is still pending.
+  void issue(uint64_t frame, scene::RenderContext& context);
+
+  //! Whether the most recent query result is recent enough and found no visible samples.
+  [[nodiscard]] bool isOccluded(uint64_t frame);
+
+  //! Records the portal as visible without a query, e.g. when the near plane would clip the quad.
+  void setVisible(uint64_t frame);
+
+private:
+  struct Result
+  {
+    uint64_t frame;
+    bool occluded;
+  };
+
+  const gslu::nn_shared<scene::Mesh> m_mesh;
+  const gl::Query m_query;
+  std::optional<uint64_t> m_pendingFrame{};
+  std::optional<Result> m_result{};
+
+  void fetchResult();
+};
+
+/**
+ * Hides rooms which can only be seen through portals that were fully occluded by the depth prefill of the previous
+ * frame, so that they are skipped by all following passes.
+ */
+class OcclusionCuller final
+{
+public:
+  //! Hides the occluded rooms; must be called after the portal trace, and be followed by restore() after rendering.
+  void cull(const std::vector<engine::world::Room>& rooms, const engine::world::Room& cameraRoom);
+  //! Issues the queries of all portals between the traced rooms; must be called after the depth prefill.
+  void query(const std::vector<engine::world::Room>& rooms,
+             const engine::world::Room& cameraRoom,
+             const glm::vec3& cameraPosition,
+             float nearPlane,
+             scene::RenderContext& context);
+  //! Makes the rooms hidden by cull() visible again, leaving the portal trace results untouched.
+  void restore(const std::vector<engine::world::Room>& rooms);
+
+private:
+  struct IncomingPortals
+  {
+    size_t total = 0;
+    size_t occluded = 0;
+  };
+
+  uint64_t m_frame = 0;
+  std::vector<size_t> m_hiddenRooms;
+  //! Indexed by room, reused across frames.
+  std::vector<IncomingPortals> m_incomingPortals;
+
+  [[nodiscard]] bool isTraced(const std::vector<engine::world::Room>& rooms, const engine::world::Room& room) const;
+};
+} // namespace render
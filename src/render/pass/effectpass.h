@@ -33,6 +33,11 @@ public:
 
   void render(bool inWater);
 
+  [[nodiscard]] const auto& getName() const
+  {
+    return m_name;
+  }
+
   [[nodiscard]] const auto& getOutput() const
   {
     return m_colorBufferHandle;
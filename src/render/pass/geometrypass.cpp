@@ -55,11 +55,12 @@ GeometryPass::GeometryPass(const glm::ivec2& viewport)
 GeometryPass::~GeometryPass() = default;
 
 // NOLINTNEXTLINE(readability-make-member-function-const)
-void GeometryPass::bind()
+void GeometryPass::bind(const glm::ivec2& viewport)
 {
   m_fb->bind();
   gl::RenderState::resetWantedState();
   gl::RenderState::getWantedState().merge(m_fb->getRenderState());
+  gl::RenderState::getWantedState().setViewport(viewport);
   gl::RenderState::applyWantedState();
 }
 } // namespace render::pass
@@ -14,7 +14,8 @@ class GeometryPass
 public:
   explicit GeometryPass(const glm::ivec2& viewport);
   ~GeometryPass();
-  void bind();
+  //! Binds the render targets, rendering only to the lower left @a viewport pixels.
+  void bind(const glm::ivec2& viewport);
 
   [[nodiscard]] const auto& getNormalBuffer() const
   {
@@ -70,10 +70,14 @@ void HBAOPass::updateCamera(const gslu::nn_shared<scene::Camera>& camera)
   m_material->getUniformBlock("Camera")->bindCameraBuffer(camera);
 }
 
-void HBAOPass::render()
+void HBAOPass::render(const glm::ivec2& viewport)
 {
   SOGLB_DEBUGGROUP("hbao-pass");
+  // the blur reaches beyond the rendered part, which must not darken the edges
+  if(viewport != m_aoBuffer->size())
+    m_aoBuffer->clear(gl::ScalarByte{255});
   m_fb->bind();
+  m_renderMesh->getRenderState().setViewport(viewport);
 
   scene::RenderContext context{scene::RenderMode::Full, std::nullopt};
   m_renderMesh->render(nullptr, context);
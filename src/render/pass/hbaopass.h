@@ -29,7 +29,8 @@ public:
                     const GeometryPass& geometryPass);
   void updateCamera(const gslu::nn_shared<scene::Camera>& camera);
 
-  void render();
+  //! Renders the ambient occlusion of the lower left @a viewport pixels of the AO buffer.
+  void render(const glm::ivec2& viewport);
 
   [[nodiscard]] auto getBlurredTexture() const
   {
@@ -44,6 +44,7 @@ WorldCompositionPass::WorldCompositionPass(scene::MaterialManager& materialManag
     , m_noWaterMesh{scene::createScreenQuad(m_noWaterMaterial, "composition-nowater")}
     , m_inWaterMesh{scene::createScreenQuad(m_inWaterMaterial, "composition-water")}
     , m_bloomMesh{scene::createScreenQuad(materialManager.getBloom(), "composition-bloom")}
+    , m_depthBuffer{std::make_shared<gl::TextureDepth<float>>(viewport, "composition-depth")}
     , m_colorBuffer{std::make_shared<gl::Texture2D<gl::SRGB8>>(viewport, "composition-color")}
     , m_colorBufferHandle{std::make_shared<gl::TextureHandle<gl::Texture2D<gl::SRGB8>>>(
         m_colorBuffer,
@@ -60,7 +61,7 @@ WorldCompositionPass::WorldCompositionPass(scene::MaterialManager& materialManag
           | set(gl::api::TextureMinFilter::Linear) | set(gl::api::TextureMagFilter::Linear))}
     , m_fb{gl::FrameBufferBuilder()
              .textureNoBlend(gl::api::FramebufferAttachment::ColorAttachment0, m_colorBuffer)
-             .textureNoBlend(gl::api::FramebufferAttachment::DepthAttachment, geometryPass.getDepthBuffer())
+             .textureNoBlend(gl::api::FramebufferAttachment::DepthAttachment, m_depthBuffer)
              .build("composition-fb")}
     , m_fbBloom{gl::FrameBufferBuilder()
                   .textureNoBlend(gl::api::FramebufferAttachment::ColorAttachment0, m_bloomedBuffer)
@@ -57,6 +57,7 @@ private:
   gslu::nn_shared<scene::Mesh> m_noWaterMesh;
   gslu::nn_shared<scene::Mesh> m_inWaterMesh;
   gslu::nn_shared<scene::Mesh> m_bloomMesh;
+  gslu::nn_shared<gl::TextureDepth<float>> m_depthBuffer;
   gslu::nn_shared<gl::Texture2D<gl::SRGB8>> m_colorBuffer;
   gslu::nn_shared<gl::TextureHandle<gl::Texture2D<gl::SRGB8>>> m_colorBufferHandle;
   gslu::nn_shared<gl::Texture2D<gl::SRGB8>> m_bloomedBuffer;
@@ -4,13 +4,13 @@
 #include "engine/world/room.h"
 #include "engine/world/world.h"
 #include "scene/camera.h"
-#include "scene/node.h"
 
 #include <algorithm>
 #include <array>
 #include <boost/assert.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <cstddef>
+#include <glm/common.hpp>
 #include <glm/fwd.hpp>
 #include <glm/geometric.hpp>
 #include <glm/mat4x4.hpp>
@@ -161,52 +161,71 @@ std::optional<PortalTracer::CullBox> PortalTracer::narrowCullBox(const PortalTra
 bool PortalTracer::traceRoom(const engine::world::Room& room,
                              const PortalTracer::CullBox& roomCullBox,
                              const engine::world::World& world,
-                             std::vector<const engine::world::Room*>& seenRooms,
                              const bool inWater,
-                             std::unordered_set<const engine::world::Portal*>& waterSurfacePortals,
                              const bool startFromWater,
                              int depth)
 {
-  if(std::find(seenRooms.rbegin(), seenRooms.rend(), &room) != seenRooms.rend())
+  const auto roomIndex = gsl::narrow_cast<size_t>(&room - world.getRooms().data());
+  if(m_onPath[roomIndex])
     return false;
-  seenRooms.emplace_back(&room);
+  m_onPath[roomIndex] = true;
+
+  auto& visibility = m_roomVisibilities[roomIndex];
+  if(!visibility.visible)
+  {
+    visibility.visible = true;
+    m_visibleRooms.emplace_back(roomIndex);
+  }
+  visibility.renderOrder = -depth;
 
-  room.node->setVisible(true);
-  room.node->setRenderOrder(-depth);
   for(const auto& portal : room.portals)
   {
     if(const auto narrowedCullBox = narrowCullBox(roomCullBox, portal, world.getCameraController()))
     {
       const auto& childRoom = portal.adjoiningRoom;
       const bool waterChanged = inWater == startFromWater && childRoom->isWaterRoom != startFromWater;
-      childRoom->node->addScissor(narrowedCullBox->min, narrowedCullBox->max - narrowedCullBox->min);
-      if(traceRoom(*childRoom,
-                   *narrowedCullBox,
-                   world,
-                   seenRooms,
-                   inWater || childRoom->isWaterRoom,
-                   waterSurfacePortals,
-                   startFromWater,
-                   depth + 1)
+
+      const auto childIndex = gsl::narrow_cast<size_t>(childRoom.get() - world.getRooms().data());
+      auto& childScissor = m_roomVisibilities[childIndex].scissor;
+      if(childScissor.has_value())
+      {
+        childScissor->min = glm::min(childScissor->min, narrowedCullBox->min);
+        childScissor->max = glm::max(childScissor->max, narrowedCullBox->max);
+      }
+      else
+      {
+        childScissor = narrowedCullBox;
+      }
+
+      if(traceRoom(*childRoom, *narrowedCullBox, world, inWater || childRoom->isWaterRoom, startFromWater, depth + 1)
          && waterChanged)
       {
-        waterSurfacePortals.emplace(&portal);
+        m_waterSurfacePortals.emplace(&portal);
       }
     }
   }
-  seenRooms.pop_back();
+
+  m_onPath[roomIndex] = false;
   return true;
 }
 
-std::unordered_set<const engine::world::Portal*> PortalTracer::trace(const engine::world::Room& startRoom,
-                                                                     const engine::world::World& world)
+void PortalTracer::trace(const engine::world::Room& startRoom, const engine::world::World& world)
 {
-  std::vector<const engine::world::Room*> seenRooms;
-  seenRooms.reserve(32);
-  std::unordered_set<const engine::world::Portal*> waterSurfacePortals;
-  traceRoom(
-    startRoom, {-1, -1, 1, 1}, world, seenRooms, startRoom.isWaterRoom, waterSurfacePortals, startRoom.isWaterRoom, 1);
-  Expects(seenRooms.empty());
-  return waterSurfacePortals;
+  const auto roomCount = world.getRooms().size();
+  if(m_roomVisibilities.size() != roomCount)
+  {
+    m_roomVisibilities.assign(roomCount, RoomVisibility{});
+    m_onPath.assign(roomCount, false);
+  }
+  else
+  {
+    // only the rooms reached by the previous trace carry any state
+    for(const auto roomIndex : m_visibleRooms)
+      m_roomVisibilities[roomIndex] = RoomVisibility{};
+  }
+  m_visibleRooms.clear();
+  m_waterSurfacePortals.clear();
+
+  traceRoom(startRoom, {-1, -1, 1, 1}, world, startRoom.isWaterRoom, startRoom.isWaterRoom, 1);
 }
 } // namespace render
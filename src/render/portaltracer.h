@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <glm/vec2.hpp>
 #include <optional>
 #include <unordered_set>
@@ -19,8 +20,14 @@ struct Portal;
 
 namespace render
 {
-struct PortalTracer
+/**
+ * Determines the rooms visible through the portals of the camera's room, and their screen regions. The per-room
+ * results are kept in flat arrays indexed by the rooms' positions in the level, and are reused between traces so that
+ * only the rooms touched by a trace need to be reset.
+ */
+class PortalTracer final
 {
+public:
   struct CullBox
   {
     glm::vec2 min;
@@ -33,20 +40,48 @@ struct PortalTracer
     }
   };
 
-  static std::unordered_set<const engine::world::Portal*> trace(const engine::world::Room& startRoom,
-                                                                const engine::world::World& world);
+  struct RoomVisibility
+  {
+    bool visible = false;
+    //! The union of all portal-narrowed cull boxes the room is seen through; empty for the start room.
+    std::optional<CullBox> scissor{};
+    int renderOrder = 0;
+  };
+
+  void trace(const engine::world::Room& startRoom, const engine::world::World& world);
+
+  //! The indices of all rooms reached by the last trace, in the order they were first reached.
+  [[nodiscard]] const auto& getVisibleRooms() const
+  {
+    return m_visibleRooms;
+  }
 
-  static bool traceRoom(const engine::world::Room& room,
-                        const CullBox& roomCullBox,
-                        const engine::world::World& world,
-                        std::vector<const engine::world::Room*>& seenRooms,
-                        bool inWater,
-                        std::unordered_set<const engine::world::Portal*>& waterSurfacePortals,
-                        bool startFromWater,
-                        int depth);
+  [[nodiscard]] const RoomVisibility& getRoomVisibility(size_t roomIndex) const
+  {
+    return m_roomVisibilities.at(roomIndex);
+  }
+
+  [[nodiscard]] const auto& getWaterSurfacePortals() const
+  {
+    return m_waterSurfacePortals;
+  }
 
   static std::optional<CullBox> narrowCullBox(const CullBox& parentCullBox,
                                               const engine::world::Portal& portal,
                                               const engine::CameraController& camera);
+
+private:
+  std::vector<RoomVisibility> m_roomVisibilities;
+  //! Rooms on the current portal path, to avoid cycles; a room may still be reached through several paths.
+  std::vector<bool> m_onPath;
+  std::vector<size_t> m_visibleRooms;
+  std::unordered_set<const engine::world::Portal*> m_waterSurfacePortals;
+
+  bool traceRoom(const engine::world::Room& room,
+                 const CullBox& roomCullBox,
+                 const engine::world::World& world,
+                 bool inWater,
+                 bool startFromWater,
+                 int depth);
 };
 } // namespace render
@@ -1,5 +1,7 @@
 #include "renderpipeline.h"
 
+#include "dynamicresolution.h"
+#include "gpuprofiler.h"
 #include "engine/world/room.h"
 #include "pass/effectpass.h"
 #include "pass/geometrypass.h"
@@ -7,19 +9,25 @@
 #include "pass/portalpass.h"
 #include "pass/uipass.h"
 #include "pass/worldcompositionpass.h"
+#include "render/scene/camera.h"
 #include "render/scene/materialmanager.h"
 #include "render/scene/visitor.h"
 #include "rendersettings.h"
 
+#include <algorithm>
+#include <boost/algorithm/string/join.hpp>
 #include <boost/assert.hpp>
 #include <gl/framebuffer.h>
 #include <gl/program.h>
 #include <gl/texture2d.h>
 #include <gl/texturedepth.h>
 #include <gl/texturehandle.h>
+#include <glm/common.hpp>
 #include <glm/vec2.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace render::scene
 {
@@ -31,27 +39,58 @@ class Node;
 namespace render
 {
 RenderPipeline::RenderPipeline(scene::MaterialManager& materialManager,
+                               gslu::nn_shared<GpuProfiler> gpuProfiler,
                                const glm::ivec2& renderViewport,
                                const glm::ivec2& uiViewport,
                                const glm::ivec2& displayViewport)
+    : m_gpuProfiler{std::move(gpuProfiler)}
+    , m_dynamicResolution{gsl::make_unique<DynamicResolution>()}
 {
   resize(materialManager, renderViewport, uiViewport, displayViewport, true);
 }
 
+RenderPipeline::~RenderPipeline() = default;
+
+void RenderPipeline::beginWorld(scene::Camera& camera)
+{
+  float scale = 1.0f;
+  if(m_renderSettings.dynamicResolution)
+  {
+    m_dynamicResolution->beginFrame();
+    scale = m_dynamicResolution->getScale();
+  }
+
+  m_scaledRenderSize = glm::max(glm::ivec2{glm::round(glm::vec2{m_renderSize} * scale)}, glm::ivec2{1});
+  camera.setViewport(m_scaledRenderSize, m_renderSize);
+}
+
 void RenderPipeline::worldCompositionPass(const std::vector<engine::world::Room>& rooms, const bool inWater)
 {
   BOOST_ASSERT(m_portalPass != nullptr);
   if(m_renderSettings.waterDenoise)
+  {
+    const auto gpuScope = m_gpuProfiler->measure("portal-blur-pass");
     m_portalPass->renderBlur();
+  }
 
   BOOST_ASSERT(m_hbaoPass != nullptr);
   if(m_renderSettings.hbao)
-    m_hbaoPass->render();
+  {
+    const auto gpuScope = m_gpuProfiler->measure("hbao-pass");
+    m_hbaoPass->render(glm::max(m_scaledRenderSize / 4, glm::ivec2{1}));
+  }
 
   BOOST_ASSERT(m_worldCompositionPass != nullptr);
-  m_worldCompositionPass->render(inWater);
+  {
+    const auto gpuScope = m_gpuProfiler->measure("world-composition-pass");
+    m_worldCompositionPass->render(inWater);
+  }
+  // everything following the composition runs at the full render size
+  if(m_renderSettings.dynamicResolution)
+    m_dynamicResolution->endFrame();
 
   {
+    const auto gpuScope = m_gpuProfiler->measure("dust-pass");
     render::scene::RenderContext context{render::scene::RenderMode::Full, std::nullopt};
     for(const auto& room : rooms)
     {
@@ -76,6 +115,7 @@ void RenderPipeline::worldCompositionPass(const std::vector<engine::world::Room>
   auto finalOutput = m_worldCompositionPass->getFramebuffer();
   for(const auto& effect : m_effects)
   {
+    const auto gpuScope = m_gpuProfiler->measure(effect->getName());
     effect->render(inWater);
     finalOutput = effect->getFramebuffer();
   }
@@ -96,9 +136,42 @@ void RenderPipeline::updateCamera(const gslu::nn_shared<scene::Camera>& camera)
 void RenderPipeline::apply(const RenderSettings& renderSettings, scene::MaterialManager& materialManager)
 {
   m_renderSettings = renderSettings;
+  m_dynamicResolution->reset();
   resize(materialManager, m_renderSize, m_uiSize, m_displaySize, true);
 }
 
+std::vector<std::vector<std::string>> RenderPipeline::getFusedEffectStages(const RenderSettings& renderSettings)
+{
+  // consecutive effects are fused into as few passes as possible, see fx_fused.frag
+  std::vector<std::vector<std::string>> fxStages{{}};
+  auto addStage = [&fxStages](const std::string& stage, bool startsPass)
+  {
+    if(startsPass && !fxStages.back().empty())
+      fxStages.emplace_back();
+    fxStages.back().emplace_back(stage);
+  };
+
+  if(renderSettings.hbao)
+    addStage("FX_HBAO", false);
+  addStage("FX_UNDERWATER_MOVEMENT", false);
+  addStage("FX_REFLECTIVE", false);
+  // fxaa needs the previous stages' output as a texture
+  if(renderSettings.fxaa)
+    addStage("FX_FXAA", true);
+  if(renderSettings.lensDistortion)
+    addStage("FX_LENS_DISTORTION", false);
+  if(renderSettings.velvia)
+    addStage("FX_VELVIA", false);
+  addStage("FX_DEATH", false);
+  if(renderSettings.filmGrain)
+    addStage("FX_FILM_GRAIN", false);
+  // the crt effect samples its input three times, which would triple the cost of fxaa in the same pass
+  if(renderSettings.crt)
+    addStage("FX_CRT", renderSettings.fxaa);
+
+  return fxStages;
+}
+
 void RenderPipeline::resize(scene::MaterialManager& materialManager,
                             const glm::ivec2& renderViewport,
                             const glm::ivec2& uiViewport,
@@ -111,6 +184,7 @@ void RenderPipeline::resize(scene::MaterialManager& materialManager,
   }
 
   m_renderSize = renderViewport;
+  m_scaledRenderSize = renderViewport;
   m_uiSize = uiViewport;
   m_displaySize = displayViewport;
 
@@ -120,60 +194,55 @@ void RenderPipeline::resize(scene::MaterialManager& materialManager,
   m_worldCompositionPass = std::make_shared<pass::WorldCompositionPass>(
     materialManager, m_renderSettings, m_renderSize, *m_geometryPass, *m_portalPass);
 
+  m_effects.clear();
   auto fxSource = m_worldCompositionPass->getColorBuffer();
-  auto addEffect = [this, &fxSource](const std::string& name, const gslu::nn_shared<render::scene::Material>& material)
+  for(const auto& stages : getFusedEffectStages(m_renderSettings))
   {
-    auto fx = std::make_shared<pass::EffectPass>(gsl::not_null{this}, "fx:" + name, material, fxSource);
+    const auto hasStage = [&stages](const std::string& stage)
+    {
+      return std::find(stages.begin(), stages.end(), stage) != stages.end();
+    };
+
+    auto fx = std::make_shared<pass::EffectPass>(gsl::not_null{this},
+                                                 "fx:" + boost::algorithm::join(stages, "+"),
+                                                 materialManager.getFusedEffect(stages),
+                                                 fxSource);
+    if(hasStage("FX_HBAO"))
+    {
+      fx->bind("u_ao",
+               [texture = m_hbaoPass->getBlurredTexture()](
+                 const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
+               {
+                 uniform.set(texture);
+               });
+    }
+    if(hasStage("FX_REFLECTIVE"))
+    {
+      fx->bind("u_normal",
+               [texture = m_geometryPass->getNormalBuffer()](
+                 const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
+               {
+                 uniform.set(texture);
+               });
+      fx->bind("u_reflective",
+               [texture = m_geometryPass->getReflectiveBuffer()](
+                 const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
+               {
+                 uniform.set(texture);
+               });
+    }
     m_effects.emplace_back(fx);
     fxSource = fx->getOutput();
-    return fx;
-  };
-
-  m_effects.clear();
-  if(m_renderSettings.hbao)
-  {
-    auto fx = addEffect("hbao", materialManager.getHBAOFx());
-    fx->bind("u_ao",
-             [texture = m_hbaoPass->getBlurredTexture()](
-               const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
-             {
-               uniform.set(texture);
-             });
-  }
-  addEffect("underwater-movement", materialManager.getUnderwaterMovement());
-  {
-    auto fx = addEffect("reflective", materialManager.getReflective());
-    fx->bind("u_normal",
-             [texture = m_geometryPass->getNormalBuffer()](
-               const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
-             {
-               uniform.set(texture);
-             });
-    fx->bind("u_reflective",
-             [texture = m_geometryPass->getReflectiveBuffer()](
-               const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
-             {
-               uniform.set(texture);
-             });
   }
-  if(m_renderSettings.fxaa)
-    addEffect("fxaa", materialManager.getFXAA());
-  if(m_renderSettings.lensDistortion)
-    addEffect("lens", materialManager.getLensDistortion());
-  if(m_renderSettings.velvia)
-    addEffect("velvia", materialManager.getVelvia());
-  addEffect("death", materialManager.getDeath());
-  if(m_renderSettings.filmGrain)
-    addEffect("filmGrain", materialManager.getFilmGrain());
-  if(m_renderSettings.crt)
-    addEffect("crt", materialManager.getCRT());
   m_uiPass = std::make_shared<pass::UIPass>(materialManager, m_uiSize, m_displaySize);
 }
 
 gl::RenderState RenderPipeline::bindPortalFrameBuffer()
 {
   BOOST_ASSERT(m_portalPass != nullptr);
-  return m_portalPass->bind();
+  auto state = m_portalPass->bind();
+  state.setViewport(m_scaledRenderSize);
+  return state;
 }
 
 void RenderPipeline::bindUiFrameBuffer()
@@ -189,7 +258,7 @@ void RenderPipeline::bindGeometryFrameBuffer(float farPlane)
   m_geometryPass->getPositionBuffer()->getTexture()->clear({0.0f, 0.0f, -farPlane});
   m_geometryPass->getReflectiveBuffer()->getTexture()->clear({0, 0, 0, 0});
   m_geometryPass->getDepthBuffer()->clear(gl::ScalarDepth{1.0f});
-  m_geometryPass->bind();
+  m_geometryPass->bind(m_scaledRenderSize);
 }
 
 void RenderPipeline::renderUiFrameBuffer(float alpha)
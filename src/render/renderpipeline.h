@@ -8,6 +8,7 @@
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace render::scene
@@ -33,13 +34,19 @@ class EffectPass;
 
 namespace render
 {
+class DynamicResolution;
+class GpuProfiler;
+
 class RenderPipeline
 {
 private:
   const std::chrono::high_resolution_clock::time_point m_creationTime = std::chrono::high_resolution_clock::now();
 
   RenderSettings m_renderSettings{};
+  const gslu::nn_shared<GpuProfiler> m_gpuProfiler;
   glm::ivec2 m_renderSize{-1};
+  //! The part of the world render targets that is actually rendered to, see camera_interface.glsl.
+  glm::ivec2 m_scaledRenderSize{-1};
   glm::ivec2 m_uiSize{-1};
   glm::ivec2 m_displaySize{-1};
   std::shared_ptr<pass::PortalPass> m_portalPass;
@@ -49,12 +56,18 @@ private:
   std::shared_ptr<pass::UIPass> m_uiPass;
 
   std::vector<gslu::nn_shared<pass::EffectPass>> m_effects{};
+  const gslu::nn_unique<DynamicResolution> m_dynamicResolution;
 
 public:
   explicit RenderPipeline(scene::MaterialManager& materialManager,
+                          gslu::nn_shared<GpuProfiler> gpuProfiler,
                           const glm::ivec2& renderViewport,
                           const glm::ivec2& uiViewport,
                           const glm::ivec2& displayViewport);
+  ~RenderPipeline();
+
+  //! Chooses the render scale of the world for the current frame and sets up the camera for it.
+  void beginWorld(scene::Camera& camera);
 
   void bindGeometryFrameBuffer(float farPlane);
   [[nodiscard]] gl::RenderState bindPortalFrameBuffer();
@@ -72,6 +85,9 @@ public:
 
   void apply(const RenderSettings& renderSettings, scene::MaterialManager& materialManager);
 
+  //! The @c FX_* stages of fx_fused.frag of each screen space effect pass enabled by @a renderSettings.
+  [[nodiscard]] static std::vector<std::vector<std::string>> getFusedEffectStages(const RenderSettings& renderSettings);
+
   [[nodiscard]] auto getLocalTime() const
   {
     return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now()
@@ -25,10 +25,12 @@ void RenderSettings::serialize(const serialization::Serializer<engine::EngineCon
       S_NVO("dustActive", dustActive),
       S_NVO("dustDensity", dustDensity),
       S_NVO("highQualityShadows", highQualityShadows),
+      S_NVO("reuseDistantShadows", reuseDistantShadows),
       S_NVO("anisotropyLevel", anisotropyLevel),
       S_NVO("anisotropyActive", anisotropyActive),
       S_NVO("renderResolutionDivisor", renderResolutionDivisor),
       S_NVO("renderResolutionDivisorActive", renderResolutionDivisorActive),
+      S_NVO("dynamicResolution", dynamicResolution),
       S_NVO("uiScaleMultiplier", uiScaleMultiplier),
       S_NVO("uiScaleActive", uiScaleActive),
       S_NVO("glidosPack", glidosPack));
@@ -34,8 +34,11 @@ struct RenderSettings
   bool dustActive = true;
   uint8_t dustDensity = 1;
   bool highQualityShadows = true;
+  bool reuseDistantShadows = false;
   uint8_t renderResolutionDivisor = 2;
   bool renderResolutionDivisorActive = false;
+  //! Scales the world rendering resolution to keep the GPU time within the frame budget; overrides the divisor.
+  bool dynamicResolution = false;
   uint8_t uiScaleMultiplier = 2;
   bool uiScaleActive = false;
   std::optional<std::string> glidosPack = std::nullopt;
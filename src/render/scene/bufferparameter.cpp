@@ -14,30 +14,33 @@ namespace render::scene
 {
 bool BufferParameter::bind(const Node* node, const Mesh& mesh, const gslu::nn_shared<ShaderProgram>& shaderProgram)
 {
-  auto binder = mesh.findShaderStorageBlockBinder(getName());
-  if(!m_bufferBinder && binder == nullptr)
+  const auto binder = findBinder(node, mesh);
+  if(binder == nullptr)
   {
-    if(node != nullptr)
-      binder = node->findShaderStorageBlockBinder(getName());
-    if(binder == nullptr)
-    {
-      // don't have an explicit binder present on material, node or mesh level, assuming it's set on shader level
-      return true;
-    }
+    // don't have an explicit binder present on material, node or mesh level, assuming it's set on shader level
+    return true;
   }
 
   const auto block = findShaderStorageBlock(shaderProgram);
   if(block == nullptr)
     return false;
 
-  if(binder != nullptr)
-    (*binder)(node, mesh, *block);
-  else
-    m_bufferBinder(node, mesh, *block);
-
+  (*binder)(node, mesh, *block);
   return true;
 }
 
+const std::function<BufferParameter::BufferBinder>* BufferParameter::findBinder(const Node* node,
+                                                                                const Mesh& mesh) const
+{
+  if(const auto binder = mesh.findShaderStorageBlockBinder(getName()))
+    return binder;
+  if(m_bufferBinder)
+    return &m_bufferBinder;
+  if(node != nullptr)
+    return node->findShaderStorageBlockBinder(getName());
+  return nullptr;
+}
+
 void BufferParameter::bindBoneTransformBuffer()
 {
   m_bufferBinder = [](const Node* node, const Mesh& /*mesh*/, gl::ShaderStorageBlock& ssb)
@@ -47,6 +50,7 @@ void BufferParameter::bindBoneTransformBuffer()
     else if(const auto* go = dynamic_cast<const engine::ghosting::GhostModel*>(node))
       ssb.bind(go->getMeshMatricesBuffer());
   };
+  setterChanged();
 }
 
 gl::ShaderStorageBlock*
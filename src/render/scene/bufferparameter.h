@@ -36,6 +36,7 @@ public:
     {
       shaderStorageBlock.bind(*value);
     };
+    setterChanged();
   }
 
   template<class ClassType, typename T>
@@ -46,6 +47,7 @@ public:
     {
       shaderStorageBlock.bind((classInstance->*valueMethod)());
     };
+    setterChanged();
   }
 
   using BufferBinder = void(const Node* node, const Mesh& mesh, gl::ShaderStorageBlock& shaderStorageBlock);
@@ -53,15 +55,19 @@ public:
   void bind(std::function<BufferBinder>&& setter)
   {
     m_bufferBinder = std::move(setter);
+    setterChanged();
   }
 
   bool bind(const Node* node, const Mesh& mesh, const gslu::nn_shared<ShaderProgram>& shaderProgram) override;
   void bindBoneTransformBuffer();
 
-private:
+  //! Resolves the binder to use, with precedence mesh > material > node.
+  //! Returns @c nullptr if the block is set on shader level.
+  [[nodiscard]] const std::function<BufferBinder>* findBinder(const Node* node, const Mesh& mesh) const;
   [[nodiscard]] gl::ShaderStorageBlock*
     findShaderStorageBlock(const gslu::nn_shared<ShaderProgram>& shaderProgram) const;
 
+private:
   std::function<BufferBinder> m_bufferBinder;
 };
 } // namespace render::scene
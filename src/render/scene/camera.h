@@ -39,7 +39,7 @@ public:
   {
     m_dirty.set_all();
     m_matrices.aspectRatio = viewport.x / viewport.y;
-    m_matrices.viewport = glm::vec4{viewport, 0, 0};
+    m_matrices.viewport = glm::vec4{viewport, viewport};
     m_matrices.nearPlane = nearPlane;
     m_matrices.farPlane = farPlane;
 
@@ -68,14 +68,29 @@ public:
 
   void setViewport(const glm::vec2& viewport)
   {
-    if(glm::vec2{m_matrices.viewport} == viewport)
+    setViewport(viewport, viewport);
+  }
+
+  /**
+   * Renders into the lower left @a viewport pixels of render targets with a size of @a targetSize. The aspect ratio
+   * follows the render targets, so that scaling the viewport doesn't distort the image.
+   */
+  void setViewport(const glm::vec2& viewport, const glm::vec2& targetSize)
+  {
+    const glm::vec4 newViewport{viewport, targetSize};
+    if(m_matrices.viewport == newViewport)
       return;
 
-    m_matrices.aspectRatio = viewport.x / viewport.y;
-    m_matrices.viewport = glm::vec4{viewport, 0, 0};
+    m_matrices.viewport = newViewport;
+    m_dirty.set(CameraMatrices::DirtyFlag::BufferData);
+
+    const auto aspectRatio = targetSize.x / targetSize.y;
+    if(m_matrices.aspectRatio == aspectRatio)
+      return;
+
+    m_matrices.aspectRatio = aspectRatio;
     m_dirty.set(CameraMatrices::DirtyFlag::Projection);
     m_dirty.set(CameraMatrices::DirtyFlag::ViewProjection);
-    m_dirty.set(CameraMatrices::DirtyFlag::BufferData);
   }
 
   [[nodiscard]] float getNearPlane() const
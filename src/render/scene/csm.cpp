@@ -259,4 +259,21 @@ gl::UniformBuffer<CSMBuffer>& CSM::getBuffer(const glm::mat4& modelMatrix)
   m_buffer.setData(m_bufferData, gl::api::BufferUsage::DynamicDraw);
   return m_buffer;
 }
+
+bool CSM::updateActiveSplit(size_t contentHash)
+{
+  auto& split = m_splits.at(m_activeSplit);
+  const bool isDistant = m_activeSplit >= m_splits.size() / 2;
+  const bool unchanged = split.renderedContentHash == contentHash && split.renderedVpMatrix == split.vpMatrix;
+  if(m_reuseDistantSplits && isDistant && unchanged && !split.reusedLastFrame)
+  {
+    split.reusedLastFrame = true;
+    return false;
+  }
+
+  split.reusedLastFrame = false;
+  split.renderedContentHash = contentHash;
+  split.renderedVpMatrix = split.vpMatrix;
+  return true;
+}
 } // namespace render::scene
@@ -16,6 +16,7 @@
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
 #include <memory>
+#include <optional>
 
 namespace render::scene
 {
@@ -52,6 +53,9 @@ public:
     mutable std::unique_ptr<gl::FenceSync> depthSync;
     mutable std::unique_ptr<gl::FenceSync> squareSync;
     mutable std::unique_ptr<gl::FenceSync> blurSync;
+    glm::mat4 renderedVpMatrix{0.0f};
+    std::optional<size_t> renderedContentHash{};
+    bool reusedLastFrame = false;
 
     void init(int32_t resolution, size_t idx, MaterialManager& materialManager);
     void renderSquare();
@@ -123,6 +127,18 @@ public:
     m_activeSplit = idx;
   }
 
+  void setReuseDistantSplits(bool reuseDistantSplits)
+  {
+    m_reuseDistantSplits = reuseDistantSplits;
+  }
+
+  /**
+   * Decides whether the active split needs to be rendered again. If enabled, distant splits keep their shadow map
+   * from the previous frame if neither the split's matrix nor its shadow casters changed, but never for two frames
+   * in a row, so that changes not reflected in @a contentHash (e.g. animated poses) lag behind at most one frame.
+   */
+  [[nodiscard]] bool updateActiveSplit(size_t contentHash);
+
   void updateCamera(const Camera& camera);
 
   gl::UniformBuffer<CSMBuffer>& getBuffer(const glm::mat4& modelMatrix);
@@ -145,6 +161,7 @@ private:
   const glm::vec3 m_lightDirOrtho{core::TRVec{1_len, 0_len, 0_len}.toRenderSystem()};
   std::array<Split, CSMBuffer::NSplits> m_splits;
   size_t m_activeSplit = 0;
+  bool m_reuseDistantSplits = false;
   CSMBuffer m_bufferData;
   gl::UniformBuffer<CSMBuffer> m_buffer{"csm-data-ubo"};
 };
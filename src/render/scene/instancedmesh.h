@@ -0,0 +1,75 @@
+#pragma once
+
+#include "mesh.h"
+#include "renderable.h"
+
+#include <gl/api/gl.hpp>
+#include <glm/mat4x4.hpp>
+#include <gslu.h>
+#include <utility>
+
+namespace render::scene
+{
+class Node;
+class RenderContext;
+
+//! Entry of the @c InstanceData shader storage buffer used by @c INSTANCED shaders.
+struct Instance
+{
+  glm::mat4 modelMatrix{1.0f};
+  float lightAmbient = 0;
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays, modernize-avoid-c-arrays)
+  float _pad[3]{0.0f, 0.0f, 0.0f};
+};
+static_assert(sizeof(Instance) == 80, "Invalid Instance struct size");
+
+class InstancedMesh final : public Renderable
+{
+public:
+  explicit InstancedMesh(gslu::nn_shared<Mesh> mesh)
+      : m_mesh{std::move(mesh)}
+  {
+  }
+
+  ~InstancedMesh() override = default;
+
+  InstancedMesh(const InstancedMesh&) = delete;
+  InstancedMesh(InstancedMesh&&) = delete;
+  InstancedMesh& operator=(InstancedMesh&&) = delete;
+  InstancedMesh& operator=(const InstancedMesh&) = delete;
+
+  void setInstanceCount(gl::api::core::SizeType instanceCount)
+  {
+    m_instanceCount = instanceCount;
+  }
+
+  [[nodiscard]] auto getInstanceCount() const
+  {
+    return m_instanceCount;
+  }
+
+  void render(const Node* node, RenderContext& context) override
+  {
+    m_mesh->renderInstanced(node, context, m_instanceCount);
+  }
+
+  [[nodiscard]] bool isRenderedIn(RenderMode mode) const override
+  {
+    return m_instanceCount > 0 && m_mesh->isRenderedIn(mode);
+  }
+
+  [[nodiscard]] DrawState getDrawState(RenderMode mode) const override
+  {
+    return m_mesh->getDrawState(mode);
+  }
+
+  [[nodiscard]] bool usesScissorTest() const override
+  {
+    return Renderable::usesScissorTest() && m_mesh->usesScissorTest();
+  }
+
+private:
+  gslu::nn_shared<Mesh> m_mesh;
+  gl::api::core::SizeType m_instanceCount = 0;
+};
+} // namespace render::scene
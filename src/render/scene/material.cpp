@@ -1,11 +1,13 @@
 #include "material.h"
 
 #include "bufferparameter.h"
+#include "materialparameteroverrider.h"
+#include "mesh.h"
+#include "node.h"
 #include "shaderprogram.h"
 #include "uniformparameter.h"
 
 #include <algorithm>
-#include <boost/log/trivial.hpp>
 #include <gl/program.h>
 #include <iosfwd>
 #include <utility>
@@ -14,6 +16,7 @@ namespace render::scene
 {
 Material::Material(gslu::nn_shared<ShaderProgram> shaderProgram)
     : m_shaderProgram{std::move(shaderProgram)}
+    , m_revision{nextBindingRevision()}
 {
   for(const auto& u : m_shaderProgram->getHandle().getUniforms())
     // cppcheck-suppress useStlAlgorithm
@@ -30,40 +33,71 @@ Material::~Material() = default;
 
 void Material::bind(const Node* node, const Mesh& mesh) const
 {
+  const MaterialParameterOverrider& owner
+    = node != nullptr ? static_cast<const MaterialParameterOverrider&>(*node) : mesh;
+
+  const auto* plan = owner.findBindingPlan(this, &mesh);
+  if(plan == nullptr || plan->materialRevision != m_revision
+     || plan->setterRevision != MaterialParameter::getSetterRevision()
+     || plan->meshRevision != mesh.getBindingRevision() || plan->ownerRevision != owner.getBindingRevision())
+  {
+    plan = &owner.storeBindingPlan(buildBindingPlan(node, mesh));
+  }
+
+  for(const auto& [uniform, setter] : plan->uniforms)
+    (*setter)(node, mesh, *uniform);
+  for(const auto& [block, binder] : plan->uniformBlocks)
+    (*binder)(node, mesh, *block);
+  for(const auto& [block, binder] : plan->shaderStorageBlocks)
+    (*binder)(node, mesh, *block);
+
+  m_shaderProgram->bind();
+}
+
+BindingPlan Material::buildBindingPlan(const Node* node, const Mesh& mesh) const
+{
+  const MaterialParameterOverrider& owner
+    = node != nullptr ? static_cast<const MaterialParameterOverrider&>(*node) : mesh;
+
+  BindingPlan plan;
+  plan.material = this;
+  plan.mesh = &mesh;
+  plan.materialRevision = m_revision;
+  plan.setterRevision = MaterialParameter::getSetterRevision();
+  plan.meshRevision = mesh.getBindingRevision();
+  plan.ownerRevision = owner.getBindingRevision();
+
   for(const auto& param : m_uniforms)
   {
-    [[maybe_unused]] const auto success = param->bind(node, mesh, m_shaderProgram);
-#ifndef NDEBUG
-    if(!success)
-    {
-      BOOST_LOG_TRIVIAL(warning) << "Failed to bind material uniform " << param->getName();
-    }
-#endif
+    const auto setter = param->findSetter(node, mesh);
+    if(setter == nullptr)
+      continue;
+
+    if(const auto uniform = param->findUniform(m_shaderProgram))
+      plan.uniforms.emplace_back(uniform, setter);
   }
 
   for(const auto& param : m_uniformBlocks)
   {
-    [[maybe_unused]] const auto success = param->bind(node, mesh, m_shaderProgram);
-#ifndef NDEBUG
-    if(!success)
-    {
-      BOOST_LOG_TRIVIAL(warning) << "Failed to bind material uniform block " << param->getName();
-    }
-#endif
+    const auto binder = param->findBinder(node, mesh);
+    if(binder == nullptr)
+      continue;
+
+    if(const auto block = param->findUniformBlock(m_shaderProgram))
+      plan.uniformBlocks.emplace_back(block, binder);
   }
 
   for(const auto& param : m_buffers)
   {
-    [[maybe_unused]] const auto success = param->bind(node, mesh, m_shaderProgram);
-#ifndef NDEBUG
-    if(!success)
-    {
-      BOOST_LOG_TRIVIAL(warning) << "Failed to bind material buffer " << param->getName();
-    }
-#endif
+    const auto binder = param->findBinder(node, mesh);
+    if(binder == nullptr)
+      continue;
+
+    if(const auto block = param->findShaderStorageBlock(m_shaderProgram))
+      plan.shaderStorageBlocks.emplace_back(block, binder);
   }
 
-  m_shaderProgram->bind();
+  return plan;
 }
 
 std::shared_ptr<UniformParameter> Material::tryGetUniform(const std::string& name) const
@@ -81,6 +115,7 @@ std::shared_ptr<UniformParameter> Material::tryGetUniform(const std::string& nam
     return nullptr;
 
   auto param = std::make_shared<UniformParameter>(name);
+  m_revision = nextBindingRevision();
   m_uniforms.emplace_back(param);
   return param;
 }
@@ -99,6 +134,7 @@ std::shared_ptr<UniformBlockParameter> Material::tryGetUniformBlock(const std::s
   if(m_shaderProgram->findUniformBlock(name) == nullptr)
     return nullptr;
   auto param = std::make_shared<UniformBlockParameter>(name);
+  m_revision = nextBindingRevision();
   m_uniformBlocks.emplace_back(param);
   return param;
 }
@@ -117,6 +153,7 @@ std::shared_ptr<BufferParameter> Material::tryGetBuffer(const std::string& name)
   if(m_shaderProgram->findShaderStorageBlock(name) == nullptr)
     return nullptr;
   auto param = std::make_shared<BufferParameter>(name);
+  m_revision = nextBindingRevision();
   m_buffers.emplace_back(param);
   return param;
 }
@@ -2,6 +2,7 @@
 
 #include <gl/renderstate.h>
 #include <gsl/gsl-lite.hpp>
+#include <cstdint>
 #include <gslu.h>
 #include <memory>
 #include <string>
@@ -9,6 +10,7 @@
 
 namespace render::scene
 {
+struct BindingPlan;
 class BufferParameter;
 class Mesh;
 class Node;
@@ -59,7 +61,11 @@ public:
   }
 
 private:
+  [[nodiscard]] BindingPlan buildBindingPlan(const Node* node, const Mesh& mesh) const;
+
   gslu::nn_shared<ShaderProgram> m_shaderProgram;
+  //! Changes whenever parameters are added, invalidating all binding plans of this material.
+  mutable uint64_t m_revision;
 
   mutable std::vector<gslu::nn_shared<UniformParameter>> m_uniforms;
   mutable std::vector<gslu::nn_shared<UniformBlockParameter>> m_uniformBlocks;
@@ -6,6 +6,7 @@
 #include "node.h"
 #include "renderer.h"
 #include "shadercache.h"
+#include "shaderprogram.h"
 #include "uniformparameter.h"
 
 #include <algorithm>
@@ -23,6 +24,7 @@
 #include <glm/vec2.hpp>
 #include <gslu.h>
 #include <random>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -42,12 +44,13 @@ void configureForScreenSpaceEffect(Material& m, bool enableBlend)
 }
 } // namespace
 
-gslu::nn_shared<Material> MaterialManager::getSprite(bool billboard)
+gslu::nn_shared<Material> MaterialManager::getSprite(bool billboard, bool instanced)
 {
-  if(auto it = m_sprite.find(billboard); it != m_sprite.end())
+  const std::tuple key{billboard, instanced};
+  if(auto it = m_sprite.find(key); it != m_sprite.end())
     return it->second;
 
-  auto m = gsl::make_shared<Material>(m_shaderCache->getGeometry(false, false, true, billboard ? 2 : 1));
+  auto m = gsl::make_shared<Material>(m_shaderCache->getGeometry(false, false, instanced, true, billboard ? 2 : 1));
   m->getRenderState().setCullFace(false);
 
   m->getUniformBlock("Transform")->bindTransformBuffer();
@@ -59,7 +62,7 @@ gslu::nn_shared<Material> MaterialManager::getSprite(bool billboard)
         uniform.set(gsl::not_null{m_geometryTextures});
       });
 
-  m_sprite.emplace(billboard, m);
+  m_sprite.emplace(key, m);
   return m;
 }
 
@@ -86,12 +89,30 @@ gslu::nn_shared<Material> MaterialManager::getCSMDepthOnly(bool skeletal)
   return m;
 }
 
-gslu::nn_shared<Material> MaterialManager::getDepthOnly(bool skeletal)
+gslu::nn_shared<Material> MaterialManager::getDepthOnly(bool skeletal, bool instanced)
 {
-  if(auto it = m_depthOnly.find(skeletal); it != m_depthOnly.end())
+  const std::tuple key{skeletal, instanced};
+  if(auto it = m_depthOnly.find(key); it != m_depthOnly.end())
     return it->second;
 
-  auto m = gsl::make_shared<Material>(m_shaderCache->getDepthOnly(skeletal));
+  auto m = createDepthOnly(m_shaderCache->getDepthOnly(skeletal, instanced));
+  m_depthOnly.emplace(key, m);
+  return m;
+}
+
+gslu::nn_shared<Material> MaterialManager::getRoomDepthOnly()
+{
+  if(m_roomDepthOnly != nullptr)
+    return gsl::not_null{m_roomDepthOnly};
+
+  auto m = createDepthOnly(m_shaderCache->getRoomDepthOnly());
+  m_roomDepthOnly = m;
+  return m;
+}
+
+gslu::nn_shared<Material> MaterialManager::createDepthOnly(const gslu::nn_shared<ShaderProgram>& program)
+{
+  auto m = gsl::make_shared<Material>(program);
   m->getRenderState().setDepthTest(true);
   m->getRenderState().setDepthWrite(true);
   m->getUniformBlock("Transform")->bindTransformBuffer();
@@ -104,19 +125,35 @@ gslu::nn_shared<Material> MaterialManager::getDepthOnly(bool skeletal)
       {
         uniform.set(gsl::not_null{m_geometryTextures});
       });
-
-  m_depthOnly.emplace(skeletal, m);
   return m;
 }
 
-gslu::nn_shared<Material> MaterialManager::getGeometry(bool inWater, bool skeletal, bool roomShadowing)
+gslu::nn_shared<Material> MaterialManager::getGeometry(bool inWater, bool skeletal, bool instanced, bool roomShadowing)
 {
   Expects(m_geometryTextures != nullptr);
-  const std::tuple key{inWater, skeletal, roomShadowing};
+  const std::tuple key{inWater, skeletal, instanced, roomShadowing};
   if(auto it = m_geometry.find(key); it != m_geometry.end())
     return it->second;
 
-  auto m = gsl::make_shared<Material>(m_shaderCache->getGeometry(inWater, skeletal, roomShadowing, 0));
+  auto m = createGeometry(m_shaderCache->getGeometry(inWater, skeletal, instanced, roomShadowing, 0));
+  m_geometry.emplace(key, m);
+  return m;
+}
+
+gslu::nn_shared<Material> MaterialManager::getRoomGeometry(bool inWater)
+{
+  Expects(m_geometryTextures != nullptr);
+  if(auto it = m_roomGeometry.find(inWater); it != m_roomGeometry.end())
+    return it->second;
+
+  auto m = createGeometry(m_shaderCache->getRoomGeometry(inWater));
+  m_roomGeometry.emplace(inWater, m);
+  return m;
+}
+
+gslu::nn_shared<Material> MaterialManager::createGeometry(const gslu::nn_shared<ShaderProgram>& program)
+{
+  auto m = gsl::make_shared<Material>(program);
   m->getUniform("u_diffuseTextures")
     ->bind(
       [this](const Node* /*node*/, const Mesh& /*mesh*/, gl::Uniform& uniform)
@@ -157,7 +194,6 @@ gslu::nn_shared<Material> MaterialManager::getGeometry(bool inWater, bool skelet
       });
   }
 
-  m_geometry.emplace(key, m);
   return m;
 }
 
@@ -197,6 +233,21 @@ gslu::nn_shared<Material> MaterialManager::getWaterSurface()
   return gsl::not_null{m_waterSurface};
 }
 
+gslu::nn_shared<Material> MaterialManager::getPortalOcclusion()
+{
+  if(m_portalOcclusion != nullptr)
+    return gsl::not_null{m_portalOcclusion};
+
+  m_portalOcclusion = std::make_shared<Material>(m_shaderCache->getPortalOcclusion());
+  m_portalOcclusion->getRenderState().setCullFace(false);
+  m_portalOcclusion->getRenderState().setDepthTest(true);
+  m_portalOcclusion->getRenderState().setDepthWrite(false);
+  m_portalOcclusion->getRenderState().setColorWrite(false);
+  m_portalOcclusion->getUniformBlock("Camera")->bindCameraBuffer(m_renderer->getCamera());
+
+  return gsl::not_null{m_portalOcclusion};
+}
+
 gslu::nn_shared<Material> MaterialManager::getLightning()
 {
   if(m_lightning != nullptr)
@@ -255,6 +306,10 @@ gslu::nn_shared<Material> MaterialManager::getWorldComposition(bool inWater, boo
     uniform->set(gsl::not_null{m_noiseTexture});
 
   configureForScreenSpaceEffect(*m, false);
+  // the composition writes the geometry depth at the output resolution for the passes rendered on top of it
+  m->getRenderState().setDepthTest(true);
+  m->getRenderState().setDepthFunction(gl::api::DepthFunction::Always);
+  m->getRenderState().setDepthWrite(true);
 
   m_composition.emplace(key, m);
   return m;
@@ -305,103 +360,27 @@ gslu::nn_shared<Material> MaterialManager::getBackdrop(bool withAlphaMultiplier)
   return m;
 }
 
-gslu::nn_shared<Material> MaterialManager::getFXAA()
-{
-  if(m_fxaa != nullptr)
-    return gsl::not_null{m_fxaa};
-
-  auto m = gsl::make_shared<Material>(m_shaderCache->getFXAA());
-  configureForScreenSpaceEffect(*m, false);
-  m_fxaa = m;
-  return m;
-}
-
-gslu::nn_shared<Material> MaterialManager::getCRT()
-{
-  if(m_crt != nullptr)
-    return gsl::not_null{m_crt};
-
-  auto m = gsl::make_shared<Material>(m_shaderCache->getCRT());
-  m->getUniform("u_noise")->set(gsl::not_null{m_noiseTexture});
-  configureForScreenSpaceEffect(*m, false);
-  m_crt = m;
-  return m;
-}
-
-gslu::nn_shared<Material> MaterialManager::getVelvia()
-{
-  if(m_velvia != nullptr)
-    return gsl::not_null{m_velvia};
-
-  auto m = gsl::make_shared<Material>(m_shaderCache->getVelvia());
-  configureForScreenSpaceEffect(*m, false);
-  m_velvia = m;
-  return m;
-}
-
-gslu::nn_shared<Material> MaterialManager::getDeath()
-{
-  if(m_death != nullptr)
-    return gsl::not_null{m_death};
-
-  auto m = gsl::make_shared<Material>(m_shaderCache->getDeath());
-  configureForScreenSpaceEffect(*m, false);
-  m_death = m;
-  return m;
-}
-
-gslu::nn_shared<Material> MaterialManager::getFilmGrain()
+gslu::nn_shared<Material> MaterialManager::getFusedEffect(const std::vector<std::string>& stages)
 {
-  if(m_filmGrain != nullptr)
-    return gsl::not_null{m_filmGrain};
+  if(auto it = m_fusedEffects.find(stages); it != m_fusedEffects.end())
+    return it->second;
 
-  auto m = gsl::make_shared<Material>(m_shaderCache->getFilmGrain());
-  m->getUniform("u_noise")->set(gsl::not_null{m_noiseTexture});
+  auto m = gsl::make_shared<Material>(m_shaderCache->getFusedEffect(stages));
   configureForScreenSpaceEffect(*m, false);
-  m_filmGrain = m;
-  return m;
-}
-
-gslu::nn_shared<Material> MaterialManager::getLensDistortion()
-{
-  if(m_lensDistortion != nullptr)
-    return gsl::not_null{m_lensDistortion};
-
-  auto m = gsl::make_shared<Material>(m_shaderCache->getLensDistortion());
-  m->getUniformBlock("Camera")->bindCameraBuffer(m_renderer->getCamera());
-
-  m_lensDistortion = m;
-  return m;
-}
-
-gslu::nn_shared<Material> MaterialManager::getHBAOFx()
-{
-  if(m_hbaoFx != nullptr)
-    return gsl::not_null{m_hbaoFx};
-
-  auto m = gsl::make_shared<Material>(m_shaderCache->getHBAOFx());
-  m_hbaoFx = m;
-  return m;
-}
-
-gslu::nn_shared<Material> MaterialManager::getUnderwaterMovement()
-{
-  if(m_underwaterMovement != nullptr)
-    return gsl::not_null{m_underwaterMovement};
-
-  auto m = gsl::make_shared<Material>(m_shaderCache->getUnderwaterMovement());
-  m_underwaterMovement = m;
-  return m;
-}
-
-gslu::nn_shared<Material> MaterialManager::getReflective()
-{
-  if(m_reflective != nullptr)
-    return gsl::not_null{m_reflective};
+  if(auto uniform = m->tryGetUniform("u_noise"))
+    uniform->set(gsl::not_null{m_noiseTexture});
+  if(auto uniformBlock = m->tryGetUniformBlock("Camera"))
+    uniformBlock->bindCameraBuffer(m_renderer->getCamera());
+  if(auto uniform = m->tryGetUniform("u_strength"))
+  {
+    uniform->bind(
+      [this](const Node* /*node*/, const Mesh& /*mesh*/, gl::Uniform& uniform)
+      {
+        uniform.set(m_deathStrength);
+      });
+  }
 
-  auto m = gsl::make_shared<Material>(m_shaderCache->getReflective());
-  configureForScreenSpaceEffect(*m, false);
-  m_reflective = m;
+  m_fusedEffects.emplace(stages, m);
   return m;
 }
 
@@ -519,7 +498,6 @@ gslu::nn_shared<Material> MaterialManager::getDustParticle()
 
 void MaterialManager::setDeathStrength(float strength)
 {
-  auto m = getDeath();
-  m->getUniform("u_strength")->set(strength);
+  m_deathStrength = strength;
 }
 } // namespace render::scene
@@ -8,7 +8,9 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <string>
 #include <tuple>
+#include <vector>
 
 namespace render::scene
 {
@@ -16,21 +18,28 @@ class CSM;
 class Material;
 class Renderer;
 class ShaderCache;
+class ShaderProgram;
 
 class MaterialManager final
 {
 public:
   explicit MaterialManager(gslu::nn_shared<ShaderCache> shaderCache, gslu::nn_shared<Renderer> renderer);
 
-  [[nodiscard]] gslu::nn_shared<Material> getSprite(bool billboard);
+  [[nodiscard]] gslu::nn_shared<Material> getSprite(bool billboard, bool instanced);
 
   [[nodiscard]] gslu::nn_shared<Material> getCSMDepthOnly(bool skeletal);
-  [[nodiscard]] gslu::nn_shared<Material> getDepthOnly(bool skeletal);
+  [[nodiscard]] gslu::nn_shared<Material> getDepthOnly(bool skeletal, bool instanced);
+  //! Depth-only material for the multi-draw room geometry batches.
+  [[nodiscard]] gslu::nn_shared<Material> getRoomDepthOnly();
 
-  [[nodiscard]] gslu::nn_shared<Material> getGeometry(bool inWater, bool skeletal, bool roomShadowing);
+  [[nodiscard]] gslu::nn_shared<Material> getGeometry(bool inWater, bool skeletal, bool instanced, bool roomShadowing);
+  //! Geometry material for the multi-draw room geometry batches.
+  [[nodiscard]] gslu::nn_shared<Material> getRoomGeometry(bool inWater);
   [[nodiscard]] gslu::nn_shared<Material> getGhost();
 
   [[nodiscard]] gslu::nn_shared<Material> getWaterSurface();
+  //! Draws portals for occlusion queries against the depth buffer, without writing anything.
+  [[nodiscard]] gslu::nn_shared<Material> getPortalOcclusion();
 
   [[nodiscard]] gslu::nn_shared<Material> getLightning();
 
@@ -40,15 +49,8 @@ public:
 
   [[nodiscard]] gslu::nn_shared<Material> getDustParticle();
 
-  [[nodiscard]] gslu::nn_shared<Material> getFXAA();
-  [[nodiscard]] gslu::nn_shared<Material> getCRT();
-  [[nodiscard]] gslu::nn_shared<Material> getVelvia();
-  [[nodiscard]] gslu::nn_shared<Material> getDeath();
-  [[nodiscard]] gslu::nn_shared<Material> getFilmGrain();
-  [[nodiscard]] gslu::nn_shared<Material> getLensDistortion();
-  [[nodiscard]] gslu::nn_shared<Material> getHBAOFx();
-  [[nodiscard]] gslu::nn_shared<Material> getUnderwaterMovement();
-  [[nodiscard]] gslu::nn_shared<Material> getReflective();
+  //! Screen space effect chain fused into a single pass; @a stages are the enabled @c FX_* stages of fx_fused.frag.
+  [[nodiscard]] gslu::nn_shared<Material> getFusedEffect(const std::vector<std::string>& stages);
   [[nodiscard]] gslu::nn_shared<Material> getBloom();
 
   [[nodiscard]] gslu::nn_shared<Material> getFlat(bool withAlpha, bool invertY = false, bool withAspectRatio = false);
@@ -73,23 +75,19 @@ private:
   const gslu::nn_shared<ShaderCache> m_shaderCache;
   std::shared_ptr<gl::TextureHandle<gl::Texture2D<gl::RGB8>>> m_noiseTexture;
 
-  std::shared_ptr<Material> m_fxaa{nullptr};
-  std::shared_ptr<Material> m_crt{nullptr};
-  std::shared_ptr<Material> m_velvia{nullptr};
-  std::shared_ptr<Material> m_death{nullptr};
-  std::shared_ptr<Material> m_filmGrain{nullptr};
-  std::shared_ptr<Material> m_lensDistortion{nullptr};
-  std::shared_ptr<Material> m_hbaoFx{nullptr};
-  std::shared_ptr<Material> m_underwaterMovement{nullptr};
-  std::shared_ptr<Material> m_reflective{nullptr};
+  std::map<std::vector<std::string>, gslu::nn_shared<Material>> m_fusedEffects{};
+  float m_deathStrength = 0;
   std::shared_ptr<Material> m_bloom{nullptr};
 
-  std::map<bool, gslu::nn_shared<Material>> m_sprite{};
+  std::map<std::tuple<bool, bool>, gslu::nn_shared<Material>> m_sprite{};
   std::map<bool, gslu::nn_shared<Material>> m_csmDepthOnly{};
-  std::map<bool, gslu::nn_shared<Material>> m_depthOnly{};
-  std::map<std::tuple<bool, bool, bool>, gslu::nn_shared<Material>> m_geometry{};
+  std::map<std::tuple<bool, bool>, gslu::nn_shared<Material>> m_depthOnly{};
+  std::map<std::tuple<bool, bool, bool, bool>, gslu::nn_shared<Material>> m_geometry{};
+  std::shared_ptr<Material> m_roomDepthOnly{nullptr};
+  std::map<bool, gslu::nn_shared<Material>> m_roomGeometry{};
   std::shared_ptr<Material> m_ghost{nullptr};
   std::shared_ptr<Material> m_waterSurface{nullptr};
+  std::shared_ptr<Material> m_portalOcclusion{nullptr};
   std::shared_ptr<Material> m_lightning{nullptr};
   std::map<std::tuple<bool, bool>, gslu::nn_shared<Material>> m_composition{};
   std::shared_ptr<Material> m_ui{nullptr};
@@ -105,5 +103,8 @@ private:
   std::shared_ptr<CSM> m_csm;
   const gslu::nn_shared<Renderer> m_renderer;
   std::shared_ptr<gl::TextureHandle<gl::Texture2DArray<gl::PremultipliedSRGBA8>>> m_geometryTextures;
+
+  [[nodiscard]] gslu::nn_shared<Material> createDepthOnly(const gslu::nn_shared<ShaderProgram>& program);
+  [[nodiscard]] gslu::nn_shared<Material> createGeometry(const gslu::nn_shared<ShaderProgram>& program);
 };
 } // namespace render::scene
@@ -0,0 +1,25 @@
+#include "materialparameter.h"
+
+namespace render::scene
+{
+namespace
+{
+uint64_t bindingRevisionCounter = 0;
+uint64_t setterRevision = 0;
+} // namespace
+
+uint64_t nextBindingRevision()
+{
+  return ++bindingRevisionCounter;
+}
+
+uint64_t MaterialParameter::getSetterRevision()
+{
+  return setterRevision;
+}
+
+void MaterialParameter::setterChanged()
+{
+  setterRevision = nextBindingRevision();
+}
+} // namespace render::scene
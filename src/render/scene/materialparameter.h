@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
+#include <string>
+#include <utility>
 
 namespace render::scene
 {
@@ -9,6 +12,9 @@ class Mesh;
 class Node;
 class ShaderProgram;
 
+//! Returns a new value of a global counter; binding revisions are thus unique and never re-used.
+[[nodiscard]] extern uint64_t nextBindingRevision();
+
 class MaterialParameter
 {
 public:
@@ -26,6 +32,12 @@ public:
     return m_name;
   }
 
+  //! Changes whenever the setter of any material parameter changes.
+  [[nodiscard]] static uint64_t getSetterRevision();
+
+protected:
+  static void setterChanged();
+
 private:
   const std::string m_name;
 };
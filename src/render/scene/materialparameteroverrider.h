@@ -4,9 +4,32 @@
 #include "uniformparameter.h"
 
 #include <boost/container/flat_map.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 namespace render::scene
 {
+class Material;
+class Mesh;
+
+//! The resolved parameter setters of a material for a specific node and mesh, so that binding doesn't need any name
+//! lookups; only valid as long as all revisions match.
+struct BindingPlan
+{
+  const Material* material = nullptr;
+  const Mesh* mesh = nullptr;
+  uint64_t materialRevision = 0;
+  uint64_t setterRevision = 0;
+  uint64_t meshRevision = 0;
+  uint64_t ownerRevision = 0;
+
+  std::vector<std::pair<gl::Uniform*, const std::function<UniformParameter::UniformValueSetter>*>> uniforms;
+  std::vector<std::pair<gl::UniformBlock*, const std::function<UniformBlockParameter::BufferBinder>*>> uniformBlocks;
+  std::vector<std::pair<gl::ShaderStorageBlock*, const std::function<BufferParameter::BufferBinder>*>>
+    shaderStorageBlocks;
+};
+
 template<typename T>
 class SingleMaterialParameterOverrider final
 {
@@ -60,36 +83,74 @@ public:
   void bind(const std::string& name, const std::function<UniformParameter::UniformValueSetter>& setter)
   {
     m_uniformSetters.bind(name, setter);
+    m_bindingRevision = nextBindingRevision();
   }
 
   void bind(const std::string& name, std::function<UniformParameter::UniformValueSetter>&& setter)
   {
     m_uniformSetters.bind(name, std::move(setter));
+    m_bindingRevision = nextBindingRevision();
   }
 
   void bind(const std::string& name, const std::function<BufferParameter::BufferBinder>& binder)
   {
     m_bufferBinders.bind(name, binder);
+    m_bindingRevision = nextBindingRevision();
   }
 
   void bind(const std::string& name, std::function<BufferParameter::BufferBinder>&& binder)
   {
     m_bufferBinders.bind(name, std::move(binder));
+    m_bindingRevision = nextBindingRevision();
   }
 
   void bind(const std::string& name, const std::function<UniformBlockParameter::BufferBinder>& binder)
   {
     m_uniformBlockBinders.bind(name, binder);
+    m_bindingRevision = nextBindingRevision();
   }
 
   void bind(const std::string& name, std::function<UniformBlockParameter::BufferBinder>&& binder)
   {
     m_uniformBlockBinders.bind(name, std::move(binder));
+    m_bindingRevision = nextBindingRevision();
+  }
+
+  //! Changes whenever any setter or binder of this overrider is changed.
+  [[nodiscard]] uint64_t getBindingRevision() const noexcept
+  {
+    return m_bindingRevision;
+  }
+
+  [[nodiscard]] BindingPlan* findBindingPlan(const Material* material, const Mesh* mesh) const
+  {
+    for(auto& plan : m_bindingPlans)
+    {
+      if(plan.material == material && plan.mesh == mesh)
+        return &plan;
+    }
+    return nullptr;
+  }
+
+  BindingPlan& storeBindingPlan(BindingPlan&& plan) const
+  {
+    if(auto existing = findBindingPlan(plan.material, plan.mesh))
+    {
+      *existing = std::move(plan);
+      return *existing;
+    }
+
+    static constexpr size_t MaxBindingPlans = 16;
+    if(m_bindingPlans.size() >= MaxBindingPlans)
+      m_bindingPlans.clear();
+    return m_bindingPlans.emplace_back(std::move(plan));
   }
 
 private:
   SingleMaterialParameterOverrider<UniformParameter::UniformValueSetter> m_uniformSetters;
   SingleMaterialParameterOverrider<UniformBlockParameter::BufferBinder> m_uniformBlockBinders;
   SingleMaterialParameterOverrider<BufferParameter::BufferBinder> m_bufferBinders;
+  uint64_t m_bindingRevision = nextBindingRevision();
+  mutable std::vector<BindingPlan> m_bindingPlans;
 };
 } // namespace render::scene
@@ -77,4 +77,40 @@ void Mesh::render(const Node* node, RenderContext& context)
   context.popState();
   context.popState();
 }
+
+DrawState Mesh::getDrawState(RenderMode mode) const
+{
+  const auto& material = m_materialGroup.get(mode);
+  if(material == nullptr)
+    return {};
+
+  // the mesh's state is applied after the material's state
+  auto blend = getRenderState().getBlend(0);
+  if(!blend.has_value())
+    blend = material->getRenderState().getBlend(0);
+
+  return DrawState{
+    material->getShaderProgram()->getHandle().getHandle(), material.get(), getVertexArrayHandle(), blend};
+}
+
+void Mesh::renderInstanced(const Node* node, RenderContext& context, gl::api::core::SizeType instances)
+{
+  if(instances <= 0)
+    return;
+
+  std::shared_ptr<Material> material = m_materialGroup.get(context.getRenderMode());
+  if(material == nullptr)
+    return;
+
+  context.pushState(material->getRenderState());
+  context.pushState(getRenderState());
+  context.bindState();
+
+  material->bind(node, *this);
+
+  drawIndexBuffer(m_primitiveType, instances);
+
+  context.popState();
+  context.popState();
+}
 } // namespace render::scene
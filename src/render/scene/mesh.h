@@ -8,6 +8,7 @@
 #include <gl/soglb_fwd.h>
 #include <glm/vec2.hpp>
 #include <gsl/gsl-lite.hpp>
+#include <cstdint>
 #include <gslu.h>
 #include <memory>
 #include <string>
@@ -48,11 +49,22 @@ public:
 
   void render(const Node* node, RenderContext& context) final;
 
+  [[nodiscard]] bool isRenderedIn(RenderMode mode) const final
+  {
+    return m_materialGroup.get(mode) != nullptr;
+  }
+
+  [[nodiscard]] DrawState getDrawState(RenderMode mode) const final;
+
+  void renderInstanced(const Node* node, RenderContext& context, gl::api::core::SizeType instances);
+
 private:
   MaterialGroup m_materialGroup{};
   const gl::api::PrimitiveType m_primitiveType{};
 
   virtual void drawIndexBuffer(gl::api::PrimitiveType primitiveType) = 0;
+  virtual void drawIndexBuffer(gl::api::PrimitiveType primitiveType, gl::api::core::SizeType instances) = 0;
+  [[nodiscard]] virtual uint32_t getVertexArrayHandle() const = 0;
 };
 
 template<typename IndexT, typename... VertexTs>
@@ -80,6 +92,16 @@ private:
   {
     m_vao->drawIndexBuffer(primitiveType);
   }
+
+  void drawIndexBuffer(gl::api::PrimitiveType primitiveType, gl::api::core::SizeType instances) override
+  {
+    m_vao->drawIndexBuffer(primitiveType, instances);
+  }
+
+  [[nodiscard]] uint32_t getVertexArrayHandle() const override
+  {
+    return m_vao->getHandle();
+  }
 };
 
 extern gslu::nn_shared<Mesh> createScreenQuad(const glm::vec2& xy,
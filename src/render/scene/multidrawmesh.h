@@ -0,0 +1,88 @@
+#pragma once
+
+#include "mesh.h"
+
+#include <array>
+#include <boost/assert.hpp>
+#include <cstdint>
+#include <gl/api/gl.hpp>
+#include <gl/buffer.h>
+#include <gl/glassert.h>
+#include <gl/vertexarray.h>
+#include <gsl/gsl-lite.hpp>
+#include <gslu.h>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace render::scene
+{
+/**
+ * Draws a list of ranges of a shared vertex array with a single indirect multi-draw call. The shaders are expected
+ * to be compiled with @c MULTI_DRAW; each draw's base instance selects its instance data and scissor region, see
+ * multi_draw.glsl.
+ */
+template<typename IndexT, typename... VertexTs>
+class MultiDrawMesh final : public Mesh
+{
+public:
+  explicit MultiDrawMesh(gslu::nn_shared<gl::VertexArray<IndexT, VertexTs...>> vao, const std::string_view& label)
+      : m_vao{std::move(vao)}
+      , m_commands{gsl::make_shared<gl::DrawIndirectBuffer<gl::DrawElementsIndirectCommand>>(label)}
+  {
+  }
+
+  ~MultiDrawMesh() override = default;
+
+  MultiDrawMesh(const MultiDrawMesh&) = delete;
+  MultiDrawMesh(MultiDrawMesh&&) = delete;
+  MultiDrawMesh& operator=(MultiDrawMesh&&) = delete;
+  MultiDrawMesh& operator=(const MultiDrawMesh&) = delete;
+
+  void setCommands(const std::vector<gl::DrawElementsIndirectCommand>& commands)
+  {
+    m_drawCount = gsl::narrow<gl::api::core::SizeType>(commands.size());
+    if(!commands.empty())
+      m_commands->setData(commands, gl::api::BufferUsage::StreamDraw);
+  }
+
+  [[nodiscard]] auto getDrawCount() const
+  {
+    return m_drawCount;
+  }
+
+private:
+  static constexpr std::array<gl::api::EnableCap, 4> ClipDistances{gl::api::EnableCap::ClipDistance0,
+                                                                   gl::api::EnableCap::ClipDistance1,
+                                                                   gl::api::EnableCap::ClipDistance2,
+                                                                   gl::api::EnableCap::ClipDistance3};
+
+  gslu::nn_shared<gl::VertexArray<IndexT, VertexTs...>> m_vao;
+  gslu::nn_shared<gl::DrawIndirectBuffer<gl::DrawElementsIndirectCommand>> m_commands;
+  gl::api::core::SizeType m_drawCount = 0;
+
+  void drawIndexBuffer(gl::api::PrimitiveType primitiveType) override
+  {
+    if(m_drawCount == 0)
+      return;
+
+    // the per-draw scissor regions are applied through clip distances, as the scissor test can't vary per draw
+    for(const auto cap : ClipDistances)
+      GL_ASSERT(gl::api::enable(cap));
+    m_vao->multiDrawIndirect(primitiveType, *m_commands, m_drawCount);
+    for(const auto cap : ClipDistances)
+      GL_ASSERT(gl::api::disable(cap));
+  }
+
+  void drawIndexBuffer(gl::api::PrimitiveType /*primitiveType*/, gl::api::core::SizeType /*instances*/) override
+  {
+    // every draw already carries its own instance
+    BOOST_ASSERT(false);
+  }
+
+  [[nodiscard]] uint32_t getVertexArrayHandle() const override
+  {
+    return m_vao->getHandle();
+  }
+};
+} // namespace render::scene
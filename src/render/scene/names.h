@@ -8,6 +8,7 @@
 #define VERTEX_ATTRIBUTE_COLOR_BOTTOM_LEFT_NAME "a_colorBottomLeft"
 #define VERTEX_ATTRIBUTE_COLOR_BOTTOM_RIGHT_NAME "a_colorBottomRight"
 #define VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME "a_texCoord"
+#define VERTEX_ATTRIBUTE_TILE_NAME "a_tile"
 #define VERTEX_ATTRIBUTE_BONE_INDEX_NAME "a_boneIndex"
 
 #define VERTEX_ATTRIBUTE_IS_QUAD "a_isQuad"
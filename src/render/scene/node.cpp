@@ -1,9 +1,13 @@
 #include "node.h"
 
 #include "rendercontext.h"
+#include "rendermode.h"
 #include "visitor.h"
 
 #include <gl/renderstate.h>
+#include <glm/common.hpp>
+#include <glm/vec4.hpp>
+#include <limits>
 #include <optional>
 
 namespace render::scene
@@ -20,6 +24,7 @@ Node::~Node()
                                  });
     if(it != p->m_children.end())
       p->m_children.erase(it);
+    p->subtreeBoundsChanged();
   }
 
   m_parent.reset();
@@ -27,15 +32,168 @@ Node::~Node()
   transformChanged();
 }
 
-// NOLINTNEXTLINE(misc-no-recursion)
+BoundingBox BoundingBox::transformed(const glm::mat4& m) const
+{
+  // transform the box as center and half-extents, which yields the tight AABB of the transformed box
+  const auto center = glm::vec3{m * glm::vec4{(min + max) / 2.0f, 1.0f}};
+  const auto halfExtents = (max - min) / 2.0f;
+  glm::vec3 worldHalfExtents{0.0f};
+  for(glm::length_t i = 0; i < 3; ++i)
+    worldHalfExtents += glm::abs(glm::vec3{m[i]}) * halfExtents[i];
+
+  return BoundingBox{center - worldHalfExtents, center + worldHalfExtents};
+}
+
 void Node::transformChanged()
+{
+  invalidateTransform();
+  if(const auto p = m_parent.lock())
+    p->subtreeBoundsChanged();
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void Node::invalidateTransform()
 {
   m_dirty = true;
+  m_worldBoundsDirty = true;
+  m_subtreeBoundsDirty = true;
+
+  for(const auto& child : m_children)
+  {
+    child->invalidateTransform();
+  }
+}
+
+void Node::subtreeBoundsChanged()
+{
+  // a node with dirty subtree bounds always has dirty ancestors, so we can stop at the first dirty one
+  if(m_subtreeBoundsDirty)
+    return;
+
+  m_subtreeBoundsDirty = true;
+  for(auto p = m_parent.lock(); p != nullptr && !p->m_subtreeBoundsDirty; p = p->m_parent.lock())
+    p->m_subtreeBoundsDirty = true;
+}
+
+const std::optional<BoundingBox>& Node::getWorldBounds() const
+{
+  if(!m_worldBoundsDirty)
+    return m_worldBounds;
+
+  m_worldBoundsDirty = false;
+  if(!m_localBounds.has_value())
+  {
+    m_worldBounds.reset();
+    return m_worldBounds;
+  }
+
+  m_worldBounds = m_localBounds->transformed(getModelMatrix());
+  return m_worldBounds;
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+const std::optional<BoundingBox>& Node::getSubtreeBounds() const
+{
+  if(!m_subtreeBoundsDirty)
+    return m_subtreeBounds;
+
+  m_subtreeBoundsDirty = false;
+  m_subtreeBounds.reset();
+  m_subtreeEmpty = m_renderable == nullptr;
+  bool unbounded = false;
+  if(m_renderable != nullptr)
+  {
+    m_subtreeBounds = getWorldBounds();
+    unbounded = !m_subtreeBounds.has_value();
+  }
 
+  // always update all children to keep their dirty flags consistent with ours
   for(const auto& child : m_children)
   {
-    child->transformChanged();
+    const auto& childBounds = child->getSubtreeBounds();
+    if(child->m_subtreeEmpty)
+      continue;
+
+    m_subtreeEmpty = false;
+    if(!childBounds.has_value())
+      unbounded = true;
+    else if(m_subtreeBounds.has_value())
+      m_subtreeBounds->extend(*childBounds);
+    else
+      m_subtreeBounds = childBounds;
   }
+
+  if(unbounded)
+    m_subtreeBounds.reset();
+  return m_subtreeBounds;
+}
+
+bool Node::canBeCulled(const RenderContext& context, bool withScissors) const
+{
+  const auto& bounds = getSubtreeBounds();
+  if(!bounds.has_value())
+    return false;
+
+  // scissors only affect a node's own renderable, and its children may disable the scissor test on their own
+  if(withScissors && m_children.empty())
+    return isOutside(*bounds, context, getCombinedScissors());
+
+  return isOutside(*bounds, context, std::nullopt);
+}
+
+bool Node::isOutside(const BoundingBox& worldBounds,
+                     const RenderContext& context,
+                     const std::optional<std::tuple<glm::vec2, glm::vec2>>& scissors)
+{
+  const auto& viewProjection = context.getViewProjection();
+  if(!viewProjection.has_value())
+    return false;
+
+  // shadow maps are rendered with depth clamping, so near and far planes must not cull there
+  const bool testDepth = context.getRenderMode() != RenderMode::CSMDepthOnly;
+
+  // cull if all corners are outside of the same clip plane; the plane tests are linear in clip space, so they are
+  // also valid for corners behind the camera
+  bool outsideLeft = true;
+  bool outsideRight = true;
+  bool outsideBottom = true;
+  bool outsideTop = true;
+  bool outsideNear = testDepth;
+  bool outsideFar = testDepth;
+  bool allInFront = true;
+  glm::vec2 ndcMin{std::numeric_limits<float>::max()};
+  glm::vec2 ndcMax{std::numeric_limits<float>::lowest()};
+  for(const auto x : {worldBounds.min.x, worldBounds.max.x})
+    for(const auto y : {worldBounds.min.y, worldBounds.max.y})
+      for(const auto z : {worldBounds.min.z, worldBounds.max.z})
+      {
+        const auto clip = *viewProjection * glm::vec4{x, y, z, 1.0f};
+        outsideLeft &= clip.x < -clip.w;
+        outsideRight &= clip.x > clip.w;
+        outsideBottom &= clip.y < -clip.w;
+        outsideTop &= clip.y > clip.w;
+        outsideNear &= clip.z < -clip.w;
+        outsideFar &= clip.z > clip.w;
+
+        if(clip.w <= 0)
+        {
+          allInFront = false;
+          continue;
+        }
+        const auto ndc = glm::vec2{clip} / clip.w;
+        ndcMin = glm::min(ndcMin, ndc);
+        ndcMax = glm::max(ndcMax, ndc);
+      }
+
+  if(outsideLeft || outsideRight || outsideBottom || outsideTop || outsideNear || outsideFar)
+    return true;
+
+  // the projected rectangle is only meaningful if the whole box is in front of the camera
+  if(!scissors.has_value() || !allInFront)
+    return false;
+
+  const auto& [xy, size] = *scissors;
+  return ndcMax.x < xy.x || ndcMax.y < xy.y || ndcMin.x > xy.x + size.x || ndcMin.y > xy.y + size.y;
 }
 
 void Node::accept(Visitor& visitor) const
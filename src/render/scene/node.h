@@ -14,6 +14,7 @@
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -23,6 +24,7 @@
 namespace render::scene
 {
 class Renderable;
+class RenderContext;
 class Visitor;
 
 struct Transform
@@ -30,6 +32,21 @@ struct Transform
   glm::mat4 modelMatrix{1.0f};
 };
 
+struct BoundingBox
+{
+  glm::vec3 min{0.0f};
+  glm::vec3 max{0.0f};
+
+  //! The tight axis-aligned box around this box after transforming it with @a m.
+  [[nodiscard]] BoundingBox transformed(const glm::mat4& m) const;
+
+  void extend(const BoundingBox& other)
+  {
+    min = glm::min(min, other.min);
+    max = glm::max(max, other.max);
+  }
+};
+
 class Node : public MaterialParameterOverrider
 {
 public:
@@ -101,6 +118,8 @@ public:
 
   void setRenderable(const std::shared_ptr<Renderable>& renderable)
   {
+    if((m_renderable == nullptr) != (renderable == nullptr))
+      subtreeBoundsChanged();
     m_renderable = renderable;
   }
 
@@ -119,6 +138,7 @@ public:
     for(auto& child : m_children)
       child->m_parent.reset();
     m_children.clear();
+    subtreeBoundsChanged();
   }
 
   [[nodiscard]] const glm::mat4& getLocalMatrix() const
@@ -160,11 +180,32 @@ public:
     return m_transformBuffer;
   }
 
-  [[nodiscard]] virtual bool canBeCulled(const glm::mat4& /*viewProjection*/) const
+  //! Sets the bounds of this node's renderable in local space; a node with a renderable but without bounds is never
+  //! culled, and neither are its ancestors.
+  void setLocalBounds(const std::optional<BoundingBox>& bounds)
   {
-    return false;
+    m_localBounds = bounds;
+    m_worldBoundsDirty = true;
+    subtreeBoundsChanged();
   }
 
+  [[nodiscard]] const std::optional<BoundingBox>& getLocalBounds() const
+  {
+    return m_localBounds;
+  }
+
+  //! The local bounds transformed to world space; cached until the node's transform changes.
+  [[nodiscard]] const std::optional<BoundingBox>& getWorldBounds() const;
+
+  //! The world bounds of this node and all its descendants; empty if any of them cannot be bounded.
+  [[nodiscard]] const std::optional<BoundingBox>& getSubtreeBounds() const;
+
+  /**
+   * Tests the subtree bounds against the frustum of the context's view projection. Leaf nodes are additionally tested
+   * against their scissor region if @a withScissors is set, which contains the portal-narrowed view into their room.
+   */
+  [[nodiscard]] virtual bool canBeCulled(const RenderContext& context, bool withScissors) const;
+
   void clear()
   {
     auto tmp = m_children;
@@ -172,32 +213,28 @@ public:
       setParent(node, nullptr);
   }
 
-  void clearScissors()
+  void clearScissor()
   {
-    m_scissors.clear();
+    m_scissor.reset();
   }
 
-  void addScissor(const glm::vec2& xy, const glm::vec2& size)
+  void setScissor(const glm::vec2& xy, const glm::vec2& size)
   {
-    m_scissors.emplace_back(xy, size);
+    m_scissor = {xy, size};
   }
 
   std::tuple<glm::vec2, glm::vec2> getCombinedScissors() const
   {
-    if(m_scissors.empty())
+    if(!m_scissor.has_value())
     {
       if(const auto p = m_parent.lock())
         return p->getCombinedScissors();
       else
         return {{-1, -1}, {2, 2}};
     }
-    glm::vec2 min{1, 1};
-    glm::vec2 max{-1, -1};
-    for(const auto& [xy, size] : m_scissors)
-    {
-      min = glm::min(min, xy);
-      max = glm::max(max, xy + size);
-    }
+    const auto& [xy, size] = *m_scissor;
+    glm::vec2 min = xy;
+    glm::vec2 max = xy + size;
     if(const auto p = m_parent.lock())
     {
       const auto [pXy, pSize] = p->getCombinedScissors();
@@ -228,7 +265,14 @@ public:
   }
 
 private:
+  //! Tests a world-space box against the context's frustum, and optionally against a clip-space scissor region.
+  [[nodiscard]] static bool isOutside(const BoundingBox& worldBounds,
+                                      const RenderContext& context,
+                                      const std::optional<std::tuple<glm::vec2, glm::vec2>>& scissors);
+
   void transformChanged();
+  void invalidateTransform();
+  void subtreeBoundsChanged();
 
   std::string m_name;
   List m_children;
@@ -243,7 +287,14 @@ private:
   mutable Transform m_transform{};
   mutable gl::UniformBuffer<Transform> m_transformBuffer;
 
-  std::vector<std::tuple<glm::vec2, glm::vec2>> m_scissors;
+  std::optional<BoundingBox> m_localBounds{};
+  mutable std::optional<BoundingBox> m_worldBounds{};
+  mutable bool m_worldBoundsDirty = true;
+  mutable std::optional<BoundingBox> m_subtreeBounds{};
+  mutable bool m_subtreeEmpty = true;
+  mutable bool m_subtreeBoundsDirty = true;
+
+  std::optional<std::tuple<glm::vec2, glm::vec2>> m_scissor;
 
   int m_renderOrder = 0;
 
@@ -264,6 +315,7 @@ inline void setParent(gslu::nn_shared<Node> node, // NOLINT(performance-unnecess
     BOOST_ASSERT(it != currentParent->m_children.end());
     node->m_parent.reset();
     currentParent->m_children.erase(it);
+    currentParent->subtreeBoundsChanged();
   }
 
   // then add to hierarchy again
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "mesh.h"
+
+#include <cstdint>
+#include <gl/api/gl.hpp>
+#include <gl/vertexarray.h>
+#include <gsl/gsl-lite.hpp>
+#include <gslu.h>
+#include <string_view>
+
+namespace render::scene
+{
+/**
+ * Draws a number of vertices without any vertex buffers; the shaders are expected to generate the vertices from
+ * @c gl_VertexID.
+ */
+class ProceduralMesh final : public Mesh
+{
+public:
+  explicit ProceduralMesh(gl::api::PrimitiveType primitiveType, const std::string_view& label)
+      : Mesh{primitiveType}
+      , m_vao{gsl::make_shared<gl::EmptyVertexArray>(label)}
+  {
+  }
+
+  ~ProceduralMesh() override = default;
+
+  ProceduralMesh(const ProceduralMesh&) = delete;
+  ProceduralMesh(ProceduralMesh&&) = delete;
+  ProceduralMesh& operator=(ProceduralMesh&&) = delete;
+  ProceduralMesh& operator=(const ProceduralMesh&) = delete;
+
+  void setVertexCount(gl::api::core::SizeType vertexCount)
+  {
+    Expects(vertexCount >= 0);
+    m_vertexCount = vertexCount;
+  }
+
+  [[nodiscard]] auto getVertexCount() const
+  {
+    return m_vertexCount;
+  }
+
+private:
+  gslu::nn_shared<gl::EmptyVertexArray> m_vao;
+  gl::api::core::SizeType m_vertexCount = 0;
+
+  void drawIndexBuffer(gl::api::PrimitiveType primitiveType) override
+  {
+    if(m_vertexCount == 0)
+      return;
+
+    m_vao->drawArrays(primitiveType, m_vertexCount);
+  }
+
+  void drawIndexBuffer(gl::api::PrimitiveType primitiveType, gl::api::core::SizeType instances) override
+  {
+    if(m_vertexCount == 0 || instances == 0)
+      return;
+
+    m_vao->drawArrays(primitiveType, m_vertexCount, instances);
+  }
+
+  [[nodiscard]] uint32_t getVertexArrayHandle() const override
+  {
+    return m_vao->getHandle();
+  }
+};
+} // namespace render::scene
@@ -1,12 +1,26 @@
 #pragma once
 
+#include "rendermode.h"
+
+#include <cstdint>
 #include <gl/renderstate.h>
+#include <optional>
 
 namespace render::scene
 {
 class RenderContext;
 class Node;
 
+//! The GPU state a renderable needs for drawing, used to group draws with equal state.
+struct DrawState
+{
+  uint32_t program = 0;
+  const void* material = nullptr;
+  uint32_t vertexArray = 0;
+  //! Whether blending is enabled; empty if it is inherited from the node.
+  std::optional<bool> blend{};
+};
+
 class Renderable
 {
 public:
@@ -20,11 +34,33 @@ public:
 
   virtual void render(const Node* node, RenderContext& context) = 0;
 
+  //! @returns @c false if rendering in the given mode would not draw anything, e.g. for meshes not casting shadows.
+  [[nodiscard]] virtual bool isRenderedIn(RenderMode /*mode*/) const
+  {
+    return true;
+  }
+
+  [[nodiscard]] virtual DrawState getDrawState(RenderMode /*mode*/) const
+  {
+    return {};
+  }
+
+  //! @returns @c false if the render state disables the scissor test, so the draw isn't restricted to portal regions.
+  [[nodiscard]] virtual bool usesScissorTest() const
+  {
+    return m_renderState.getScissorTest().value_or(true);
+  }
+
   gl::RenderState& getRenderState()
   {
     return m_renderState;
   }
 
+  [[nodiscard]] const gl::RenderState& getRenderState() const
+  {
+    return m_renderState;
+  }
+
 private:
   gl::RenderState m_renderState;
 };
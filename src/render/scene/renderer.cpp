@@ -30,7 +30,7 @@ Renderer::~Renderer() = default;
 void Renderer::render()
 {
   {
-    RenderContext context{RenderMode::Full, std::nullopt};
+    RenderContext context{RenderMode::Full, m_camera->getViewProjectionMatrix()};
     Visitor visitor{context};
     m_rootNode->accept(visitor);
     visitor.render(m_camera->getPosition());
@@ -1,13 +1,24 @@
 #include "shadercache.h"
 
 #include "shaderprogram.h"
+#include "util/md5.h"
 
 #include <algorithm>
+#include <array>
 #include <boost/algorithm/string/join.hpp>
 #include <boost/log/trivial.hpp>
+#include <chrono>
+#include <fstream>
+#include <gl/api/gl.hpp>
+#include <gl/glassert.h>
+#include <gl/program.h>
 #include <gl/shader.h>
 #include <gslu.h>
 #include <iosfwd>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
 
 namespace render::scene
 {
@@ -47,41 +58,330 @@ std::string makeId(const std::filesystem::path& shaderPath, std::vector<std::str
   id += boost::algorithm::join(defines, ";");
   return id;
 }
+
+std::string makeId(const ShaderCache::ProgramDescription& description)
+{
+  if(description.geomPath.empty())
+    return makeId(description.vshPath, description.fshPath, description.defines);
+  return makeId(description.vshPath, description.fshPath, description.geomPath, description.defines);
+}
+
+constexpr std::array<char, 4> BinaryMagic{'C', 'E', 'P', 'B'};
+
+//! Upper bound for the time a single pollPending() call spends taking over finished programs.
+constexpr auto PollBudget = std::chrono::milliseconds{50};
+
+std::string getString(const gl::api::StringName name)
+{
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  const auto* str = reinterpret_cast<const char*>(GL_ASSERT_FN(gl::api::getString(name)));
+  return str == nullptr ? std::string{} : std::string{str};
+}
+
+std::optional<gl::ProgramBinary> readBinary(const std::filesystem::path& binaryPath)
+{
+  if(binaryPath.empty() || !std::filesystem::is_regular_file(binaryPath))
+    return std::nullopt;
+
+  std::ifstream file{binaryPath, std::ios::in | std::ios::binary};
+  std::array<char, BinaryMagic.size()> magic{};
+  gl::ProgramBinary binary;
+  file.read(magic.data(), magic.size());
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  file.read(reinterpret_cast<char*>(&binary.format), sizeof(binary.format));
+  if(!file || magic != BinaryMagic)
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Invalid shader binary " << binaryPath;
+    return std::nullopt;
+  }
+  binary.data.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+  return binary;
+}
+
+void removeBinary(const std::filesystem::path& binaryPath)
+{
+  std::error_code ec;
+  std::filesystem::remove(binaryPath, ec);
+  if(ec)
+    BOOST_LOG_TRIVIAL(warning) << "Failed to remove shader binary " << binaryPath << ": " << ec.message();
+}
+
+gl::Program compile(const std::string& programId,
+                    const ShaderCache::ProgramDescription& description,
+                    const std::vector<std::string>& sources,
+                    bool waitForCompilation)
+{
+  const auto& defines = description.defines;
+  auto vert = gl::VertexShader::fromPreprocessed(
+    sources.at(0), makeId(description.vshPath, defines), waitForCompilation);
+  auto frag = gl::FragmentShader::fromPreprocessed(
+    sources.at(1), makeId(description.fshPath, defines), waitForCompilation);
+  if(description.geomPath.empty())
+    return gl::Program{programId, vert, frag};
+
+  auto geom = gl::GeometryShader::fromPreprocessed(
+    sources.at(2), makeId(description.geomPath, defines), waitForCompilation);
+  return gl::Program{programId, vert, frag, geom};
+}
 } // namespace
 
-gslu::nn_shared<ShaderProgram> ShaderCache::get(const std::filesystem::path& vshPath,
-                                                const std::filesystem::path& fshPath,
-                                                const std::vector<std::string>& defines)
+struct ShaderCache::PendingProgram
 {
-  const auto programId = makeId(vshPath, fshPath, defines);
-  BOOST_LOG_TRIVIAL(debug) << "Loading shader program " << programId;
-  const auto it = m_programs.find(programId);
-  if(it != m_programs.end())
-    return it->second;
+  std::string id;
+  ProgramDescription description;
+  //! The preprocessed vertex, fragment and (optional) geometry shader sources.
+  std::vector<std::string> sources;
+  std::filesystem::path binaryPath;
+  gl::Program handle;
+  bool fromBinary;
+};
 
-  auto vert = gl::VertexShader::create(m_root / vshPath, defines, makeId(vshPath, defines));
-  auto frag = gl::FragmentShader::create(m_root / fshPath, defines, makeId(fshPath, defines));
-  auto shader = gsl::make_shared<ShaderProgram>(programId, vert, frag);
-  m_programs.emplace(programId, shader);
+ShaderCache::ShaderCache(std::filesystem::path root, const std::filesystem::path& binaryRoot)
+    : m_root{std::move(root)}
+    , m_binaryFormats{gl::Program::getBinaryFormats()}
+{
+  if(m_binaryFormats.empty())
+  {
+    BOOST_LOG_TRIVIAL(info) << "Driver does not support program binaries, shader binary cache disabled";
+    return;
+  }
+
+  std::error_code ec;
+  std::filesystem::create_directories(binaryRoot, ec);
+  if(ec)
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Failed to create shader binary cache directory " << binaryRoot << ": "
+                               << ec.message();
+    return;
+  }
+
+  m_binaryRoot = binaryRoot;
+  m_driverId = getString(gl::api::StringName::Vendor);
+  m_driverId += '\n';
+  m_driverId += getString(gl::api::StringName::Renderer);
+  m_driverId += '\n';
+  m_driverId += getString(gl::api::StringName::Version);
+  m_driverId += '\n';
+}
+
+ShaderCache::~ShaderCache() = default;
+
+std::filesystem::path ShaderCache::getBinaryPath(const std::vector<std::string>& sources) const
+{
+  if(m_binaryRoot.empty())
+    return {};
+
+  // the preprocessed sources already contain the defines, so they fully identify the program together with the driver
+  std::string key = m_driverId;
+  for(const auto& source : sources)
+  {
+    key += source;
+    key += '\0';
+  }
+  return m_binaryRoot / (util::md5(key.data(), key.size()) + ".bin");
+}
+
+std::unique_ptr<ShaderCache::PendingProgram> ShaderCache::submit(const std::string& programId,
+                                                                 const ProgramDescription& description) const
+{
+  std::vector<std::string> sources{
+    gl::VertexShader::preprocess(m_root / description.vshPath, description.defines),
+    gl::FragmentShader::preprocess(m_root / description.fshPath, description.defines),
+  };
+  if(!description.geomPath.empty())
+    sources.emplace_back(gl::GeometryShader::preprocess(m_root / description.geomPath, description.defines));
+
+  auto binaryPath = getBinaryPath(sources);
+  if(const auto binary = readBinary(binaryPath))
+  {
+    // loading a binary in an unsupported format is an error instead of a link failure, so check it beforehand
+    if(std::find(m_binaryFormats.begin(), m_binaryFormats.end(), binary->format) != m_binaryFormats.end())
+    {
+      return std::make_unique<PendingProgram>(
+        PendingProgram{programId, description, std::move(sources), binaryPath, gl::Program{programId, *binary}, true});
+    }
+
+    BOOST_LOG_TRIVIAL(info) << "Shader binary " << binaryPath << " has a format unsupported by the driver, recompiling";
+    removeBinary(binaryPath);
+  }
+
+  auto handle = compile(programId, description, sources, false);
+  return std::make_unique<PendingProgram>(
+    PendingProgram{programId, description, std::move(sources), binaryPath, std::move(handle), false});
+}
+
+gslu::nn_shared<ShaderProgram> ShaderCache::finish(PendingProgram& pending) const
+{
+  if(pending.handle.getLinkStatus())
+  {
+    auto shader = gsl::make_shared<ShaderProgram>(pending.id, std::move(pending.handle));
+    if(!pending.fromBinary)
+      storeBinary(*shader, pending.binaryPath);
+    return shader;
+  }
+
+  if(pending.fromBinary)
+  {
+    // the driver may reject binaries for any reason, e.g. after an update that did not change its version string
+    BOOST_LOG_TRIVIAL(info) << "Shader binary " << pending.binaryPath << " rejected by driver, recompiling";
+    removeBinary(pending.binaryPath);
+  }
+
+  // compile again, this time waiting for every stage so that errors are reported where they happen
+  auto shader = gsl::make_shared<ShaderProgram>(
+    pending.id, compile(pending.id, pending.description, pending.sources, true));
+  storeBinary(*shader, pending.binaryPath);
   return shader;
 }
 
-gslu::nn_shared<ShaderProgram> ShaderCache::get(const std::filesystem::path& vshPath,
-                                                const std::filesystem::path& fshPath,
-                                                const std::filesystem::path& geomPath,
-                                                const std::vector<std::string>& defines)
+void ShaderCache::storeBinary(const ShaderProgram& program, const std::filesystem::path& binaryPath) const
 {
-  const auto programId = makeId(vshPath, fshPath, geomPath, defines);
+  if(binaryPath.empty())
+    return;
+
+  const auto binary = program.getHandle().getBinary();
+  if(binary.data.empty())
+    return;
+
+  // write to a temporary file first so that an interrupted write never leaves a truncated binary behind
+  auto tmpPath = binaryPath;
+  tmpPath += ".tmp";
+  {
+    std::ofstream file{tmpPath, std::ios::out | std::ios::binary | std::ios::trunc};
+    file.write(BinaryMagic.data(), BinaryMagic.size());
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    file.write(reinterpret_cast<const char*>(&binary.format), sizeof(binary.format));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    file.write(reinterpret_cast<const char*>(binary.data.data()), gsl::narrow<std::streamsize>(binary.data.size()));
+    if(!file)
+    {
+      BOOST_LOG_TRIVIAL(warning) << "Failed to write shader binary " << tmpPath;
+      return;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, binaryPath, ec);
+  if(ec)
+    BOOST_LOG_TRIVIAL(warning) << "Failed to store shader binary " << binaryPath << ": " << ec.message();
+}
+
+gslu::nn_shared<ShaderProgram> ShaderCache::get(const ProgramDescription& description)
+{
+  const auto programId = makeId(description);
   BOOST_LOG_TRIVIAL(debug) << "Loading shader program " << programId;
-  const auto it = m_programs.find(programId);
-  if(it != m_programs.end())
+  if(const auto it = m_programs.find(programId); it != m_programs.end())
     return it->second;
 
-  auto vert = gl::VertexShader::create(m_root / vshPath, defines, makeId(vshPath, defines));
-  auto frag = gl::FragmentShader::create(m_root / fshPath, defines, makeId(fshPath, defines));
-  auto geom = gl::GeometryShader::create(m_root / geomPath, defines, makeId(geomPath, defines));
-  auto shader = gsl::make_shared<ShaderProgram>(programId, vert, frag, geom);
+  std::unique_ptr<PendingProgram> pending;
+  if(const auto it = m_pending.find(programId); it != m_pending.end())
+  {
+    pending = std::move(it->second);
+    m_pending.erase(it);
+  }
+  else
+  {
+    pending = submit(programId, description);
+  }
+
+  auto shader = finish(*pending);
   m_programs.emplace(programId, shader);
   return shader;
 }
+
+void ShaderCache::prepare(const ProgramDescription& description)
+{
+  auto programId = makeId(description);
+  if(m_programs.count(programId) != 0 || m_pending.count(programId) != 0)
+    return;
+
+  auto pending = submit(programId, description);
+  m_pending.emplace(std::move(programId), std::move(pending));
+}
+
+void ShaderCache::prepareAll()
+{
+  for(const bool flag : {false, true})
+  {
+    prepare(describeBackdrop(flag));
+    prepare(describeCSMDepthOnly(flag));
+    prepare(describeDepthOnly(flag, false));
+  }
+  prepare(describeDepthOnly(false, true));
+  prepare(describeRoomDepthOnly());
+
+  for(const bool inWater : {false, true})
+  {
+    for(const bool dof : {false, true})
+      prepare(describeWorldComposition(inWater, dof));
+
+    prepare(describeRoomGeometry(inWater));
+
+    for(const bool roomShadowing : {false, true})
+    {
+      prepare(describeGeometry(inWater, false, false, roomShadowing, 0));
+      prepare(describeGeometry(inWater, true, false, roomShadowing, 0));
+      prepare(describeGeometry(inWater, false, true, roomShadowing, 0));
+      for(const uint8_t spriteMode : {uint8_t{1}, uint8_t{2}})
+      {
+        prepare(describeGeometry(inWater, false, false, roomShadowing, spriteMode));
+        prepare(describeGeometry(inWater, false, true, roomShadowing, spriteMode));
+      }
+    }
+  }
+
+  for(const bool withAlphaMultiplier : {false, true})
+    for(const bool invertY : {false, true})
+      for(const bool withAspectRatio : {false, true})
+        prepare(describeFlat(withAlphaMultiplier, invertY, withAspectRatio));
+
+  for(const uint8_t extent : {uint8_t{2}, uint8_t{4}})
+  {
+    for(const uint8_t blurDim : {uint8_t{1}, uint8_t{2}, uint8_t{3}})
+      prepare(describeFastGaussBlur(extent, blurDim));
+    for(const uint8_t blurDim : {uint8_t{1}, uint8_t{2}})
+      prepare(describeFastBoxBlur(extent, blurDim));
+  }
+
+  for(const auto& description : {describeWaterSurface(),
+                                  describePortalOcclusion(),
+                                  describeHBAO(),
+                                  describeBloom(),
+                                  describeVSMSquare(),
+                                  describeLightning(),
+                                  describeUi(),
+                                  describeDustParticle(),
+                                  describeGhost()})
+  {
+    prepare(description);
+  }
+
+  BOOST_LOG_TRIVIAL(info) << "Submitted " << m_pending.size() << " shader programs for compilation";
+}
+
+size_t ShaderCache::pollPending()
+{
+  const auto deadline = std::chrono::steady_clock::now() + PollBudget;
+  for(auto it = m_pending.begin(); it != m_pending.end() && std::chrono::steady_clock::now() < deadline;)
+  {
+    if(!it->second->handle.isLinkCompleted())
+    {
+      ++it;
+      continue;
+    }
+
+    try
+    {
+      m_programs.emplace(it->first, finish(*it->second));
+    }
+    catch(const std::exception& ex)
+    {
+      // warming up is best effort; the error is raised again if the program is actually requested
+      BOOST_LOG_TRIVIAL(warning) << "Failed to prepare shader program " << it->first << ": " << ex.what();
+    }
+    it = m_pending.erase(it);
+  }
+
+  return m_pending.size();
+}
 } // namespace render::scene
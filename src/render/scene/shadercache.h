@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <gsl/gsl-lite.hpp>
@@ -16,26 +17,53 @@ class ShaderProgram;
 
 class ShaderCache final
 {
-  std::unordered_map<std::string, gslu::nn_shared<ShaderProgram>> m_programs{};
-
-  const std::filesystem::path m_root;
-
 public:
-  explicit ShaderCache(std::filesystem::path root)
-      : m_root{std::move(root)}
+  struct ProgramDescription
   {
-  }
+    std::filesystem::path vshPath;
+    std::filesystem::path fshPath;
+    //! Empty if the program has no geometry shader.
+    std::filesystem::path geomPath{};
+    std::vector<std::string> defines{};
+  };
+
+  explicit ShaderCache(std::filesystem::path root, const std::filesystem::path& binaryRoot);
+  ~ShaderCache();
+
+  [[nodiscard]] gslu::nn_shared<ShaderProgram> get(const ProgramDescription& description);
 
   [[nodiscard]] gslu::nn_shared<ShaderProgram> get(const std::filesystem::path& vshPath,
                                                    const std::filesystem::path& fshPath,
-                                                   const std::vector<std::string>& defines = {});
+                                                   const std::vector<std::string>& defines = {})
+  {
+    return get(ProgramDescription{vshPath, fshPath, {}, defines});
+  }
 
   [[nodiscard]] gslu::nn_shared<ShaderProgram> get(const std::filesystem::path& vshPath,
                                                    const std::filesystem::path& fshPath,
                                                    const std::filesystem::path& geomPath,
-                                                   const std::vector<std::string>& defines = {});
+                                                   const std::vector<std::string>& defines = {})
+  {
+    return get(ProgramDescription{vshPath, fshPath, geomPath, defines});
+  }
 
-  [[nodiscard]] auto getFlat(bool withAlphaMultiplier, bool invertY, bool withAspectRatio)
+  //! Submits the program for compilation without waiting for the driver; get() picks it up when it's needed.
+  void prepare(const ProgramDescription& description);
+
+  //! Submits every program permutation the getters below can return, regardless of the render settings; the fused
+  //! effect programs depend on how the render pipeline groups the effects, and must be prepared separately.
+  void prepareAll();
+
+  //! Takes over pending programs the driver has finished linking, spending at most a few milliseconds; returns the
+  //! number of programs still in flight.
+  size_t pollPending();
+
+  [[nodiscard]] size_t getPendingCount() const
+  {
+    return m_pending.size();
+  }
+
+  [[nodiscard]] static ProgramDescription describeFlat(bool withAlphaMultiplier, bool invertY, bool withAspectRatio)
   {
     std::vector<std::string> defines;
     if(withAlphaMultiplier)
@@ -44,157 +72,269 @@ public:
       defines.emplace_back("INVERT_Y");
     if(withAspectRatio)
       defines.emplace_back("ASPECT_RATIO");
-    return get("flat.vert", "flat.frag", defines);
+    return {"flat.vert", "flat.frag", {}, defines};
   }
 
-  [[nodiscard]] auto getBackdrop(bool withAlphaMultiplier)
+  [[nodiscard]] auto getFlat(bool withAlphaMultiplier, bool invertY, bool withAspectRatio)
+  {
+    return get(describeFlat(withAlphaMultiplier, invertY, withAspectRatio));
+  }
+
+  [[nodiscard]] static ProgramDescription describeBackdrop(bool withAlphaMultiplier)
   {
     std::vector<std::string> defines;
     if(withAlphaMultiplier)
       defines.emplace_back("ALPHA_MULTIPLIER");
-    return get("backdrop.vert", "flat.frag", defines);
+    return {"backdrop.vert", "flat.frag", {}, defines};
+  }
+
+  [[nodiscard]] auto getBackdrop(bool withAlphaMultiplier)
+  {
+    return get(describeBackdrop(withAlphaMultiplier));
   }
 
-  [[nodiscard]] auto getGeometry(bool inWater, bool skeletal, bool roomShadowing, uint8_t spriteMode)
+  [[nodiscard]] static ProgramDescription
+    describeGeometry(bool inWater, bool skeletal, bool instanced, bool roomShadowing, uint8_t spriteMode)
   {
+    Expects(!skeletal || !instanced);
     std::vector<std::string> defines;
     if(inWater)
       defines.emplace_back("IN_WATER");
     if(skeletal)
       defines.emplace_back("SKELETAL");
+    if(instanced)
+      defines.emplace_back("INSTANCED");
     if(roomShadowing)
       defines.emplace_back("ROOM_SHADOWING");
     defines.emplace_back("SPRITEMODE " + std::to_string(int(spriteMode)));
-    return get("geometry.vert", "geometry.frag", defines);
+    return {"geometry.vert", "geometry.frag", {}, defines};
   }
 
-  [[nodiscard]] auto getCSMDepthOnly(bool skeletal)
+  [[nodiscard]] auto getGeometry(bool inWater, bool skeletal, bool instanced, bool roomShadowing, uint8_t spriteMode)
+  {
+    return get(describeGeometry(inWater, skeletal, instanced, roomShadowing, spriteMode));
+  }
+
+  //! Room geometry, drawn per material with a single multi-draw call; see multi_draw.glsl.
+  [[nodiscard]] static ProgramDescription describeRoomGeometry(bool inWater)
+  {
+    std::vector<std::string> defines;
+    if(inWater)
+      defines.emplace_back("IN_WATER");
+    defines.emplace_back("INSTANCED");
+    defines.emplace_back("MULTI_DRAW");
+    defines.emplace_back("ROOM_SHADOWING");
+    defines.emplace_back("SPRITEMODE 0");
+    return {"geometry.vert", "geometry.frag", {}, defines};
+  }
+
+  [[nodiscard]] auto getRoomGeometry(bool inWater)
+  {
+    return get(describeRoomGeometry(inWater));
+  }
+
+  [[nodiscard]] static ProgramDescription describeCSMDepthOnly(bool skeletal)
   {
     std::vector<std::string> defines;
     if(skeletal)
       defines.emplace_back("SKELETAL");
-    return get("csm_depth_only.vert", "empty.frag", defines);
+    return {"csm_depth_only.vert", "empty.frag", {}, defines};
+  }
+
+  [[nodiscard]] auto getCSMDepthOnly(bool skeletal)
+  {
+    return get(describeCSMDepthOnly(skeletal));
   }
 
-  [[nodiscard]] auto getDepthOnly(bool skeletal)
+  [[nodiscard]] static ProgramDescription describeDepthOnly(bool skeletal, bool instanced)
   {
+    Expects(!skeletal || !instanced);
     std::vector<std::string> defines;
     if(skeletal)
       defines.emplace_back("SKELETAL");
-    return get("depth_only.vert", "depth_only.frag", defines);
+    if(instanced)
+      defines.emplace_back("INSTANCED");
+    return {"depth_only.vert", "depth_only.frag", {}, defines};
   }
 
-  [[nodiscard]] auto getWaterSurface()
+  [[nodiscard]] auto getDepthOnly(bool skeletal, bool instanced)
   {
-    return get("water_surface.vert", "water_surface.frag");
+    return get(describeDepthOnly(skeletal, instanced));
   }
 
-  [[nodiscard]] auto getFXAA()
+  [[nodiscard]] static ProgramDescription describeRoomDepthOnly()
   {
-    return get("flat.vert", "fx_fxaa.frag");
+    return {"depth_only.vert", "depth_only.frag", {}, {"INSTANCED", "MULTI_DRAW"}};
   }
 
-  [[nodiscard]] auto getCRT()
+  [[nodiscard]] auto getRoomDepthOnly()
   {
-    return get("flat.vert", "fx_crt.frag");
+    return get(describeRoomDepthOnly());
   }
 
-  [[nodiscard]] auto getVelvia()
+  [[nodiscard]] static ProgramDescription describeWaterSurface()
   {
-    return get("flat.vert", "fx_velvia.frag");
+    return {"water_surface.vert", "water_surface.frag"};
   }
 
-  [[nodiscard]] auto getDeath()
+  [[nodiscard]] auto getWaterSurface()
   {
-    return get("flat.vert", "fx_death.frag");
+    return get(describeWaterSurface());
   }
 
-  [[nodiscard]] auto getFilmGrain()
+  [[nodiscard]] static ProgramDescription describePortalOcclusion()
   {
-    return get("flat.vert", "fx_film_grain.frag");
+    return {"water_surface.vert", "empty.frag"};
   }
 
-  [[nodiscard]] auto getLensDistortion()
+  [[nodiscard]] auto getPortalOcclusion()
   {
-    return get("flat.vert", "fx_lens_distortion.frag");
+    return get(describePortalOcclusion());
   }
 
-  [[nodiscard]] auto getHBAOFx()
+  //! @param stages the enabled @c FX_* stages of fx_fused.frag
+  [[nodiscard]] static ProgramDescription describeFusedEffect(const std::vector<std::string>& stages)
   {
-    return get("flat.vert", "fx_hbao.frag");
+    Expects(!stages.empty());
+    return {"flat.vert", "fx_fused.frag", {}, stages};
   }
 
-  [[nodiscard]] auto getUnderwaterMovement()
+  [[nodiscard]] auto getFusedEffect(const std::vector<std::string>& stages)
   {
-    return get("flat.vert", "fx_underwater_movement.frag");
+    return get(describeFusedEffect(stages));
+  }
+
+  [[nodiscard]] static ProgramDescription describeHBAO()
+  {
+    return {"flat.vert", "hbao.frag"};
   }
 
   [[nodiscard]] auto getHBAO()
   {
-    return get("flat.vert", "hbao.frag");
+    return get(describeHBAO());
   }
 
-  [[nodiscard]] auto getReflective()
+  [[nodiscard]] static ProgramDescription describeBloom()
   {
-    return get("flat.vert", "fx_reflective.frag");
+    return {"flat.vert", "fx_bloom.frag"};
   }
 
   [[nodiscard]] auto getBloom()
   {
-    return get("flat.vert", "fx_bloom.frag");
+    return get(describeBloom());
   }
 
-  [[nodiscard]] auto getFastGaussBlur(const uint8_t extent, uint8_t blurDim)
+  [[nodiscard]] static ProgramDescription describeFastGaussBlur(const uint8_t extent, uint8_t blurDim)
   {
     Expects(extent > 0);
     Expects(blurDim > 0);
     Expects(blurDim <= 3);
     std::vector<std::string> defines{"BLUR_DIM " + std::to_string(blurDim)};
-    return get("flat.vert", "blur_fast_gauss_" + std::to_string(extent * 2 + 1) + ".frag", defines);
+    return {"flat.vert", "blur_fast_gauss_" + std::to_string(extent * 2 + 1) + ".frag", {}, defines};
   }
 
-  [[nodiscard]] auto getFastBoxBlur(const uint8_t extent, uint8_t blurDim)
+  [[nodiscard]] auto getFastGaussBlur(const uint8_t extent, uint8_t blurDim)
+  {
+    return get(describeFastGaussBlur(extent, blurDim));
+  }
+
+  [[nodiscard]] static ProgramDescription describeFastBoxBlur(const uint8_t extent, uint8_t blurDim)
   {
     Expects(extent > 0);
     Expects(blurDim > 0);
     Expects(blurDim < 3);
     std::vector<std::string> defines{"BLUR_DIM " + std::to_string(blurDim)};
-    return get("flat.vert", "blur_fast_box_" + std::to_string(extent * 2 + 1) + ".frag", defines);
+    return {"flat.vert", "blur_fast_box_" + std::to_string(extent * 2 + 1) + ".frag", {}, defines};
+  }
+
+  [[nodiscard]] auto getFastBoxBlur(const uint8_t extent, uint8_t blurDim)
+  {
+    return get(describeFastBoxBlur(extent, blurDim));
+  }
+
+  [[nodiscard]] static ProgramDescription describeVSMSquare()
+  {
+    return {"flat.vert", "vsm_square.frag"};
   }
 
   [[nodiscard]] auto getVSMSquare()
   {
-    return get("flat.vert", "vsm_square.frag");
+    return get(describeVSMSquare());
   }
 
-  [[nodiscard]] auto getWorldComposition(bool inWater, bool dof)
+  [[nodiscard]] static ProgramDescription describeWorldComposition(bool inWater, bool dof)
   {
     std::vector<std::string> defines;
     if(inWater)
       defines.emplace_back("IN_WATER");
     if(dof)
       defines.emplace_back("DOF");
-    return get("flat.vert", "composition.frag", defines);
+    return {"flat.vert", "composition.frag", {}, defines};
+  }
+
+  [[nodiscard]] auto getWorldComposition(bool inWater, bool dof)
+  {
+    return get(describeWorldComposition(inWater, dof));
+  }
+
+  [[nodiscard]] static ProgramDescription describeLightning()
+  {
+    return {"lightning.vert", "lightning.frag"};
   }
 
   [[nodiscard]] auto getLightning()
   {
-    return get("lightning.vert", "lightning.frag");
+    return get(describeLightning());
+  }
+
+  [[nodiscard]] static ProgramDescription describeUi()
+  {
+    return {"ui.vert", "ui.frag"};
   }
 
   [[nodiscard]] auto getUi()
   {
-    return get("ui.vert", "ui.frag");
+    return get(describeUi());
+  }
+
+  [[nodiscard]] static ProgramDescription describeDustParticle()
+  {
+    return {"dust.vert", "dust.frag", "dust.geom"};
   }
 
   [[nodiscard]] auto getDustParticle()
   {
-    return get("dust.vert", "dust.frag", "dust.geom");
+    return get(describeDustParticle());
+  }
+
+  [[nodiscard]] static ProgramDescription describeGhost()
+  {
+    return {"ghost.vert", "ghost.frag", {}, {"SKELETAL"}};
   }
 
   [[nodiscard]] auto getGhost()
   {
-    return get("ghost.vert", "ghost.frag", std::vector<std::string>{"SKELETAL"});
+    return get(describeGhost());
   }
+
+private:
+  struct PendingProgram;
+
+  std::unordered_map<std::string, gslu::nn_shared<ShaderProgram>> m_programs{};
+  std::unordered_map<std::string, std::unique_ptr<PendingProgram>> m_pending{};
+
+  const std::filesystem::path m_root;
+  //! Where linked program binaries are persisted; empty if the driver does not support program binaries.
+  std::filesystem::path m_binaryRoot;
+  //! Vendor, renderer and version of the driver, as binaries are only valid for the driver that created them.
+  std::string m_driverId;
+  //! Formats of program binaries the driver accepts.
+  const std::vector<uint32_t> m_binaryFormats;
+
+  [[nodiscard]] std::filesystem::path getBinaryPath(const std::vector<std::string>& sources) const;
+  [[nodiscard]] std::unique_ptr<PendingProgram> submit(const std::string& programId,
+                                                       const ProgramDescription& description) const;
+  [[nodiscard]] gslu::nn_shared<ShaderProgram> finish(PendingProgram& pending) const;
+  void storeBinary(const ShaderProgram& program, const std::filesystem::path& binaryPath) const;
 };
 } // namespace render::scene
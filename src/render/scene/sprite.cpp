@@ -13,6 +13,7 @@
 #include <gl/vertexarray.h>
 #include <gl/vertexbuffer.h>
 #include <gslu.h>
+#include <tuple>
 #include <vector>
 
 namespace render::scene
@@ -51,6 +52,36 @@ gslu::nn_shared<gl::VertexBuffer<SpriteVertex>> createSpriteVertexBuffer(float x
   vb->setData(vertices, gl::api::BufferUsage::StaticDraw);
   return vb;
 }
+
+gslu::nn_shared<gl::VertexArray<uint16_t, SpriteVertex>> createSpriteVertexArray(float x0,
+                                                                                  float y0,
+                                                                                  float x1,
+                                                                                  float y1,
+                                                                                  const glm::vec2& t0,
+                                                                                  const glm::vec2& t1,
+                                                                                  const Material& material,
+                                                                                  int textureIdx,
+                                                                                  const std::string& label)
+{
+  auto vb = createSpriteVertexBuffer(x0, y0, x1, y1, t0, t1, textureIdx, label);
+  static const std::array<uint16_t, 6> indices{0, 1, 2, 0, 2, 3};
+
+  auto indexBuffer = gsl::make_shared<gl::ElementArrayBuffer<uint16_t>>(label);
+  indexBuffer->setData(indices, gl::api::BufferUsage::StaticDraw);
+
+  return gsl::make_shared<gl::VertexArray<uint16_t, SpriteVertex>>(
+    indexBuffer, vb, std::vector{&material.getShaderProgram()->getHandle()}, label);
+}
+
+gslu::nn_shared<Mesh> createSpriteMeshFromVertexArray(
+  const gslu::nn_shared<gl::VertexArray<uint16_t, SpriteVertex>>& vao, const gslu::nn_shared<Material>& material)
+{
+  auto mesh = gsl::make_shared<MeshImpl<uint16_t, SpriteVertex>>(vao);
+  mesh->getMaterialGroup().set(RenderMode::Full, material);
+  mesh->getRenderState().setScissorTest(false);
+
+  return mesh;
+}
 } // namespace
 
 gslu::nn_shared<Mesh> createSpriteMesh(const float x0,
@@ -63,19 +94,25 @@ gslu::nn_shared<Mesh> createSpriteMesh(const float x0,
                                        const int textureIdx,
                                        const std::string& label)
 {
-  auto vb = createSpriteVertexBuffer(x0, y0, x1, y1, t0, t1, textureIdx, label);
-  static const std::array<uint16_t, 6> indices{0, 1, 2, 0, 2, 3};
-
-  auto indexBuffer = gsl::make_shared<gl::ElementArrayBuffer<uint16_t>>(label);
-  indexBuffer->setData(indices, gl::api::BufferUsage::StaticDraw);
-
-  auto vao = gsl::make_shared<gl::VertexArray<uint16_t, SpriteVertex>>(
-    indexBuffer, vb, std::vector{&materialFull->getShaderProgram()->getHandle()}, label);
-  auto mesh = gsl::make_shared<MeshImpl<uint16_t, SpriteVertex>>(vao);
-  mesh->getMaterialGroup().set(RenderMode::Full, materialFull);
-  mesh->getRenderState().setScissorTest(false);
+  return createSpriteMeshFromVertexArray(
+    createSpriteVertexArray(x0, y0, x1, y1, t0, t1, *materialFull, textureIdx, label), materialFull);
+}
 
-  return mesh;
+std::tuple<gslu::nn_shared<Mesh>, gslu::nn_shared<Mesh>>
+  createSpriteMeshWithInstanced(const float x0,
+                                const float y0,
+                                const float x1,
+                                const float y1,
+                                const glm::vec2& t0,
+                                const glm::vec2& t1,
+                                const gslu::nn_shared<Material>& materialFull,
+                                const gslu::nn_shared<Material>& materialInstanced,
+                                const int textureIdx,
+                                const std::string& label)
+{
+  // both meshes share the same vertex data; attribute locations are fixed, so one VAO serves both programs
+  const auto vao = createSpriteVertexArray(x0, y0, x1, y1, t0, t1, *materialFull, textureIdx, label);
+  return {createSpriteMeshFromVertexArray(vao, materialFull), createSpriteMeshFromVertexArray(vao, materialInstanced)};
 }
 
 gl::VertexLayout<SpriteVertex> SpriteVertex::getLayout()
@@ -9,6 +9,7 @@
 #include <gslu.h>
 #include <memory>
 #include <string>
+#include <tuple>
 
 namespace render::scene
 {
@@ -35,4 +36,19 @@ extern gslu::nn_shared<Mesh> createSpriteMesh(float x0,
                                               const gslu::nn_shared<Material>& materialFull,
                                               int textureIdx,
                                               const std::string& label);
+
+/**
+ * @brief Creates a sprite mesh, plus a second mesh sharing its vertex data that is meant to be drawn instanced.
+ */
+extern std::tuple<gslu::nn_shared<Mesh>, gslu::nn_shared<Mesh>>
+  createSpriteMeshWithInstanced(float x0,
+                                float y0,
+                                float x1,
+                                float y1,
+                                const glm::vec2& t0,
+                                const glm::vec2& t1,
+                                const gslu::nn_shared<Material>& materialFull,
+                                const gslu::nn_shared<Material>& materialInstanced,
+                                int textureIdx,
+                                const std::string& label);
 } // namespace render::scene
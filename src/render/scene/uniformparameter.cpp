@@ -12,30 +12,33 @@ namespace render::scene
 {
 bool UniformParameter::bind(const Node* node, const Mesh& mesh, const gslu::nn_shared<ShaderProgram>& shaderProgram)
 {
-  auto setter = mesh.findUniformSetter(getName());
-  if(!m_valueSetter && setter == nullptr)
+  const auto setter = findSetter(node, mesh);
+  if(setter == nullptr)
   {
-    if(node != nullptr)
-      setter = node->findUniformSetter(getName());
-    if(setter == nullptr)
-    {
-      // don't have an explicit setter present on material, node or mesh level, assuming it's set on shader level
-      return true;
-    }
+    // don't have an explicit setter present on material, node or mesh level, assuming it's set on shader level
+    return true;
   }
 
   const auto uniform = findUniform(shaderProgram);
   if(uniform == nullptr)
     return false;
 
-  if(setter != nullptr)
-    (*setter)(node, mesh, *uniform);
-  else
-    m_valueSetter(node, mesh, *uniform);
-
+  (*setter)(node, mesh, *uniform);
   return true;
 }
 
+const std::function<UniformParameter::UniformValueSetter>* UniformParameter::findSetter(const Node* node,
+                                                                                        const Mesh& mesh) const
+{
+  if(const auto setter = mesh.findUniformSetter(getName()))
+    return setter;
+  if(m_valueSetter)
+    return &m_valueSetter;
+  if(node != nullptr)
+    return node->findUniformSetter(getName());
+  return nullptr;
+}
+
 gl::Uniform* UniformParameter::findUniform(const gslu::nn_shared<ShaderProgram>& shaderProgram) const
 {
   if(const auto uniform = shaderProgram->findUniform(getName()))
@@ -50,30 +53,33 @@ bool UniformBlockParameter::bind(const Node* node,
                                  const Mesh& mesh,
                                  const gslu::nn_shared<ShaderProgram>& shaderProgram)
 {
-  auto binder = mesh.findUniformBlockBinder(getName());
-  if(!m_bufferBinder && binder == nullptr)
+  const auto binder = findBinder(node, mesh);
+  if(binder == nullptr)
   {
-    if(node != nullptr)
-      binder = node->findUniformBlockBinder(getName());
-    if(binder == nullptr)
-    {
-      // don't have an explicit binder present on material, node or mesh level, assuming it's set on shader level
-      return true;
-    }
+    // don't have an explicit binder present on material, node or mesh level, assuming it's set on shader level
+    return true;
   }
 
   const auto block = findUniformBlock(shaderProgram);
   if(block == nullptr)
     return false;
 
-  if(binder != nullptr)
-    (*binder)(node, mesh, *block);
-  else
-    m_bufferBinder(node, mesh, *block);
-
+  (*binder)(node, mesh, *block);
   return true;
 }
 
+const std::function<UniformBlockParameter::BufferBinder>* UniformBlockParameter::findBinder(const Node* node,
+                                                                                            const Mesh& mesh) const
+{
+  if(const auto binder = mesh.findUniformBlockBinder(getName()))
+    return binder;
+  if(m_bufferBinder)
+    return &m_bufferBinder;
+  if(node != nullptr)
+    return node->findUniformBlockBinder(getName());
+  return nullptr;
+}
+
 void UniformBlockParameter::bindTransformBuffer()
 {
   m_bufferBinder = [](const Node* node, const Mesh& /*mesh*/, gl::UniformBlock& ub)
@@ -81,14 +87,22 @@ void UniformBlockParameter::bindTransformBuffer()
     Expects(node != nullptr);
     ub.bind(node->getTransformBuffer());
   };
+  m_boundCamera = nullptr;
+  setterChanged();
 }
 
 void UniformBlockParameter::bindCameraBuffer(const gslu::nn_shared<Camera>& camera)
 {
+  // called every frame, so only changes of the camera may invalidate the cached binding plans
+  if(m_boundCamera == camera.get())
+    return;
+
+  m_boundCamera = camera.get();
   m_bufferBinder = [camera](const Node* /*node*/, const Mesh& /*mesh*/, gl::UniformBlock& ub)
   {
     ub.bind(camera->getMatricesBuffer());
   };
+  setterChanged();
 }
 
 gl::UniformBlock* UniformBlockParameter::findUniformBlock(const gslu::nn_shared<ShaderProgram>& shaderProgram) const
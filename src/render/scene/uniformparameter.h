@@ -38,6 +38,7 @@ public:
     {
       uniform.set(value);
     };
+    setterChanged();
   }
 
   template<class ClassType, class ValueType>
@@ -47,6 +48,7 @@ public:
     {
       uniform.set((classInstance->*valueMethod)());
     };
+    setterChanged();
   }
 
   using UniformValueSetter = void(const Node* node, const Mesh& mesh, gl::Uniform& uniform);
@@ -54,6 +56,7 @@ public:
   void bind(std::function<UniformValueSetter>&& setter)
   {
     m_valueSetter = std::move(setter);
+    setterChanged();
   }
 
   template<class ClassType, class ValueType>
@@ -66,13 +69,17 @@ public:
     {
       uniform.set((classInstance->*valueMethod)(), (classInstance->*countMethod)());
     };
+    setterChanged();
   }
 
   bool bind(const Node* node, const Mesh& mesh, const gslu::nn_shared<ShaderProgram>& shaderProgram) override;
 
-private:
+  //! Resolves the setter to use, with precedence mesh > material > node.
+  //! Returns @c nullptr if the value is set on shader level.
+  [[nodiscard]] const std::function<UniformValueSetter>* findSetter(const Node* node, const Mesh& mesh) const;
   [[nodiscard]] gl::Uniform* findUniform(const gslu::nn_shared<ShaderProgram>& shaderProgram) const;
 
+private:
   std::function<UniformValueSetter> m_valueSetter;
 };
 
@@ -95,6 +102,8 @@ public:
     {
       uniformBlock.bind(*value);
     };
+    m_boundCamera = nullptr;
+    setterChanged();
   }
 
   template<class ClassType, typename T>
@@ -105,6 +114,8 @@ public:
     {
       uniformBlock.bind((classInstance->*valueMethod)());
     };
+    m_boundCamera = nullptr;
+    setterChanged();
   }
 
   using BufferBinder = void(const Node* node, const Mesh& mesh, gl::UniformBlock& uniformBlock);
@@ -112,6 +123,8 @@ public:
   void bind(std::function<BufferBinder>&& setter)
   {
     m_bufferBinder = std::move(setter);
+    m_boundCamera = nullptr;
+    setterChanged();
   }
 
   bool bind(const Node* node, const Mesh& mesh, const gslu::nn_shared<ShaderProgram>& shaderProgram) override;
@@ -119,9 +132,14 @@ public:
   void bindTransformBuffer();
   void bindCameraBuffer(const gslu::nn_shared<Camera>& camera);
 
-private:
+  //! Resolves the binder to use, with precedence mesh > material > node.
+  //! Returns @c nullptr if the block is set on shader level.
+  [[nodiscard]] const std::function<BufferBinder>* findBinder(const Node* node, const Mesh& mesh) const;
   [[nodiscard]] gl::UniformBlock* findUniformBlock(const gslu::nn_shared<ShaderProgram>& shaderProgram) const;
 
+private:
   std::function<BufferBinder> m_bufferBinder;
+  //! The camera bound by bindCameraBuffer(), to avoid invalidating cached binding plans when it is bound again.
+  const Camera* m_boundCamera = nullptr;
 };
 } // namespace render::scene
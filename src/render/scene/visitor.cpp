@@ -5,8 +5,13 @@
 #include "rendercontext.h"
 
 #include <algorithm>
+#include <array>
+#include <boost/container_hash/hash.hpp>
+#include <cstdint>
+#include <cstring>
 #include <gl/debuggroup.h>
 #include <glm/geometric.hpp>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
@@ -15,11 +20,63 @@
 
 namespace render::scene
 {
+namespace
+{
+uint32_t floatBits(const float value)
+{
+  static_assert(sizeof(uint32_t) == sizeof(float));
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+//! Stable LSD radix sort over the keys, skipping all digits that are equal for all keys.
+void radixSort(std::vector<std::tuple<uint64_t, uint32_t>>& entries,
+               std::vector<std::tuple<uint64_t, uint32_t>>& scratch)
+{
+  if(entries.size() < 2)
+    return;
+
+  scratch.resize(entries.size());
+  for(uint32_t shift = 0; shift < 64; shift += 8)
+  {
+    const auto digit = [shift](const std::tuple<uint64_t, uint32_t>& entry)
+    {
+      return static_cast<size_t>((std::get<0>(entry) >> shift) & 0xffu);
+    };
+
+    std::array<size_t, 256> offsets{};
+    for(const auto& entry : entries)
+      ++offsets[digit(entry)];
+    if(offsets[digit(entries.front())] == entries.size())
+      continue;
+
+    size_t offset = 0;
+    for(auto& count : offsets)
+      offset += std::exchange(count, offset);
+
+    for(const auto& entry : entries)
+      scratch[offsets[digit(entry)]++] = entry;
+    entries.swap(scratch);
+  }
+}
+
+//! Nodes and renderables may exempt themselves from the portal scissors, e.g. static meshes sticking out of a room.
+bool usesScissorTest(const Node& node)
+{
+  if(!node.getRenderState().getScissorTest().value_or(true))
+    return false;
+
+  const auto& renderable = node.getRenderable();
+  return renderable == nullptr || renderable->usesScissorTest();
+}
+} // namespace
+
 void Visitor::visit(const Node& node)
 {
   if(!node.isVisible())
     return;
-  if(const auto& vp = m_context.getViewProjection(); vp.has_value() && node.canBeCulled(vp.value()))
+  if(m_context.getViewProjection().has_value() && node.canBeCulled(m_context, m_withScissors && usesScissorTest(node)))
     return;
 
   m_context.pushState(node.getRenderState());
@@ -29,38 +86,90 @@ void Visitor::visit(const Node& node)
 
 void Visitor::add(const gsl::not_null<const Node*>& node, const glm::vec3& position)
 {
-  if(node->getRenderable() != nullptr)
-    m_nodes.emplace_back(node, m_context.getCurrentState(), position);
+  const auto& renderable = node->getRenderable();
+  if(renderable == nullptr || !renderable->isRenderedIn(m_context.getRenderMode()))
+    return;
+
+  m_nodes.emplace_back(
+    RenderableInfo{node, m_context.getCurrentState(), position, renderable->getDrawState(m_context.getRenderMode())});
 }
 
-void Visitor::render(const std::optional<glm::vec3>& camera) const
+uint64_t Visitor::getSortKey(const RenderableInfo& info, const glm::vec3& camera) const
 {
-  if(camera.has_value())
+  // key layout, from most to least significant bits:
+  //   16 bits render order, 1 bit translucency, then
+  //   - opaque: 8 bits program, 12 bits material, 12 bits vertex array, 15 bits depth front-to-back
+  //   - translucent: 31 bits depth back-to-front, 8 bits program, 8 bits material
+  // the state bits are truncated identifiers; collisions only affect grouping, not correctness
+  const auto order = std::clamp(info.node->getRenderOrder(),
+                                int{std::numeric_limits<int16_t>::min()},
+                                int{std::numeric_limits<int16_t>::max()});
+  uint64_t key = static_cast<uint64_t>(order - std::numeric_limits<int16_t>::min()) << 48u;
+
+  // squared distances are never negative, so their bit patterns sort like their values
+  const auto delta = info.position - camera;
+  const uint64_t depth = floatBits(glm::dot(delta, delta));
+  const uint64_t program = info.drawState.program & 0xffu;
+  const auto material = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(info.drawState.material) >> 4u);
+
+  if(info.drawState.blend.value_or(info.state.getBlend(0).value_or(false)))
+  {
+    key |= uint64_t{1} << 47u;
+    key |= (~depth & 0x7fffffffu) << 16u;
+    key |= program << 8u;
+    key |= material & 0xffu;
+  }
+  else
   {
-    // logic: first order by render order, then order by distance to camera back-to-front
-    std::sort(m_nodes.begin(),
-              m_nodes.end(),
-              [camera](const RenderableInfo& a, const RenderableInfo& b)
-              {
-                if(auto aOrder = std::get<0>(a)->getRenderOrder(), bOrder = std::get<0>(b)->getRenderOrder();
-                   aOrder != bOrder)
-                {
-                  return aOrder < bOrder;
-                }
-
-                auto da = glm::distance(std::get<2>(a), *camera);
-                auto db = glm::distance(std::get<2>(b), *camera);
-                return da > db;
-              });
+    key |= program << 39u;
+    key |= (material & 0xfffu) << 27u;
+    key |= static_cast<uint64_t>(info.drawState.vertexArray & 0xfffu) << 15u;
+    key |= (depth >> 16u) & 0x7fffu;
   }
 
-  for(const auto& [node, state, position] : m_nodes)
+  return key;
+}
+
+void Visitor::render(const std::optional<glm::vec3>& camera) const
+{
+  const auto renderNode = [this](const RenderableInfo& info)
   {
-    SOGLB_DEBUGGROUP(node->getName());
-    m_context.pushState(state);
-    node->getRenderable()->render(node.get(), m_context);
+    SOGLB_DEBUGGROUP(info.node->getName());
+    m_context.pushState(info.state);
+    info.node->getRenderable()->render(info.node.get(), m_context);
     m_context.popState();
+  };
+
+  if(!camera.has_value())
+  {
+    for(const auto& info : m_nodes)
+      renderNode(info);
+    return;
+  }
+
+  m_sortKeys.clear();
+  m_sortKeys.reserve(m_nodes.size());
+  for(size_t i = 0; i < m_nodes.size(); ++i)
+    m_sortKeys.emplace_back(getSortKey(m_nodes[i], *camera), gsl::narrow<uint32_t>(i));
+  radixSort(m_sortKeys, m_sortScratch);
+
+  for(const auto& [key, index] : m_sortKeys)
+    renderNode(m_nodes[index]);
+}
+
+size_t Visitor::hashContents() const
+{
+  size_t seed = m_nodes.size();
+  for(const auto& [node, state, position, drawState] : m_nodes)
+  {
+    boost::hash_combine(seed, node.get());
+    boost::hash_combine(seed, node->getRenderable().get());
+    const auto& m = node->getModelMatrix();
+    for(glm::length_t i = 0; i < 4; ++i)
+      for(glm::length_t j = 0; j < 4; ++j)
+        boost::hash_combine(seed, m[i][j]);
   }
+  return seed;
 }
 
 Visitor::~Visitor() = default;
@@ -1,5 +1,10 @@
 #pragma once
 
+#include "renderable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <gl/renderstate.h>
 #include <gl/soglb_fwd.h>
 #include <glm/vec3.hpp>
 #include <gsl/gsl-lite.hpp>
@@ -42,12 +47,30 @@ public:
 
   void add(const gsl::not_null<const Node*>& node, const glm::vec3& position);
 
+  /**
+   * Renders all collected nodes. If a camera position is given, draws are ordered by a sort key built from the nodes'
+   * render order, blending, GPU state and distance to the camera: opaque draws are grouped by program, material and
+   * vertex array to reduce state changes, while translucent draws are rendered back-to-front.
+   */
   void render(const std::optional<glm::vec3>& camera) const;
 
+  //! A hash over the collected nodes, their renderables and their transforms, used to detect unchanged contents.
+  [[nodiscard]] size_t hashContents() const;
+
 private:
   RenderContext& m_context;
   const bool m_withScissors;
-  using RenderableInfo = std::tuple<gsl::not_null<const Node*>, gl::RenderState, glm::vec3>;
+  struct RenderableInfo
+  {
+    gsl::not_null<const Node*> node;
+    gl::RenderState state;
+    glm::vec3 position;
+    DrawState drawState;
+  };
   mutable std::vector<RenderableInfo> m_nodes;
+  mutable std::vector<std::tuple<uint64_t, uint32_t>> m_sortKeys;
+  mutable std::vector<std::tuple<uint64_t, uint32_t>> m_sortScratch;
+
+  [[nodiscard]] uint64_t getSortKey(const RenderableInfo& info, const glm::vec3& camera) const;
 };
 } // namespace render::scene
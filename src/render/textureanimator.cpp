@@ -4,10 +4,9 @@
 #include "loader/file/datatypes.h"
 #include "loader/file/texture.h"
 
-#include <array>
+#include <algorithm>
 #include <gl/api/gl.hpp>
-#include <gl/vertexbuffer.h>
-#include <memory>
+#include <gsl/gsl-lite.hpp>
 #include <utility>
 
 namespace render
@@ -27,7 +26,6 @@ TextureAnimator::TextureAnimator(const std::vector<uint16_t>& data)
       Expects(ptr <= &data.back());
       const auto tileId = *ptr++;
       sequence.tileIds.emplace_back(tileId);
-      m_sequenceByTileId.emplace(tileId, m_sequences.size());
     }
     m_sequences.emplace_back(std::move(sequence));
   }
@@ -35,29 +33,71 @@ TextureAnimator::TextureAnimator(const std::vector<uint16_t>& data)
   BOOST_ASSERT(ptr == &data.back() + 1);
 }
 
-void TextureAnimator::Sequence::updateCoordinates(const std::vector<engine::world::AtlasTile>& tiles)
+void TextureAnimator::setTile(const std::vector<engine::world::AtlasTile>& tiles, const size_t dst, const size_t src)
 {
-  BOOST_ASSERT(!tileIds.empty());
+  const engine::world::AtlasTile& tile = tiles.at(src);
+  auto& shaderTile = m_tiles.at(dst);
+  shaderTile.uv12 = glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]};
+  shaderTile.uv34 = glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]};
+  shaderTile.textureIndex = tile.textureKey.tileAndFlag & loader::file::TextureIndexMask;
+}
 
-  for(const auto& [buffer, vertices] : affectedVertices)
+void TextureAnimator::applySequences(const std::vector<engine::world::AtlasTile>& tiles)
+{
+  for(const Sequence& sequence : m_sequences)
   {
-    auto uvArray
-      = buffer->map(gl::api::MapBufferAccessMask::MapWriteBit | gl::api::MapBufferAccessMask::MapFlushExplicitBit);
-
-    for(const VertexReference& vref : vertices)
+    BOOST_ASSERT(!sequence.tileIds.empty());
+    for(size_t i = 0; i < sequence.tileIds.size(); ++i)
     {
-      BOOST_ASSERT(buffer->size() > 0 && vref.bufferIndex < static_cast<size_t>(buffer->size()));
-      BOOST_ASSERT(vref.queueOffset < tileIds.size());
-      const engine::world::AtlasTile& tile = tiles[tileIds[vref.queueOffset].get()];
-
-      uvArray[vref.bufferIndex].uv
-        = glm::vec3{tile.uvCoordinates[vref.sourceIndex], tile.textureKey.tileAndFlag & loader::file::TextureIndexMask};
-      uvArray[vref.bufferIndex].quadUv12 = glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]};
-      uvArray[vref.bufferIndex].quadUv34 = glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]};
+      setTile(
+        tiles, sequence.tileIds[i].get(), sequence.tileIds[(i + sequence.offset) % sequence.tileIds.size()].get());
     }
+  }
+}
 
-    buffer->flush();
-    buffer->unmap();
+void TextureAnimator::uploadTiles(const std::vector<engine::world::AtlasTile>& tiles)
+{
+  m_tiles.resize(tiles.size());
+  for(size_t i = 0; i < tiles.size(); ++i)
+    setTile(tiles, i, i);
+
+  applySequences(tiles);
+
+  m_tileBuffer->setData(m_tiles, gl::api::BufferUsage::DynamicDraw);
+
+  std::vector<size_t> animatedTileIds;
+  for(const Sequence& sequence : m_sequences)
+    for(const auto& tileId : sequence.tileIds)
+      animatedTileIds.emplace_back(tileId.get());
+  std::sort(animatedTileIds.begin(), animatedTileIds.end());
+  animatedTileIds.erase(std::unique(animatedTileIds.begin(), animatedTileIds.end()), animatedTileIds.end());
+
+  m_animatedTileRanges.clear();
+  for(const auto tileId : animatedTileIds)
+  {
+    if(!m_animatedTileRanges.empty()
+       && m_animatedTileRanges.back().first + m_animatedTileRanges.back().second == tileId)
+    {
+      ++m_animatedTileRanges.back().second;
+    }
+    else
+    {
+      m_animatedTileRanges.emplace_back(tileId, 1);
+    }
   }
 }
+
+void TextureAnimator::updateCoordinates(const std::vector<engine::world::AtlasTile>& tiles)
+{
+  Expects(m_tiles.size() == tiles.size());
+
+  for(Sequence& sequence : m_sequences)
+    sequence.rotate();
+
+  applySequences(tiles);
+
+  const gsl::span<const ShaderTile> allTiles{m_tiles};
+  for(const auto& [first, count] : m_animatedTileRanges)
+    m_tileBuffer->setSubData(allTiles.subspan(first, count), gsl::narrow<gl::api::core::SizeType>(first));
+}
 } // namespace render
@@ -2,20 +2,16 @@
 
 #include "core/id.h"
 
-#include <algorithm>
 #include <boost/assert.hpp>
 #include <cstddef>
 #include <cstdint>
-#include <gl/soglb_fwd.h>
+#include <gl/buffer.h>
 #include <glm/ext/scalar_int_sized.hpp>
-#include <glm/vec2.hpp>
-#include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 #include <gsl/gsl-lite.hpp>
-#include <iterator>
-#include <map>
+#include <gslu.h>
 #include <memory>
-#include <set>
+#include <utility>
 #include <vector>
 
 namespace engine::world
@@ -28,95 +24,52 @@ namespace render
 class TextureAnimator
 {
 public:
-  struct AnimatedUV
+  //! Entry of the @c b_tiles shader storage buffer, indexed by tile id.
+  struct ShaderTile
   {
-    glm::vec3 uv{0, 0, -1};
-    glm::vec4 quadUv12{};
-    glm::vec4 quadUv34{};
-
-    explicit AnimatedUV() = default;
-    explicit AnimatedUV(glm::int32 index, const glm::vec2& uv, const glm::vec4& quadUv12, const glm::vec4& quadUv34)
-        : uv{uv, index}
-        , quadUv12{quadUv12}
-        , quadUv34{quadUv34}
-    {
-    }
+    glm::vec4 uv12{0.0f};
+    glm::vec4 uv34{0.0f};
+    glm::int32 textureIndex = -1;
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays, modernize-avoid-c-arrays)
+    glm::int32 _pad[3]{0, 0, 0};
   };
+  static_assert(sizeof(ShaderTile) == 48, "Invalid ShaderTile struct size");
 
   explicit TextureAnimator(const std::vector<uint16_t>& data);
 
-  void registerVertex(const core::TextureTileId& tileId,
-                      const std::shared_ptr<gl::VertexBuffer<AnimatedUV>>& buffer,
-                      const int sourceIndex,
-                      const size_t bufferIndex)
-  {
-    auto it = m_sequenceByTileId.find(tileId);
-    if(it == m_sequenceByTileId.end())
-      return;
+  //! Builds and uploads the complete tile table from the current state of all animation sequences.
+  void uploadTiles(const std::vector<engine::world::AtlasTile>& tiles);
 
-    m_sequences.at(it->second).registerVertex(buffer, Sequence::VertexReference(bufferIndex, sourceIndex), tileId);
-  }
+  //! Advances all animation sequences, and only uploads the tile table entries of the animated tiles.
+  void updateCoordinates(const std::vector<engine::world::AtlasTile>& tiles);
 
-  void updateCoordinates(const std::vector<engine::world::AtlasTile>& tiles)
+  [[nodiscard]] const auto& getTileBuffer() const
   {
-    for(Sequence& sequence : m_sequences)
-    {
-      sequence.rotate();
-      sequence.updateCoordinates(tiles);
-    }
+    return m_tileBuffer;
   }
 
 private:
   struct Sequence
   {
-    struct VertexReference
-    {
-      //! Vertex buffer index
-      const size_t bufferIndex;
-      const int sourceIndex;
-      size_t queueOffset = 0;
-
-      VertexReference(const size_t bufferIdx, const int sourceIdx)
-          : bufferIndex(bufferIdx)
-          , sourceIndex(sourceIdx)
-      {
-        Expects(sourceIdx >= 0 && sourceIdx < 4);
-      }
-
-      bool operator<(const VertexReference& rhs) const noexcept
-      {
-        return bufferIndex < rhs.bufferIndex;
-      }
-
-      bool operator==(const VertexReference& rhs) const noexcept
-      {
-        return bufferIndex == rhs.bufferIndex;
-      }
-    };
-
     std::vector<core::TextureTileId> tileIds;
-    std::map<std::shared_ptr<gl::VertexBuffer<AnimatedUV>>, std::set<VertexReference>> affectedVertices;
+    //! Number of steps the sequence has been rotated; tile @c tileIds[i] displays @c tileIds[(i+offset)%size].
+    size_t offset = 0;
 
     void rotate()
     {
       BOOST_ASSERT(!tileIds.empty());
-      std::rotate(tileIds.begin(), std::next(tileIds.begin()), tileIds.end());
-    }
-
-    void registerVertex(const std::shared_ptr<gl::VertexBuffer<AnimatedUV>>& buffer,
-                        VertexReference vertex,
-                        const core::TextureTileId& tileId)
-    {
-      const auto it = std::find(tileIds.begin(), tileIds.end(), tileId);
-      Expects(it != tileIds.end());
-      vertex.queueOffset = std::distance(tileIds.begin(), it);
-      affectedVertices[buffer].insert(vertex);
+      offset = (offset + 1) % tileIds.size();
     }
-
-    void updateCoordinates(const std::vector<engine::world::AtlasTile>& tiles);
   };
 
+  void setTile(const std::vector<engine::world::AtlasTile>& tiles, size_t dst, size_t src);
+  void applySequences(const std::vector<engine::world::AtlasTile>& tiles);
+
   std::vector<Sequence> m_sequences;
-  std::map<core::TextureTileId, size_t> m_sequenceByTileId;
+  std::vector<ShaderTile> m_tiles;
+  //! Contiguous runs of animated tile ids as (first id, count), so that each run is uploaded with a single call.
+  std::vector<std::pair<size_t, size_t>> m_animatedTileRanges;
+  gslu::nn_shared<gl::ShaderStorageBuffer<ShaderTile>> m_tileBuffer{
+    gsl::make_shared<gl::ShaderStorageBuffer<ShaderTile>>("texture-tiles")};
 };
 } // namespace render
@@ -28,14 +28,10 @@ struct ObjectReference final
     else
     {
       ser.tag("objectref");
-      for(const auto& [objId, obj] : ser.context.getObjectManager().getObjects())
+      if(auto id = ser.context.getObjectManager().findId(ptr.get()); id.has_value())
       {
-        if(obj.get() == ptr)
-        {
-          engine::ObjectId tmp = objId;
-          ser(S_NV("id", tmp));
-          return;
-        }
+        ser(S_NV("id", *id));
+        return;
       }
 
       // this may happen if the object was killed, thus rendering this reference invalid
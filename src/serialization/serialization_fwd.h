@@ -10,6 +10,9 @@ struct TypeId;
 template<typename TContext>
 class Serializer;
 
+template<bool Loading>
+class YAMLDocument;
+
 template<typename TContext>
 using LazyCallback = std::function<void(const Serializer<TContext>&)>;
 
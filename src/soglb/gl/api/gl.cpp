@@ -218,6 +218,10 @@ void makeTextureHandleResident(uint64_t handle)
 {
   return glMakeTextureHandleResidentARB(static_cast<GLuint64>(handle));
 }
+void maxShaderCompilerThreadsKHR(uint32_t count)
+{
+  return glMaxShaderCompilerThreadsKHR(static_cast<GLuint>(count));
+}
 void pixelStore(PixelStoreParameter pname, float param)
 {
   return glPixelStoref(static_cast<GLenum>(pname), static_cast<GLfloat>(param));
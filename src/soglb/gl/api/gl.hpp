@@ -4529,6 +4529,7 @@ enum class ProgramParameterPName : core::EnumType
 
 enum class ProgramProperty : core::EnumType
 {
+  CompletionStatusKhr = 0x91B1,
 #if defined(API_LEVEL_GL_VERSION_2_0) || defined(API_LEVEL_GL_VERSION_2_1) || defined(API_LEVEL_GL_VERSION_3_0) \
   || defined(API_LEVEL_GL_VERSION_3_1) || defined(API_LEVEL_GL_VERSION_3_2_core)                                \
   || defined(API_LEVEL_GL_VERSION_3_3_compatibility) || defined(API_LEVEL_GL_VERSION_3_3_core)                  \
@@ -5086,6 +5087,7 @@ enum class ShaderBinaryFormat : core::EnumType
   || defined(API_LEVEL_GL_VERSION_4_6_compatibility) || defined(API_LEVEL_GL_VERSION_4_6_core)
 enum class ShaderParameterName : core::EnumType
 {
+  CompletionStatusKhr = 0x91B1,
   CompileStatus = 0x8B81,
   DeleteStatus = 0x8B80,
   InfoLogLength = 0x8B84,
@@ -6826,6 +6828,7 @@ extern void makeImageHandleNonResident(uint64_t handle);
 extern void makeImageHandleResident(uint64_t handle, core::EnumType access);
 extern void makeTextureHandleNonResident(uint64_t handle);
 extern void makeTextureHandleResident(uint64_t handle);
+extern void maxShaderCompilerThreadsKHR(uint32_t count);
 extern void pixelStore(PixelStoreParameter pname, float param);
 extern void pixelStore(PixelStoreParameter pname, int32_t param);
 extern void pointSize(float size);
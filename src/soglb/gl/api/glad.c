@@ -11,6 +11,7 @@
         GL_ARB_texture_filter_anisotropic,
         GL_ATI_meminfo,
         GL_EXT_texture_filter_anisotropic,
+        GL_KHR_parallel_shader_compile,
         GL_NVX_gpu_memory_info
     Loader: False
     Local files: True
@@ -18,9 +19,9 @@
     Reproducible: False
 
     Commandline:
-        --profile="core" --api="gl=4.5" --generator="c" --spec="gl" --no-loader --local-files --extensions="GL_ARB_bindless_texture,GL_ARB_texture_filter_anisotropic,GL_ATI_meminfo,GL_EXT_texture_filter_anisotropic,GL_NVX_gpu_memory_info"
+        --profile="core" --api="gl=4.5" --generator="c" --spec="gl" --no-loader --local-files --extensions="GL_ARB_bindless_texture,GL_ARB_texture_filter_anisotropic,GL_ATI_meminfo,GL_EXT_texture_filter_anisotropic,GL_KHR_parallel_shader_compile,GL_NVX_gpu_memory_info"
     Online:
-        https://glad.dav1d.de/#profile=core&language=c&specification=gl&api=gl%3D4.5&extensions=GL_ARB_bindless_texture&extensions=GL_ARB_texture_filter_anisotropic&extensions=GL_ATI_meminfo&extensions=GL_EXT_texture_filter_anisotropic&extensions=GL_NVX_gpu_memory_info
+        https://glad.dav1d.de/#profile=core&language=c&specification=gl&api=gl%3D4.5&extensions=GL_ARB_bindless_texture&extensions=GL_ARB_texture_filter_anisotropic&extensions=GL_ATI_meminfo&extensions=GL_EXT_texture_filter_anisotropic&extensions=GL_KHR_parallel_shader_compile&extensions=GL_NVX_gpu_memory_info
 */
 
 #include "glad.h"
@@ -866,6 +867,7 @@ int GLAD_GL_ARB_bindless_texture = 0;
 int GLAD_GL_ARB_texture_filter_anisotropic = 0;
 int GLAD_GL_ATI_meminfo = 0;
 int GLAD_GL_EXT_texture_filter_anisotropic = 0;
+int GLAD_GL_KHR_parallel_shader_compile = 0;
 int GLAD_GL_NVX_gpu_memory_info = 0;
 PFNGLGETTEXTUREHANDLEARBPROC glad_glGetTextureHandleARB = NULL;
 PFNGLGETTEXTURESAMPLERHANDLEARBPROC glad_glGetTextureSamplerHandleARB = NULL;
@@ -883,6 +885,7 @@ PFNGLISIMAGEHANDLERESIDENTARBPROC glad_glIsImageHandleResidentARB = NULL;
 PFNGLVERTEXATTRIBL1UI64ARBPROC glad_glVertexAttribL1ui64ARB = NULL;
 PFNGLVERTEXATTRIBL1UI64VARBPROC glad_glVertexAttribL1ui64vARB = NULL;
 PFNGLGETVERTEXATTRIBLUI64VARBPROC glad_glGetVertexAttribLui64vARB = NULL;
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glad_glMaxShaderCompilerThreadsKHR = NULL;
 static void load_GL_VERSION_1_0(GLADloadproc load)
 {
   if(!GLAD_GL_VERSION_1_0)
@@ -1747,6 +1750,12 @@ fail:
   fprintf(stderr, "GL_ARB_bindless_texture could not be loaded");
   return 0;
 }
+static void load_GL_KHR_parallel_shader_compile(GLADloadproc load)
+{
+  if(!GLAD_GL_KHR_parallel_shader_compile)
+    return;
+  glad_glMaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)load("glMaxShaderCompilerThreadsKHR");
+}
 static int find_extensionsGL(void)
 {
   if(!get_exts())
@@ -1755,6 +1764,7 @@ static int find_extensionsGL(void)
   GLAD_GL_ARB_texture_filter_anisotropic = has_ext("GL_ARB_texture_filter_anisotropic");
   GLAD_GL_ATI_meminfo = has_ext("GL_ATI_meminfo");
   GLAD_GL_EXT_texture_filter_anisotropic = has_ext("GL_EXT_texture_filter_anisotropic");
+  GLAD_GL_KHR_parallel_shader_compile = has_ext("GL_KHR_parallel_shader_compile");
   GLAD_GL_NVX_gpu_memory_info = has_ext("GL_NVX_gpu_memory_info");
   free_exts();
   return 1;
@@ -1854,5 +1864,6 @@ int gladLoadGLLoader(GLADloadproc load)
     return 0;
   if(!load_GL_ARB_bindless_texture(load))
     return 0;
+  load_GL_KHR_parallel_shader_compile(load);
   return GLVersion.major != 0 || GLVersion.minor != 0;
 }
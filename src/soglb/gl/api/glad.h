@@ -11,6 +11,7 @@
         GL_ARB_texture_filter_anisotropic,
         GL_ATI_meminfo,
         GL_EXT_texture_filter_anisotropic,
+        GL_KHR_parallel_shader_compile,
         GL_NVX_gpu_memory_info
     Loader: False
     Local files: True
@@ -18,9 +19,9 @@
     Reproducible: False
 
     Commandline:
-        --profile="core" --api="gl=4.5" --generator="c" --spec="gl" --no-loader --local-files --extensions="GL_ARB_bindless_texture,GL_ARB_texture_filter_anisotropic,GL_ATI_meminfo,GL_EXT_texture_filter_anisotropic,GL_NVX_gpu_memory_info"
+        --profile="core" --api="gl=4.5" --generator="c" --spec="gl" --no-loader --local-files --extensions="GL_ARB_bindless_texture,GL_ARB_texture_filter_anisotropic,GL_ATI_meminfo,GL_EXT_texture_filter_anisotropic,GL_KHR_parallel_shader_compile,GL_NVX_gpu_memory_info"
     Online:
-        https://glad.dav1d.de/#profile=core&language=c&specification=gl&api=gl%3D4.5&extensions=GL_ARB_bindless_texture&extensions=GL_ARB_texture_filter_anisotropic&extensions=GL_ATI_meminfo&extensions=GL_EXT_texture_filter_anisotropic&extensions=GL_NVX_gpu_memory_info
+        https://glad.dav1d.de/#profile=core&language=c&specification=gl&api=gl%3D4.5&extensions=GL_ARB_bindless_texture&extensions=GL_ARB_texture_filter_anisotropic&extensions=GL_ATI_meminfo&extensions=GL_EXT_texture_filter_anisotropic&extensions=GL_KHR_parallel_shader_compile&extensions=GL_NVX_gpu_memory_info
 */
 
 #ifndef __glad_h_
@@ -4299,6 +4300,8 @@ typedef unsigned int GLhandleARB;
 #define GL_RENDERBUFFER_FREE_MEMORY_ATI 0x87FD
 #define GL_TEXTURE_MAX_ANISOTROPY_EXT 0x84FE
 #define GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT 0x84FF
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
 #define GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX 0x9047
 #define GL_GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX 0x9048
 #define GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX 0x9049
@@ -4372,6 +4375,13 @@ typedef unsigned int GLhandleARB;
 #  define GL_EXT_texture_filter_anisotropic 1
   GLAPI int GLAD_GL_EXT_texture_filter_anisotropic;
 #endif
+#ifndef GL_KHR_parallel_shader_compile
+#  define GL_KHR_parallel_shader_compile 1
+  GLAPI int GLAD_GL_KHR_parallel_shader_compile;
+  typedef void(APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+  GLAPI PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glad_glMaxShaderCompilerThreadsKHR;
+#  define glMaxShaderCompilerThreadsKHR glad_glMaxShaderCompilerThreadsKHR
+#endif
 #ifndef GL_NVX_gpu_memory_info
 #  define GL_NVX_gpu_memory_info 1
   GLAPI int GLAD_GL_NVX_gpu_memory_info;
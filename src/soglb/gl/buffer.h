@@ -3,6 +3,7 @@
 #include "bindableresource.h" // IWYU pragma: export
 #include "typetraits.h"
 
+#include <cstdint>
 #include <gsl/gsl-lite.hpp>
 #include <string_view>
 
@@ -63,10 +64,19 @@ public:
     }
   }
 
+  //! Allocates uninitialized storage for @a size elements, e.g. as the target of a readback.
+  void allocate(const size_t size, const api::BufferUsage usage)
+  {
+    m_usage = usage;
+    m_size = size;
+    GL_ASSERT(api::namedBufferData(getHandle(), m_size * sizeof(T), nullptr, usage));
+  }
+
   void setSubData(const gsl::span<const T>& data, const api::core::SizeType start)
   {
-    GL_ASSERT(
-      api::namedBufferSubData(getHandle(), gsl::narrow<std::intptr_t>(sizeof(T) * start), data.size_byts(), data));
+    Expects(gsl::narrow<size_t>(start) + data.size() <= m_size);
+    GL_ASSERT(api::namedBufferSubData(
+      getHandle(), gsl::narrow<std::intptr_t>(sizeof(T) * start), data.size_bytes(), data.data()));
   }
 
   [[nodiscard]] auto size() const noexcept
@@ -88,6 +98,23 @@ using UniformBuffer = Buffer<T, api::BufferTarget::UniformBuffer>;
 template<typename T>
 using ArrayBuffer = Buffer<T, api::BufferTarget::ArrayBuffer>;
 
+template<typename T>
+using DrawIndirectBuffer = Buffer<T, api::BufferTarget::DrawIndirectBuffer>;
+
+template<typename T>
+using PixelPackBuffer = Buffer<T, api::BufferTarget::PixelPackBuffer>;
+
+//! Layout of a single draw of @c api::multiDrawElementsIndirect.
+struct DrawElementsIndirectCommand
+{
+  uint32_t count = 0;
+  uint32_t instanceCount = 0;
+  uint32_t firstIndex = 0;
+  int32_t baseVertex = 0;
+  uint32_t baseInstance = 0;
+};
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "Invalid DrawElementsIndirectCommand struct size");
+
 template<typename T>
 class ElementArrayBuffer final : public Buffer<T, api::BufferTarget::ElementArrayBuffer>
 {
@@ -107,7 +134,7 @@ public:
   void drawElements(api::PrimitiveType primitiveType, api::core::SizeType instances) const
   {
     GL_ASSERT(api::drawElementsInstance(
-      primitiveType, gsl::narrow<api::core::SizeType>(size()), DrawElementsType<T>, instances));
+      primitiveType, gsl::narrow<api::core::SizeType>(size()), DrawElementsType<T>, nullptr, instances));
   }
 };
 } // namespace gl
@@ -34,6 +34,13 @@ public:
     return GL_ASSERT_FN(api::clientWaitSync(m_sync, api::SyncObjectMask::SyncFlushCommandsBit, api::TimeoutIgnored));
   }
 
+  //! Checks whether the commands preceding the fence have completed, without waiting.
+  [[nodiscard]] bool isSignaled() const
+  {
+    const auto status = GL_ASSERT_FN(api::clientWaitSync(m_sync, api::SyncObjectMask::SyncFlushCommandsBit, 0));
+    return status == api::SyncStatus::AlreadySignaled || status == api::SyncStatus::ConditionSatisfied;
+  }
+
 private:
   const api::core::Sync m_sync;
 };
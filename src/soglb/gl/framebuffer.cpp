@@ -8,6 +8,12 @@
 
 namespace gl
 {
+namespace
+{
+//! Handle of the framebuffer used instead of the window's one.
+uint32_t defaultFramebufferHandle = 0;
+} // namespace
+
 void TextureAttachment::attach(const Framebuffer& framebuffer, const api::FramebufferAttachment attachment) const
 {
   GL_ASSERT(api::namedFramebufferTexture(framebuffer.getHandle(), attachment, m_texture->getHandle(), m_level));
@@ -94,7 +100,18 @@ bool Framebuffer::isComplete() const
 
 void Framebuffer::unbindAll()
 {
-  GL_ASSERT(api::bindFramebuffer(api::FramebufferTarget::Framebuffer, 0));
+  GL_ASSERT(api::bindFramebuffer(api::FramebufferTarget::Framebuffer, defaultFramebufferHandle));
+}
+
+void Framebuffer::bindDefaultForReading()
+{
+  GL_ASSERT(api::bindFramebuffer(api::FramebufferTarget::ReadFramebuffer, defaultFramebufferHandle));
+}
+
+void Framebuffer::setDefault(const std::shared_ptr<Framebuffer>& framebuffer)
+{
+  defaultFramebufferHandle = framebuffer == nullptr ? 0 : framebuffer->getHandle();
+  unbindAll();
 }
 
 void Framebuffer::invalidate()
@@ -130,7 +147,7 @@ void Framebuffer::blit(const Framebuffer& target, gl::api::BlitFramebufferFilter
 void Framebuffer::blit(const glm::ivec2& backbufferSize, gl::api::BlitFramebufferFilter filter)
 {
   GL_ASSERT(gl::api::blitNamedFramebuffer(getHandle(),
-                                          0,
+                                          defaultFramebufferHandle,
                                           0,
                                           0,
                                           m_size.x - 1,
@@ -77,7 +77,13 @@ public:
 
   [[nodiscard]] bool isComplete() const;
 
+  //! Binds the default framebuffer, i.e. the window's one or the one set by setDefault().
   static void unbindAll();
+  //! Binds the default framebuffer as the source of read operations.
+  static void bindDefaultForReading();
+  //! Replaces the window's framebuffer as the default one, e.g. by an offscreen framebuffer if the window isn't
+  //! visible; @c nullptr restores the window's framebuffer.
+  static void setDefault(const std::shared_ptr<Framebuffer>& framebuffer);
 
   void invalidate();
 
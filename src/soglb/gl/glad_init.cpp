@@ -161,6 +161,17 @@ void gl::initializeGl(void* (*loadProc)(const char* name))
     BOOST_LOG_TRIVIAL(info) << "Anisotropic filtering is supported on this platform, max level "
                             << getMaxAnisotropyLevel();
 
+  if(!hasParallelShaderCompileExtension())
+  {
+    BOOST_LOG_TRIVIAL(info) << "Parallel shader compilation is not supported on this platform";
+  }
+  else
+  {
+    BOOST_LOG_TRIVIAL(info) << "Parallel shader compilation is supported on this platform";
+    // let the driver decide how many threads to use
+    GL_ASSERT(api::maxShaderCompilerThreadsKHR(0xffffffffu));
+  }
+
   GL_ASSERT(api::enable(api::EnableCap::Multisample));
   GL_ASSERT(api::enable(api::EnableCap::SampleShading));
   GL_ASSERT(api::enable(api::EnableCap::Dither));
@@ -179,3 +190,8 @@ float gl::getMaxAnisotropyLevel()
   GL_ASSERT(glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &value));
   return value;
 }
+
+bool gl::hasParallelShaderCompileExtension()
+{
+  return GLAD_GL_KHR_parallel_shader_compile == GL_TRUE && glMaxShaderCompilerThreadsKHR != nullptr;
+}
@@ -5,4 +5,5 @@ namespace gl
 extern void initializeGl(void* (*loadProc)(const char* name));
 extern bool hasAnisotropicFilteringExtension();
 extern float getMaxAnisotropyLevel();
+extern bool hasParallelShaderCompileExtension();
 } // namespace gl
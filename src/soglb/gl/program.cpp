@@ -1,6 +1,8 @@
 #include "program.h"
 
+#include "api/gl_api_provider.hpp"
 #include "bindableresource.h"
+#include "glad_init.h"
 #include "glassert.h"
 
 #include <glm/gtc/type_ptr.hpp>
@@ -116,6 +118,40 @@ void Uniform::set(const std::vector<glm::vec4>& values)
       ));
 }
 
+Program::Program(const std::string_view& label, const ProgramBinary& binary)
+    : BindableResource{allocate, api::useProgram, release, label}
+{
+  GL_ASSERT(api::programBinary(
+    getHandle(), binary.format, binary.data.data(), gsl::narrow<api::core::SizeType>(binary.data.size())));
+}
+
+std::vector<api::core::EnumType> Program::getBinaryFormats()
+{
+  int32_t n = 0;
+  GL_ASSERT(api::getIntegerv(api::GetPName::NumProgramBinaryFormats, &n));
+  if(n <= 0)
+    return {};
+
+  std::vector<int32_t> formats(n);
+  GL_ASSERT(api::getIntegerv(api::GetPName::ProgramBinaryFormats, formats.data()));
+  return {formats.begin(), formats.end()};
+}
+
+ProgramBinary Program::getBinary() const
+{
+  int32_t length = 0;
+  GL_ASSERT(api::getProgram(getHandle(), api::ProgramProperty::ProgramBinaryLength, &length));
+  if(length <= 0)
+    return {};
+
+  ProgramBinary binary;
+  binary.data.resize(length);
+  api::core::SizeType written = 0;
+  GL_ASSERT(api::getProgramBinary(getHandle(), length, &written, &binary.format, binary.data.data()));
+  binary.data.resize(written);
+  return binary;
+}
+
 bool Program::getLinkStatus() const
 {
   auto success = static_cast<int32_t>(api::Boolean::False);
@@ -123,6 +159,16 @@ bool Program::getLinkStatus() const
   return success == static_cast<int32_t>(api::Boolean::True);
 }
 
+bool Program::isLinkCompleted() const
+{
+  if(!hasParallelShaderCompileExtension())
+    return true;
+
+  auto completed = static_cast<int32_t>(api::Boolean::False);
+  GL_ASSERT(api::getProgram(getHandle(), api::ProgramProperty::CompletionStatusKhr, &completed));
+  return completed == static_cast<int32_t>(api::Boolean::True);
+}
+
 std::string Program::getInfoLog() const
 {
   int32_t length = 0;
@@ -265,25 +265,23 @@ private:
   }
 };
 
+struct ProgramBinary
+{
+  api::core::EnumType format = 0;
+  std::vector<uint8_t> data{};
+};
+
 class Program final : public BindableResource<api::ObjectIdentifier::Program>
 {
 public:
   // NOLINTNEXTLINE(bugprone-reserved-identifier)
   template<api::ShaderType... _Types>
   explicit Program(const std::string_view& label, const Shader<_Types>&... shaders)
-      : BindableResource{[]([[maybe_unused]] const api::core::SizeType n, uint32_t* handle)
-                         {
-                           BOOST_ASSERT(n == 1 && handle != nullptr);
-                           *handle = api::createProgram();
-                         },
-                         api::useProgram,
-                         []([[maybe_unused]] const api::core::SizeType n, const uint32_t* handle)
-                         {
-                           BOOST_ASSERT(n == 1 && handle != nullptr);
-                           api::deleteProgram(*handle);
-                         },
-                         label}
+      : BindableResource{allocate, api::useProgram, release, label}
   {
+    GL_ASSERT(api::programParameter(getHandle(),
+                                    api::ProgramParameterPName::ProgramBinaryRetrievableHint,
+                                    static_cast<int32_t>(api::Boolean::True)));
     (...,
      [this, &shaders]()
      {
@@ -292,8 +290,20 @@ public:
     GL_ASSERT(api::linkProgram(getHandle()));
   }
 
+  //! Loads a binary previously returned by getBinary(); check getLinkStatus() as the driver may reject it. The
+  //! binary's format must be one of getBinaryFormats().
+  explicit Program(const std::string_view& label, const ProgramBinary& binary);
+
+  //! Binary formats the driver supports; if empty, program binaries are not available.
+  [[nodiscard]] static std::vector<api::core::EnumType> getBinaryFormats();
+
+  [[nodiscard]] ProgramBinary getBinary() const;
+
   [[nodiscard]] bool getLinkStatus() const;
 
+  //! Whether linking has finished, i.e. getLinkStatus() will not block; always true without parallel compilation.
+  [[nodiscard]] bool isLinkCompleted() const;
+
   [[nodiscard]] std::string getInfoLog() const;
 
   [[nodiscard]] uint32_t getActiveResourceCount(api::ProgramInterface what) const;
@@ -309,6 +319,18 @@ public:
   [[nodiscard]] std::vector<UniformBlock> getUniformBlocks() const;
 
 private:
+  static void allocate([[maybe_unused]] const api::core::SizeType n, uint32_t* handle)
+  {
+    BOOST_ASSERT(n == 1 && handle != nullptr);
+    *handle = api::createProgram();
+  }
+
+  static void release([[maybe_unused]] const api::core::SizeType n, const uint32_t* handle)
+  {
+    BOOST_ASSERT(n == 1 && handle != nullptr);
+    api::deleteProgram(*handle);
+  }
+
   template<typename T>
   [[nodiscard]] std::vector<T> getInputs() const
   {
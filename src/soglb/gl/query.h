@@ -0,0 +1,83 @@
+#pragma once
+
+#include "api/gl.hpp"
+#include "glassert.h"
+
+#include <cstdint>
+#include <gsl/gsl-lite.hpp>
+#include <string_view>
+
+namespace gl
+{
+class Query final
+{
+public:
+  Query(const Query&) = delete;
+  Query(Query&&) = delete;
+  void operator=(const Query&) = delete;
+  void operator=(Query&&) = delete;
+
+  explicit Query(const api::QueryTarget target, const std::string_view& label)
+      : m_target{target}
+  {
+    GL_ASSERT(api::createQuerie(m_target, 1, &m_handle));
+    Expects(m_handle != 0);
+
+    if(!label.empty())
+      GL_ASSERT(api::objectLabel(
+        api::ObjectIdentifier::Query, m_handle, gsl::narrow<api::core::SizeType>(label.size()), label.data()));
+  }
+
+  //! Creates a timestamp query, which is issued through recordTimestamp() instead of begin() and end().
+  explicit Query(const api::QueryCounterTarget target, const std::string_view& label)
+      : Query{static_cast<api::QueryTarget>(target), label}
+  {
+  }
+
+  ~Query()
+  {
+    GL_ASSERT(api::deleteQuerie(1, &m_handle));
+  }
+
+  [[nodiscard]] auto getHandle() const
+  {
+    return m_handle;
+  }
+
+  void begin() const
+  {
+    GL_ASSERT(api::beginQuery(m_target, m_handle));
+  }
+
+  void end() const
+  {
+    GL_ASSERT(api::endQuery(m_target));
+  }
+
+  //! Records the GPU time once all previously issued commands have finished; the result is in nanoseconds.
+  void recordTimestamp() const
+  {
+    GL_ASSERT(api::queryCounter(m_handle, api::QueryCounterTarget::Timestamp));
+  }
+
+  //! Must only be called after the query has been issued at least once.
+  [[nodiscard]] bool isResultAvailable() const
+  {
+    uint32_t available = 0;
+    GL_ASSERT(api::getQueryObject(m_handle, api::QueryObjectParameterName::QueryResultAvailable, &available));
+    return available != 0;
+  }
+
+  //! Waits for the result if it is not available yet.
+  [[nodiscard]] uint64_t getResult() const
+  {
+    uint64_t result = 0;
+    GL_ASSERT(api::getQueryObject(m_handle, api::QueryObjectParameterName::QueryResult, &result));
+    return result;
+  }
+
+private:
+  const api::QueryTarget m_target;
+  uint32_t m_handle = 0;
+};
+} // namespace gl
@@ -46,6 +46,11 @@ void RenderState::apply(const bool force) const
     GL_ASSERT(api::useProgram(m_program.value()));
     getCurrentState().m_program = m_program;
   }
+  if(m_vertexArray.has_value() && RS_CHANGED(m_vertexArray))
+  {
+    GL_ASSERT(api::bindVertexArray(m_vertexArray.value()));
+    getCurrentState().m_vertexArray = m_vertexArray;
+  }
   for(uint32_t i = 0; i < IndexedCaps; ++i)
   {
     if(RS_CHANGED(m_blendEnabled[i]))
@@ -110,6 +115,12 @@ void RenderState::apply(const bool force) const
     GL_ASSERT(api::depthMask(m_depthWriteEnabled.value()));
     getCurrentState().m_depthWriteEnabled = m_depthWriteEnabled;
   }
+  if(RS_CHANGED(m_colorWriteEnabled))
+  {
+    const auto enabled = m_colorWriteEnabled.value();
+    GL_ASSERT(api::colorMask(enabled, enabled, enabled, enabled));
+    getCurrentState().m_colorWriteEnabled = m_colorWriteEnabled;
+  }
   if(RS_CHANGED(m_depthClampEnabled))
   {
     if(m_depthClampEnabled.value())
@@ -177,6 +188,7 @@ void RenderState::merge(const RenderState& other)
   MERGE_OPT(m_cullFaceEnabled);
   MERGE_OPT(m_depthTestEnabled);
   MERGE_OPT(m_depthWriteEnabled);
+  MERGE_OPT(m_colorWriteEnabled);
   MERGE_OPT(m_depthClampEnabled);
   MERGE_OPT(m_depthFunction);
   for(uint32_t i = 0; i < IndexedCaps; ++i)
@@ -194,6 +206,11 @@ void RenderState::merge(const RenderState& other)
 #undef MERGE_OPT
 }
 
+void RenderState::vertexArrayUnbound()
+{
+  getCurrentState().m_vertexArray = 0;
+}
+
 RenderState& RenderState::getWantedState()
 {
   static RenderState wantedState;
@@ -217,6 +234,7 @@ RenderState RenderState::getDefaults()
     defaults.setCullFace(true);
     defaults.setDepthTest(true);
     defaults.setDepthWrite(true);
+    defaults.setColorWrite(true);
     defaults.setDepthClamp(false);
     defaults.setDepthFunction(api::DepthFunction::Less);
     for(uint32_t i = 0; i < IndexedCaps; ++i)
@@ -28,6 +28,11 @@ public:
     m_blendEnabled.at(index) = enabled;
   }
 
+  [[nodiscard]] const auto& getBlend(const uint32_t index) const
+  {
+    return m_blendEnabled.at(index);
+  }
+
   void setBlendFactors(const uint32_t index, const api::BlendingFactor src, const api::BlendingFactor dst)
   {
     setBlendFactors(index, src, src, dst, dst);
@@ -67,6 +72,11 @@ public:
     m_depthWriteEnabled = enabled;
   }
 
+  void setColorWrite(const bool enabled)
+  {
+    m_colorWriteEnabled = enabled;
+  }
+
   void setDepthClamp(const bool enabled)
   {
     m_depthClampEnabled = enabled;
@@ -112,6 +122,15 @@ public:
     m_program = program;
   }
 
+  void setVertexArray(const std::optional<uint32_t>& vertexArray)
+  {
+    m_vertexArray = vertexArray;
+  }
+
+  //! Must be called when the vertex array binding is reset outside of the render state, e.g. when a vertex array is
+  //! deleted.
+  static void vertexArrayUnbound();
+
   static RenderState getDefaults();
 
   static RenderState& getWantedState();
@@ -139,9 +158,11 @@ private:
   // States
   std::optional<glm::ivec2> m_viewport{};
   std::optional<uint32_t> m_program{};
+  std::optional<uint32_t> m_vertexArray{};
   std::optional<bool> m_cullFaceEnabled{};
   std::optional<bool> m_depthTestEnabled{};
   std::optional<bool> m_depthWriteEnabled{};
+  std::optional<bool> m_colorWriteEnabled{};
   std::optional<bool> m_depthClampEnabled{};
   std::optional<api::DepthFunction> m_depthFunction{};
   std::array<std::optional<bool>, IndexedCaps> m_blendEnabled{};
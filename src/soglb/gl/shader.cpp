@@ -127,17 +127,67 @@ void replaceIncludes(const std::filesystem::path& filepath,
     }
   }
 }
+
+std::string readSource(const std::filesystem::path& sourcePath)
+{
+  if(!std::filesystem::is_regular_file(sourcePath))
+  {
+    BOOST_LOG_TRIVIAL(fatal) << "Could not find required file " << sourcePath;
+    BOOST_THROW_EXCEPTION(std::runtime_error("required file not found"));
+  }
+
+  std::string source = readAll(sourcePath);
+  if(source.empty())
+  {
+    BOOST_LOG_TRIVIAL(error) << "Failed to read shader from file '" << sourcePath << "'.";
+    BOOST_THROW_EXCEPTION(std::runtime_error("Failed to create shader from sources"));
+  }
+
+  return source;
+}
+
+std::string assembleSource(const std::filesystem::path& sourcePath,
+                           const std::string& source,
+                           const std::vector<std::string>& defines,
+                           bool isInput)
+{
+  std::string out
+    = "#version 450 core\n"
+      "#extension GL_ARB_bindless_texture : require\n"
+      "#extension GL_ARB_gpu_shader5 : require\n";
+  out += replaceDefines(defines, isInput);
+
+  if(sourcePath.empty())
+  {
+    out += source;
+    return out;
+  }
+
+  // Replace the #include "foo.bar" with the sources that come from file paths
+  std::set<std::filesystem::path> included;
+  replaceIncludes(sourcePath, source, out, included);
+  return out;
+}
 } // namespace
 
 // NOLINTNEXTLINE(bugprone-reserved-identifier)
 template<api::ShaderType _Type>
-Shader<_Type>::Shader(const gsl::span<gsl::czstring>& src, const std::string_view& label)
+Shader<_Type>::Shader(const gsl::span<gsl::czstring>& src, const std::string_view& label, bool waitForCompilation)
     : m_handle{GL_ASSERT_FN(api::createShader(Type))}
 {
   Expects(m_handle != 0);
   GL_ASSERT(api::shaderSource(m_handle, gsl::narrow<api::core::SizeType>(src.size()), src.data(), nullptr));
   GL_ASSERT(api::compileShader(m_handle));
 
+  if(!label.empty())
+  {
+    GL_ASSERT(api::objectLabel(
+      api::ObjectIdentifier::Shader, m_handle, gsl::narrow<api::core::SizeType>(label.size()), label.data()));
+  }
+
+  if(!waitForCompilation)
+    return;
+
   if(const auto log = getInfoLog(); !log.empty())
     BOOST_LOG_TRIVIAL(debug) << "Shader info log: " << log;
 
@@ -148,12 +198,6 @@ Shader<_Type>::Shader(const gsl::span<gsl::czstring>& src, const std::string_vie
     BOOST_LOG_TRIVIAL(error) << "Failed to compile shader program " << label;
     BOOST_THROW_EXCEPTION(std::runtime_error("Failed to compile shader program"));
   }
-
-  if(!label.empty())
-  {
-    GL_ASSERT(api::objectLabel(
-      api::ObjectIdentifier::Shader, m_handle, gsl::narrow<api::core::SizeType>(label.size()), label.data()));
-  }
 }
 
 // NOLINTNEXTLINE(bugprone-reserved-identifier)
@@ -182,26 +226,8 @@ Shader<_Type> Shader<_Type>::create(const std::filesystem::path& sourcePath,
                                     const std::vector<std::string>& defines,
                                     const std::string_view& label)
 {
-  static constexpr size_t SHADER_SOURCE_LENGTH = 3;
-  std::array<gsl::czstring, SHADER_SOURCE_LENGTH> shaderSource{nullptr};
-  shaderSource[0]
-    = "#version 450 core\n"
-      "#extension GL_ARB_bindless_texture : require\n"
-      "#extension GL_ARB_gpu_shader5 : require\n";
-
-  std::string definesStr = replaceDefines(defines, _Type == api::ShaderType::FragmentShader);
-  shaderSource[1] = definesStr.c_str();
-
-  std::string sourceStr;
-  if(!sourcePath.empty())
-  {
-    // Replace the #include "foo.bar" with the sources that come from file paths
-    std::set<std::filesystem::path> included;
-    replaceIncludes(sourcePath, source, sourceStr, included);
-  }
-  shaderSource[2] = !sourcePath.empty() ? sourceStr.c_str() : source.c_str();
-
-  return Shader<_Type>{shaderSource, label};
+  return fromPreprocessed(assembleSource(sourcePath, source, defines, _Type == api::ShaderType::FragmentShader),
+                          label);
 }
 
 // NOLINTNEXTLINE(bugprone-reserved-identifier)
@@ -210,20 +236,24 @@ Shader<_Type> Shader<_Type>::create(const std::filesystem::path& sourcePath,
                                     const std::vector<std::string>& defines,
                                     const std::string_view& label)
 {
-  if(!std::filesystem::is_regular_file(sourcePath))
-  {
-    BOOST_LOG_TRIVIAL(fatal) << "Could not find required file " << sourcePath;
-    BOOST_THROW_EXCEPTION(std::runtime_error("required file not found"));
-  }
+  return fromPreprocessed(preprocess(sourcePath, defines), label);
+}
 
-  const std::string source = readAll(sourcePath);
-  if(source.empty())
-  {
-    BOOST_LOG_TRIVIAL(error) << "Failed to read vertex shader from file '" << sourcePath << "'.";
-    BOOST_THROW_EXCEPTION(std::runtime_error("Failed to create shader from sources"));
-  }
+// NOLINTNEXTLINE(bugprone-reserved-identifier)
+template<api::ShaderType _Type>
+std::string Shader<_Type>::preprocess(const std::filesystem::path& sourcePath, const std::vector<std::string>& defines)
+{
+  return assembleSource(sourcePath, readSource(sourcePath), defines, _Type == api::ShaderType::FragmentShader);
+}
 
-  return create(sourcePath, source, defines, label);
+// NOLINTNEXTLINE(bugprone-reserved-identifier)
+template<api::ShaderType _Type>
+Shader<_Type> Shader<_Type>::fromPreprocessed(const std::string& source,
+                                              const std::string_view& label,
+                                              bool waitForCompilation)
+{
+  std::array<gsl::czstring, 1> shaderSource{source.c_str()};
+  return Shader<_Type>{shaderSource, label, waitForCompilation};
 }
 
 template class Shader<api::ShaderType::FragmentShader>;
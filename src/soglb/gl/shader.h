@@ -19,7 +19,9 @@ class Shader final
 public:
   static constexpr api::ShaderType Type = _Type;
 
-  explicit Shader(const gsl::span<gsl::czstring>& src, const std::string_view& label);
+  //! If @a waitForCompilation is false, compile errors are only reported when linking a program using this shader,
+  //! which allows the driver to compile in the background.
+  explicit Shader(const gsl::span<gsl::czstring>& src, const std::string_view& label, bool waitForCompilation = true);
 
   Shader(const Shader&) = delete;
   Shader(Shader&&) = delete;
@@ -47,6 +49,14 @@ public:
                                             const std::vector<std::string>& defines,
                                             const std::string_view& label);
 
+  //! Returns the complete source as passed to the compiler, i.e. with the version header, defines and includes.
+  [[nodiscard]] static std::string preprocess(const std::filesystem::path& sourcePath,
+                                              const std::vector<std::string>& defines);
+
+  //! Compiles a source returned by preprocess().
+  [[nodiscard]] static Shader<_Type>
+    fromPreprocessed(const std::string& source, const std::string_view& label, bool waitForCompilation = true);
+
 private:
   const uint32_t m_handle;
 };
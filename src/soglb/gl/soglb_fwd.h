@@ -24,6 +24,7 @@ class BindableResource;
 template<typename T, api::BufferTarget _Target>
 class Buffer;
 class CImgWrapper;
+class EmptyVertexArray;
 class Font;
 class TextureAttachment;
 class Framebuffer;
@@ -51,6 +52,7 @@ template<api::ProgramInterface _Type, api::BufferTarget _Target>
 class ProgramBlock;
 class Uniform;
 class Program;
+class Query;
 class RenderState;
 class Sampler;
 // NOLINTNEXTLINE(bugprone-reserved-identifier)
@@ -21,6 +21,7 @@ ENABLED_EXTENSIONS = (
     'GL_ARB_bindless_texture',
     'GL_ARB_texture_filter_anisotropic',
     'GL_EXT_texture_filter_anisotropic',
+    'GL_KHR_parallel_shader_compile',
     'GL_ARB_sync',
 )
 ENABLED_APIS = ('gl',)
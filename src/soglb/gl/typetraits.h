@@ -45,9 +45,8 @@ template<>
 inline constexpr api::VertexAttribType VertexAttribType<float> = api::VertexAttribType::Float;
 template<>
 inline constexpr api::VertexAttribType VertexAttribType<api::core::Half> = api::VertexAttribType::HalfFloat;
-template<int N>
-inline constexpr api::VertexAttribType
-  VertexAttribType<glm::vec<N, float, glm::defaultp>> = api::VertexAttribType::Float;
+template<int N, typename T>
+inline constexpr api::VertexAttribType VertexAttribType<glm::vec<N, T, glm::defaultp>> = VertexAttribType<T>;
 
 template<typename>
 inline constexpr auto PixelType = detail::InvalidValue{};
@@ -88,8 +87,8 @@ template<>
 inline constexpr api::core::SizeType ElementCount<float> = 1;
 template<>
 inline constexpr api::core::SizeType ElementCount<api::core::Half> = 1;
-template<int N>
-inline constexpr api::core::SizeType ElementCount<glm::vec<N, float, glm::defaultp>> = N;
+template<int N, typename T>
+inline constexpr api::core::SizeType ElementCount<glm::vec<N, T, glm::defaultp>> = N;
 
 template<typename>
 inline constexpr auto SrgbaSizedInternalFormat = detail::InvalidValue{};
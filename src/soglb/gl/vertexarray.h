@@ -1,10 +1,12 @@
 #pragma once
 
 #include "bindableresource.h" // IWYU pragma: export
+#include "buffer.h"
 #include "renderstate.h"
 #include "soglb_fwd.h"
 
 #include <gslu.h>
+#include <optional>
 #include <string_view>
 #include <tuple>
 #include <utility>
@@ -75,6 +77,12 @@ public:
     }
   }
 
+  ~VertexArray() override
+  {
+    // the base class unbinds the vertex array when deleting it
+    RenderState::vertexArrayUnbound();
+  }
+
   [[nodiscard]] const auto& getIndexBuffer() const
   {
     return m_indexBuffer;
@@ -85,24 +93,71 @@ public:
     return m_vertexBuffers;
   }
 
+  // the vertex array stays bound after drawing, so that consecutive draws from the same vertex array don't need to
+  // re-bind it; this is safe because all buffer updates use direct state access
   void drawIndexBuffer(api::PrimitiveType primitiveType)
   {
+    RenderState::getWantedState().setVertexArray(getHandle());
     RenderState::applyWantedState();
-    bind();
     m_indexBuffer->drawElements(primitiveType);
-    unbind();
+    RenderState::getWantedState().setVertexArray(std::nullopt);
   }
 
   void drawIndexBuffer(api::PrimitiveType primitiveType, api::core::SizeType instances)
   {
+    RenderState::getWantedState().setVertexArray(getHandle());
     RenderState::applyWantedState();
-    bind();
     m_indexBuffer->drawElements(primitiveType, instances);
-    unbind();
+    RenderState::getWantedState().setVertexArray(std::nullopt);
+  }
+
+  //! Issues the first @a drawCount draws of @a commands, which index into this vertex array's buffers.
+  void multiDrawIndirect(api::PrimitiveType primitiveType,
+                         const DrawIndirectBuffer<DrawElementsIndirectCommand>& commands,
+                         api::core::SizeType drawCount)
+  {
+    Expects(gsl::narrow<size_t>(drawCount) <= commands.size());
+    RenderState::getWantedState().setVertexArray(getHandle());
+    RenderState::applyWantedState();
+    commands.bind();
+    GL_ASSERT(api::multiDrawElementsIndirect(primitiveType, DrawElementsType<IndexT>, nullptr, drawCount, 0));
+    RenderState::getWantedState().setVertexArray(std::nullopt);
   }
 
 private:
   IndexBufferPtr m_indexBuffer;
   VertexBuffers m_vertexBuffers;
 };
+
+//! A vertex array without any buffers, for shaders that generate their vertices from @c gl_VertexID.
+class EmptyVertexArray final : public BindableResource<api::ObjectIdentifier::VertexArray>
+{
+public:
+  explicit EmptyVertexArray(const std::string_view& label)
+      : BindableResource{api::createVertexArrays, api::bindVertexArray, api::deleteVertexArrays, label}
+  {
+  }
+
+  ~EmptyVertexArray() override
+  {
+    // the base class unbinds the vertex array when deleting it
+    RenderState::vertexArrayUnbound();
+  }
+
+  void drawArrays(api::PrimitiveType primitiveType, api::core::SizeType count)
+  {
+    RenderState::getWantedState().setVertexArray(getHandle());
+    RenderState::applyWantedState();
+    GL_ASSERT(api::drawArrays(primitiveType, 0, count));
+    RenderState::getWantedState().setVertexArray(std::nullopt);
+  }
+
+  void drawArrays(api::PrimitiveType primitiveType, api::core::SizeType count, api::core::SizeType instances)
+  {
+    RenderState::getWantedState().setVertexArray(getHandle());
+    RenderState::applyWantedState();
+    GL_ASSERT(api::drawArraysInstance(primitiveType, 0, count, instances));
+    RenderState::getWantedState().setVertexArray(std::nullopt);
+  }
+};
 } // namespace gl
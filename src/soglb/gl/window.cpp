@@ -1,8 +1,12 @@
 #include "window.h"
 
 #include "cimgwrapper.h"
+#include "framebuffer.h"
 #include "glad_init.h"
 #include "glassert.h"
+#include "pixel.h"
+#include "texture2d.h"
+#include "texturedepth.h"
 
 #include <algorithm>
 #include <boost/log/trivial.hpp>
@@ -24,12 +28,17 @@ void glErrorCallback(const int err, const gsl::czstring msg)
 }
 } // namespace
 
-Window::Window(const std::vector<std::filesystem::path>& logoPaths, const glm::ivec2& windowSize)
+Window::Window(const std::vector<std::filesystem::path>& logoPaths, const glm::ivec2& windowSize, const bool headless)
     : m_windowPos{0, 0}
     , m_windowSize{windowSize}
+    , m_headless{headless}
 {
   glfwSetErrorCallback(&glErrorCallback);
 
+  // the null platform doesn't need a display server, and creates surfaceless EGL or OSMesa contexts
+  if(headless)
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+
   if(glfwInit() != GLFW_TRUE)
   {
     BOOST_LOG_TRIVIAL(fatal) << "Failed to initialize GLFW";
@@ -53,9 +62,26 @@ Window::Window(const std::vector<std::filesystem::path>& logoPaths, const glm::i
   glfwWindowHint(GLFW_CONTEXT_NO_ERROR, GLFW_TRUE);
 #endif
 
-  glfwWindowHint(GLFW_MAXIMIZED, GLFW_TRUE);
+  if(headless)
+  {
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+    // EGL is usually available along with the hardware drivers
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+  }
+  else
+  {
+    glfwWindowHint(GLFW_MAXIMIZED, GLFW_TRUE);
+  }
   m_window = glfwCreateWindow(windowSize.x, windowSize.y, "CroftEngine", nullptr, nullptr);
 
+  if(m_window == nullptr && headless)
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Failed to create an EGL context, falling back to OSMesa software rendering";
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+    m_window = glfwCreateWindow(windowSize.x, windowSize.y, "CroftEngine", nullptr, nullptr);
+  }
+
   if(m_window == nullptr)
   {
     const char* message;
@@ -64,6 +90,7 @@ Window::Window(const std::vector<std::filesystem::path>& logoPaths, const glm::i
     BOOST_THROW_EXCEPTION(std::runtime_error("Failed to create window"));
   }
 
+  if(!headless)
   {
     std::vector<CImgWrapper> imgWrappers;
     std::transform(logoPaths.begin(),
@@ -102,10 +129,25 @@ Window::Window(const std::vector<std::filesystem::path>& logoPaths, const glm::i
 
   updateWindowSize();
 
+  if(headless)
+  {
+    m_offscreenFramebuffer
+      = FrameBufferBuilder()
+          .texture(api::FramebufferAttachment::ColorAttachment0,
+                   gsl::make_shared<Texture2D<SRGBA8>>(m_windowSize, "headless-color"))
+          .textureNoBlend(api::FramebufferAttachment::DepthAttachment,
+                          gsl::make_shared<TextureDepth<float>>(m_windowSize, "headless-depth"))
+          .build("headless-fb");
+    Framebuffer::setDefault(m_offscreenFramebuffer);
+    m_viewport = m_windowSize;
+  }
+
 #ifdef NDEBUG
-  glfwSetInputMode(m_window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+  if(!headless)
+    glfwSetInputMode(m_window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
 #endif
-  glfwSwapInterval(1);
+  // nothing is displayed in headless mode, so there's no need to wait for vertical syncs
+  glfwSwapInterval(headless ? 0 : 1);
 }
 
 void Window::updateWindowSize()
@@ -113,7 +155,8 @@ void Window::updateWindowSize()
   glm::ivec2 tmpSize;
   glfwGetFramebufferSize(m_window, &tmpSize.x, &tmpSize.y);
 
-  if(tmpSize == m_viewport)
+  // the offscreen framebuffer of headless windows has a fixed size
+  if(tmpSize == m_viewport || m_offscreenFramebuffer != nullptr)
     return;
 
   m_viewport = tmpSize;
@@ -126,7 +169,7 @@ void Window::swapBuffers() const
 
 void Window::setFullscreen()
 {
-  if(m_isFullscreen)
+  if(m_isFullscreen || m_headless)
     return;
 
   const auto monitor = glfwGetPrimaryMonitor();
@@ -173,8 +216,18 @@ void Window::setWindowed()
   m_isFullscreen = false;
 }
 
+void Window::setVsync(const bool enabled)
+{
+  glfwSwapInterval(enabled && !m_headless ? 1 : 0);
+}
+
 Window::~Window()
 {
+  if(m_offscreenFramebuffer != nullptr)
+  {
+    Framebuffer::setDefault(nullptr);
+    m_offscreenFramebuffer.reset();
+  }
   glfwDestroyWindow(m_window);
 }
 } // namespace gl
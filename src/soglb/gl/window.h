@@ -1,10 +1,12 @@
 #pragma once
 
 #include "glfw.h"
+#include "soglb_fwd.h"
 
 #include <filesystem>
 #include <glm/vec2.hpp>
 #include <gsl/gsl-lite.hpp>
+#include <memory>
 #include <vector>
 
 namespace gl
@@ -12,7 +14,13 @@ namespace gl
 class Window final
 {
 public:
-  explicit Window(const std::vector<std::filesystem::path>& logoPaths, const glm::ivec2& windowSize = {1280, 800});
+  /**
+   * @param headless creates an invisible window on GLFW's null platform, so that no display server is needed, and
+   *        renders into a fixed size offscreen framebuffer instead of the window's one, e.g. for automated benchmarks
+   */
+  explicit Window(const std::vector<std::filesystem::path>& logoPaths,
+                  const glm::ivec2& windowSize = {1280, 800},
+                  bool headless = false);
   ~Window();
 
   void updateWindowSize();
@@ -47,16 +55,27 @@ public:
       setWindowed();
   }
 
+  //! Enables or disables waiting for vertical syncs when swapping buffers; headless windows never wait.
+  void setVsync(bool enabled);
+
   [[nodiscard]] bool isMinimized() const noexcept
   {
     return m_viewport.x <= 0 || m_viewport.y <= 0;
   }
 
+  [[nodiscard]] bool isHeadless() const noexcept
+  {
+    return m_headless;
+  }
+
 private:
   GLFWwindow* m_window = nullptr;
   glm::ivec2 m_windowPos{0};
   glm::ivec2 m_windowSize{0};
   glm::ivec2 m_viewport{0};
   bool m_isFullscreen = false;
+  const bool m_headless;
+  //! Replaces the default framebuffer in headless mode, as the framebuffer of a hidden window may not be usable.
+  std::shared_ptr<Framebuffer> m_offscreenFramebuffer;
 };
 } // namespace gl